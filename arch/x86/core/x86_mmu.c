@@ -919,6 +919,107 @@ static inline pentry_t pte_atomic_update(pentry_t *pte, pentry_t update_val,
 	return old_val;
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+BUILD_ASSERT(CONFIG_MMU_LARGE_PAGE_SIZE == PT_AREA,
+	     "large pages are mapped by page directory entries");
+
+/* Physical address bits of a large page directory entry */
+#define LARGE_PAGE_MASK	(paging_levels[PTE_LEVEL].mask & \
+			 ~((pentry_t)PT_AREA - 1U))
+
+/* Page tables unlinked by large page mappings. The whole address space has
+ * its page tables reserved at build time and every large page puts one of
+ * them here, so there is always one available when a large page has to be
+ * split again.
+ */
+__pinned_bss
+static sys_slist_t large_page_ptables;
+
+/* Replace a large page directory entry with a page table mapping the same
+ * memory with the same flags, one page at a time
+ */
+__pinned_func
+static void large_page_split(pentry_t *pde)
+{
+	pentry_t *table = (pentry_t *)sys_slist_get(&large_page_ptables);
+	pentry_t old_val, phys, flags;
+
+	__ASSERT(table != NULL, "no page table left to split large page");
+
+	do {
+		old_val = atomic_pte_get(pde);
+		phys = old_val & LARGE_PAGE_MASK;
+		flags = old_val & ~paging_levels[PTE_LEVEL].mask & ~MMU_PS;
+
+		for (int i = 0; i < NUM_PT_ENTRIES; i++) {
+			table[i] = (phys + (i * CONFIG_MMU_PAGE_SIZE)) | flags;
+		}
+	} while (!atomic_pte_cas(pde, old_val,
+				 (pentry_t)z_mem_phys_addr(table) | INT_FLAGS));
+}
+
+/* Try to establish a new mapping for the large page at virt with a single
+ * page directory entry. Only done if virt and phys are both aligned, the
+ * whole large page is being mapped, and nothing is mapped there yet.
+ */
+__pinned_func
+static bool large_page_map(pentry_t *ptables, void *virt, uintptr_t phys,
+			   size_t size, pentry_t entry_flags, pentry_t mask,
+			   uint32_t options)
+{
+	pentry_t *table = ptables;
+	pentry_t *pde, *pt;
+
+	if ((options & (OPTION_RESET | OPTION_CLEAR)) != 0U ||
+	    mask != MASK_ALL || (entry_flags & MMU_P) == 0U ||
+	    size < PT_AREA || (POINTER_TO_UINT(virt) & (PT_AREA - 1)) != 0U ||
+	    (phys & (PT_AREA - 1)) != 0U) {
+		return false;
+	}
+
+	for (int level = 0; level < PDE_LEVEL; level++) {
+		pentry_t entry = get_entry(table, virt, level);
+
+		if ((entry & MMU_P) == 0U) {
+			return false;
+		}
+		table = next_table(entry, level);
+	}
+	pde = get_entry_ptr(table, virt, PDE_LEVEL);
+
+	if ((*pde & MMU_P) == 0U) {
+		/* No reserved page table here to put aside */
+		return false;
+	}
+
+	if ((*pde & MMU_PS) != 0U) {
+		/* Re-mapping a large page */
+		pt = NULL;
+	} else {
+		pt = next_table(*pde, PDE_LEVEL);
+		for (int i = 0; i < NUM_PT_ENTRIES; i++) {
+			if (pt[i] != 0U) {
+				return false;
+			}
+		}
+	}
+
+	*pde = (pentry_t)phys | entry_flags | MMU_PS;
+
+	/* Also drops any cached link to the page table */
+	tlb_flush_page(virt);
+#ifdef CONFIG_SMP
+	tlb_shootdown();
+#endif
+
+	if (pt != NULL) {
+		sys_slist_prepend(&large_page_ptables, (sys_snode_t *)pt);
+	}
+
+	return true;
+}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 /**
  * Low level page table update function for a virtual page
  *
@@ -971,8 +1072,14 @@ static void page_map_set(pentry_t *ptables, void *virt, pentry_t entry_val,
 			break;
 		}
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+		if ((level == PDE_LEVEL) && ((*entryp & MMU_PS) != 0U)) {
+			large_page_split(entryp);
+		}
+#endif
 		/* We fail an assertion here due to no support for
-		 * splitting existing bigpage mappings.
+		 * splitting existing bigpage mappings, other than our own
+		 * large pages above.
 		 * If the PS bit is not supported at some level (like
 		 * in a PML4 entry) it is always reserved and must be 0
 		 */
@@ -1035,6 +1142,13 @@ static void range_map_ptables(pentry_t *ptables, void *virt, uintptr_t phys,
 		uint8_t *dest_virt = (uint8_t *)virt + offset;
 		pentry_t entry_val;
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+		if (large_page_map(ptables, dest_virt, phys + offset,
+				   size - offset, entry_flags, mask, options)) {
+			offset += PT_AREA - CONFIG_MMU_PAGE_SIZE;
+			continue;
+		}
+#endif
 		if (zero_entry) {
 			entry_val = 0;
 		} else {
@@ -1927,7 +2041,10 @@ int arch_page_phys_get(void *virt, uintptr_t *phys)
 
 	if ((pte & MMU_P) != 0) {
 		if (phys != NULL) {
-			*phys = (uintptr_t)get_entry_phys(pte, PTE_LEVEL);
+			/* Add the offset within a large page, if any */
+			*phys = (uintptr_t)get_entry_phys(pte, level) +
+				(POINTER_TO_UINT(virt) &
+				 (get_entry_scope(level) - 1));
 		}
 		ret = 0;
 	} else {
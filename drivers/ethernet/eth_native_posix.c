@@ -201,6 +201,23 @@ static int eth_send(const struct device *dev, struct net_pkt *pkt)
 	return ret < 0 ? ret : 0;
 }
 
+static int eth_send_burst(const struct device *dev, struct net_pkt **pkts,
+			  size_t count)
+{
+	size_t i;
+	int ret;
+
+	/* The TAP device takes one frame per write() */
+	for (i = 0; i < count; i++) {
+		ret = eth_send(dev, pkts[i]);
+		if (ret < 0) {
+			return i > 0 ? (int)i : ret;
+		}
+	}
+
+	return (int)count;
+}
+
 static int eth_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -236,7 +253,8 @@ static inline struct net_if *get_iface(struct eth_context *ctx,
 
 #if defined(CONFIG_NET_VLAN)
 static struct net_pkt *prepare_vlan_pkt(struct eth_context *ctx,
-					int count, uint16_t *vlan_tag, int *status)
+					int count, k_timeout_t timeout,
+					uint16_t *vlan_tag, int *status)
 {
 	struct net_eth_vlan_hdr *hdr = (struct net_eth_vlan_hdr *)ctx->recv;
 	struct net_pkt *pkt;
@@ -247,7 +265,7 @@ static struct net_pkt *prepare_vlan_pkt(struct eth_context *ctx,
 	}
 
 	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
-					   AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+					   AF_UNSPEC, 0, timeout);
 	if (!pkt) {
 		*status = -ENOMEM;
 		return NULL;
@@ -295,12 +313,13 @@ error:
 #endif
 
 static struct net_pkt *prepare_non_vlan_pkt(struct eth_context *ctx,
-					    int count, int *status)
+					    int count, k_timeout_t timeout,
+					    int *status)
 {
 	struct net_pkt *pkt;
 
 	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
-					   AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+					   AF_UNSPEC, 0, timeout);
 	if (!pkt) {
 		*status = -ENOMEM;
 		return NULL;
@@ -319,32 +338,29 @@ static struct net_pkt *prepare_non_vlan_pkt(struct eth_context *ctx,
 	return pkt;
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+/* Turn the count bytes of the frame just read into a packet */
+static struct net_pkt *prepare_pkt(struct eth_context *ctx, int count,
+				   k_timeout_t timeout, struct net_if **iface,
+				   int *status)
 {
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-	struct net_if *iface;
 	struct net_pkt *pkt = NULL;
-	int status;
-	int count;
-
-	count = eth_read_data(fd, ctx->recv, sizeof(ctx->recv));
-	if (count <= 0) {
-		return 0;
-	}
 
 #if defined(CONFIG_NET_VLAN)
 	{
 		struct net_eth_hdr *hdr = (struct net_eth_hdr *)(ctx->recv);
 
 		if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
-			pkt = prepare_vlan_pkt(ctx, count, &vlan_tag, &status);
+			pkt = prepare_vlan_pkt(ctx, count, timeout, &vlan_tag,
+					       status);
 			if (!pkt) {
-				return status;
+				return NULL;
 			}
 		} else {
-			pkt = prepare_non_vlan_pkt(ctx, count, &status);
+			pkt = prepare_non_vlan_pkt(ctx, count, timeout,
+						   status);
 			if (!pkt) {
-				return status;
+				return NULL;
 			}
 
 			net_pkt_set_vlan_tci(pkt, 0);
@@ -352,22 +368,84 @@ static int read_data(struct eth_context *ctx, int fd)
 	}
 #else
 	{
-		pkt = prepare_non_vlan_pkt(ctx, count, &status);
+		pkt = prepare_non_vlan_pkt(ctx, count, timeout, status);
 		if (!pkt) {
-			return status;
+			return NULL;
 		}
 	}
 #endif
 
-	iface = get_iface(ctx, vlan_tag);
+	*iface = get_iface(ctx, vlan_tag);
 
-	update_gptp(iface, pkt, false);
+	update_gptp(*iface, pkt, false);
 
-	if (net_recv_data(iface, pkt) < 0) {
-		net_pkt_unref(pkt);
+	return pkt;
+}
+
+static void recv_burst(struct net_if *iface, struct net_pkt **pkts,
+		       size_t count)
+{
+	int ret;
+
+	if (count == 0) {
+		return;
 	}
 
-	return 0;
+	ret = net_recv_data_burst(iface, pkts, count);
+
+	for (size_t i = MAX(ret, 0); i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+/* Read the frames waiting in the TAP device, and pass them to the stack
+ * in bursts of packets received by the same interface.
+ */
+static int read_data(struct eth_context *ctx, int fd)
+{
+	struct net_pkt *pkts[CONFIG_ETH_NATIVE_POSIX_RX_BURST];
+	struct net_if *burst_iface = NULL;
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	size_t n = 0;
+	int status = 0;
+	int count;
+
+	do {
+		count = eth_read_data(fd, ctx->recv, sizeof(ctx->recv));
+		if (count <= 0) {
+			break;
+		}
+
+		/* Do not wait for a free packet while holding on to others,
+		 * they may be the ones missing.
+		 */
+		pkt = prepare_pkt(ctx, count, n > 0 ? K_NO_WAIT :
+				  NET_BUF_TIMEOUT, &iface, &status);
+		if (!pkt && n > 0 && status == -ENOMEM) {
+			recv_burst(burst_iface, pkts, n);
+			n = 0;
+
+			pkt = prepare_pkt(ctx, count, NET_BUF_TIMEOUT, &iface,
+					  &status);
+		}
+
+		if (!pkt) {
+			break;
+		}
+
+		if (n > 0 && iface != burst_iface) {
+			recv_burst(burst_iface, pkts, n);
+			n = 0;
+		}
+
+		burst_iface = iface;
+		pkts[n++] = pkt;
+	} while (n < ARRAY_SIZE(pkts) && !eth_wait_data(fd));
+
+	recv_burst(burst_iface, pkts, n);
+
+	return status;
 }
 
 static void eth_rx(struct eth_context *ctx)
@@ -609,6 +687,7 @@ static const struct ethernet_api eth_if_api = {
 	.start = eth_start_device,
 	.stop = eth_stop_device,
 	.send = eth_send,
+	.send_burst = eth_send_burst,
 
 #if defined(CONFIG_NET_VLAN)
 	.vlan_setup = vlan_setup,
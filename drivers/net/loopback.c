@@ -36,20 +36,17 @@ static void loopback_init(struct net_if *iface)
 	/* RFC 7042, s.2.1.1. address to use in documentation */
 	net_if_set_link_addr(iface, "\x00\x00\x5e\x00\x53\xff", 6,
 			     NET_LINK_DUMMY);
-}
-
-static int loopback_send(const struct device *dev, struct net_pkt *pkt)
-{
-	struct net_pkt *cloned;
-	int res;
-
-	ARG_UNUSED(dev);
 
-	if (!pkt->frags) {
-		LOG_ERR("No data to send");
-		return -ENODATA;
+	if (IS_ENABLED(CONFIG_NET_LOOPBACK_OFFLOADS)) {
+		net_if_set_offloads(iface, NET_IF_OFFLOAD_TX_CHKSUM |
+				    NET_IF_OFFLOAD_RX_CHKSUM |
+				    NET_IF_OFFLOAD_TSO |
+				    NET_IF_OFFLOAD_LRO);
 	}
+}
 
+static void loopback_swap_addrs(struct net_pkt *pkt)
+{
 	/* We need to swap the IP addresses because otherwise
 	 * the packet will be dropped.
 	 */
@@ -69,13 +66,43 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 				&NET_IPV4_HDR(pkt)->dst);
 		net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &addr);
 	}
+}
+
+static struct net_pkt *loopback_clone(struct net_pkt *pkt)
+{
+	struct net_pkt *cloned;
+
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return NULL;
+	}
+
+	/* A GSO packet is received whole, as if coalesced again by LRO */
+	net_pkt_set_gso_size(cloned, 0);
+
+	return cloned;
+}
+
+static int loopback_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct net_pkt *cloned;
+	int res;
+
+	ARG_UNUSED(dev);
+
+	if (!pkt->frags) {
+		LOG_ERR("No data to send");
+		return -ENODATA;
+	}
+
+	loopback_swap_addrs(pkt);
 
 	/* We should simulate normal driver meaning that if the packet is
 	 * properly sent (which is always in this driver), then the packet
 	 * must be dropped. This is very much needed for TCP packets where
 	 * the packet is reference counted in various stages of sending.
 	 */
-	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	cloned = loopback_clone(pkt);
 	if (!cloned) {
 		res = -ENOMEM;
 		goto out;
@@ -93,10 +120,62 @@ out:
 	return res;
 }
 
+#if defined(CONFIG_NET_TC_TX_BURST) && CONFIG_NET_TC_TX_BURST > 1
+static int loopback_send_burst(const struct device *dev,
+			       struct net_pkt **pkts, size_t count)
+{
+	struct net_pkt *cloned[CONFIG_NET_TC_TX_BURST];
+	size_t i, n;
+	int res = 0;
+
+	ARG_UNUSED(dev);
+
+	__ASSERT_NO_MSG(count <= CONFIG_NET_TC_TX_BURST);
+
+	for (n = 0; n < count; n++) {
+		if (!pkts[n]->frags) {
+			LOG_ERR("No data to send");
+			res = -ENODATA;
+			break;
+		}
+
+		loopback_swap_addrs(pkts[n]);
+
+		cloned[n] = loopback_clone(pkts[n]);
+		if (!cloned[n]) {
+			res = -ENOMEM;
+			break;
+		}
+	}
+
+	if (n == 0) {
+		return res;
+	}
+
+	/* The whole burst is received in one go, as a NIC would do it */
+	res = net_recv_data_burst(net_pkt_iface(cloned[0]), cloned, n);
+	if (res < 0) {
+		LOG_ERR("Data receive failed.");
+	}
+
+	for (i = MAX(res, 0); i < n; i++) {
+		net_pkt_unref(cloned[i]);
+	}
+
+	/* Let the receiving thread run now */
+	k_yield();
+
+	return res;
+}
+#endif
+
 static struct dummy_api loopback_api = {
 	.iface_api.init = loopback_init,
 
 	.send = loopback_send,
+#if defined(CONFIG_NET_TC_TX_BURST) && CONFIG_NET_TC_TX_BURST > 1
+	.send_burst = loopback_send_burst,
+#endif
 };
 
 NET_DEVICE_INIT(loopback, "lo",
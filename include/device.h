@@ -356,6 +356,20 @@ struct device_state {
 	 */
 	bool initialized : 1;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/* Handed to an init worker thread */
+	bool init_queued : 1;
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_REPORT
+	/* Cycle count when initialization started, its duration, and
+	 * the longest chain of dependency inits ending with this one
+	 */
+	uint32_t init_start;
+	uint32_t init_cycles;
+	uint32_t init_path;
+#endif
+
 #ifdef CONFIG_PM_DEVICE
 	/* Power management data */
 	struct pm_device pm;
@@ -384,6 +398,12 @@ struct device {
 	 * device_required_handles_get().
 	 */
 	const device_handle_t *const handles;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/** True if the handles list all devices this one needs, as they
+	 * do for devices from devicetree
+	 */
+	bool init_deps_known;
+#endif
 #ifdef CONFIG_PM_DEVICE
 	/** Power Management function */
 	int (*pm_control)(const struct device *dev, uint32_t command,
@@ -755,6 +775,7 @@ BUILD_ASSERT(sizeof(device_handle_t) == 2, "fix the linker scripts");
 
 #define Z_DEVICE_DEFINE_INIT(node_id, dev_name, pm_control_fn)		\
 		.handles = Z_DEVICE_HANDLE_NAME(node_id, dev_name),	\
+		Z_DEVICE_DEFINE_INIT_DEPS(node_id)			\
 		Z_DEVICE_DEFINE_PM_INIT(dev_name, pm_control_fn)
 
 /* Like DEVICE_DEFINE but takes a node_id AND a dev_name, and trailing
@@ -780,6 +801,13 @@ BUILD_ASSERT(sizeof(device_handle_t) == 2, "fix the linker scripts");
 	Z_INIT_ENTRY_DEFINE(DEVICE_NAME_GET(dev_name), init_fn,		\
 		(&DEVICE_NAME_GET(dev_name)), level, prio)
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define Z_DEVICE_DEFINE_INIT_DEPS(node_id)				\
+	.init_deps_known = DT_NODE_EXISTS(node_id),
+#else
+#define Z_DEVICE_DEFINE_INIT_DEPS(node_id)
+#endif
+
 #ifdef CONFIG_PM_DEVICE
 #define Z_DEVICE_DEFINE_PM_INIT(dev_name, pm_control_fn)		\
 	.pm_control = (pm_control_fn),				\
@@ -1470,6 +1470,25 @@ static inline uint32_t k_timer_remaining_get(struct k_timer *timer)
 	return k_ticks_to_ms_floor32(k_timer_remaining_ticks(timer));
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set how late a timer may expire.
+ *
+ * Lets each expiry of the timer be delayed by up to @a slack, so that
+ * it can share a wakeup with other timers expiring around the same
+ * time instead of waking the CPU on its own.  A periodic timer counts
+ * its periods from the nominal expiries, so the delays do not add up
+ * over time.  The slack applies from the next time the timer is started
+ * or restarted by its period, and is reset to zero by k_timer_init().
+ *
+ * @param timer Address of timer.
+ * @param slack Tolerated delay, K_NO_WAIT for an exact expiry.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
 
 /**
@@ -1620,6 +1639,15 @@ struct k_queue {
 	_wait_q_t wait_q;
 
 	_POLL_EVENT;
+
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* LIFO stack of items appended without the lock, newer than
+	 * everything in data_q
+	 */
+	atomic_ptr_t inbox;
+	/* Threads pended on, or polling, the queue */
+	atomic_t waiters;
+#endif
 };
 
 #define Z_QUEUE_INITIALIZER(obj) \
@@ -1863,6 +1891,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (atomic_ptr_get(&queue->inbox) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2691,6 +2724,142 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @}
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	uint32_t events;
+	struct k_spinlock lock;
+};
+
+#define Z_EVENT_INITIALIZER(obj)                                               \
+	{                                                                      \
+		.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),                          \
+		.events = 0,                                                   \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object with no events posted.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post one or more events to an event object.
+ *
+ * This routine adds the events in @a events to the event object. Every
+ * thread whose wait condition is satisfied by the new set of events is
+ * woken up, so the cost of a post grows with the number of waiting
+ * threads only.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to post.
+ *
+ * @return N/A
+ */
+__syscall void k_event_post(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Set the events in an event object.
+ *
+ * This routine replaces the events of the event object with @a events
+ * and wakes up every thread whose wait condition is satisfied by them.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to set.
+ *
+ * @return N/A
+ */
+__syscall void k_event_set(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Clear events in an event object.
+ *
+ * This routine removes the events in @a events from the event object.
+ * No thread is woken up.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to clear.
+ *
+ * @return N/A
+ */
+__syscall void k_event_clear(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Wait for any of the specified events.
+ *
+ * This routine waits until at least one of the events in @a events has
+ * been posted to the event object. If @a reset is true, all events of
+ * the object are cleared before waiting, so only events posted after
+ * the call can satisfy it.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @param event Address of the event object.
+ * @param events Set of desired events.
+ * @param reset If true, clear the events of the object before waiting.
+ * @param timeout Waiting period for the desired events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval set of matching events upon success
+ * @retval 0 if the desired events were not received within @a timeout
+ */
+__syscall uint32_t k_event_wait(struct k_event *event, uint32_t events,
+				bool reset, k_timeout_t timeout);
+
+/**
+ * @brief Wait for all of the specified events.
+ *
+ * This routine waits until every event in @a events has been posted to
+ * the event object. @a reset behaves as for k_event_wait().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @param event Address of the event object.
+ * @param events Set of desired events.
+ * @param reset If true, clear the events of the object before waiting.
+ * @param timeout Waiting period for the desired events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval set of matching events upon success
+ * @retval 0 if the desired events were not received within @a timeout
+ */
+__syscall uint32_t k_event_wait_all(struct k_event *event, uint32_t events,
+				    bool reset, k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name)                                                   \
+	Z_STRUCT_SECTION_ITERABLE(k_event, name) =                             \
+		Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2941,6 +3110,46 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 extern int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue at once.
+ *
+ * Equivalent to invoking k_work_submit_to_queue() on each item in turn,
+ * but the items are submitted under a single acquisition of the work lock
+ * and each affected queue is woken at most once, after the last item.
+ * This is intended for drivers that produce bursts of work from one
+ * interrupt.
+ *
+ * Submission stops at the first item that is rejected; the items before
+ * it remain submitted.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.  If
+ * NULL each item uses the queue from its most recent submission.
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of items in @p works.
+ *
+ * @return the number of items accepted, i.e. for which
+ * k_work_submit_to_queue() would have returned a non-negative value.  If
+ * the very first item is rejected its error is returned instead, as with
+ * k_work_submit_to_queue().
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works, size_t count);
+
+/** @brief Submit several work items to the system queue at once.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of items in @p works.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+extern int k_work_submit_batch(struct k_work **works, size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -3093,6 +3302,79 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+#if defined(CONFIG_WORKQUEUE_STATS) || defined(__DOXYGEN__)
+/** @brief Work queue statistics.
+ *
+ * Cycle counts are measured with k_cycle_get_32().
+ */
+struct k_work_queue_stats {
+	/** Number of items currently pending on the queue. */
+	uint32_t depth;
+
+	/** Highest number of items that were pending at once. */
+	uint32_t max_depth;
+
+	/** Number of items whose handler has completed. */
+	uint32_t executed;
+
+	/** Longest time an item waited between submission and start. */
+	uint32_t max_wait_cycles;
+
+	/** Longest time a handler ran. */
+	uint32_t max_run_cycles;
+
+	/** Total time items waited between submission and start. */
+	uint64_t total_wait_cycles;
+
+	/** Total time handlers ran. */
+	uint64_t total_run_cycles;
+};
+
+/** @brief Get the statistics of a work queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the queue structure.
+ *
+ * @param stats where to store a snapshot of the statistics.
+ */
+void k_work_queue_stats_get(struct k_work_q *queue,
+			    struct k_work_queue_stats *stats);
+
+/** @brief Reset the statistics of a work queue.
+ *
+ * Clears everything but the current depth.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the queue structure.
+ */
+void k_work_queue_stats_reset(struct k_work_q *queue);
+
+/** @brief Callback for k_work_queue_foreach().
+ *
+ * @param queue the started work queue.
+ *
+ * @param stats snapshot of its statistics.
+ *
+ * @param user_data as passed to k_work_queue_foreach().
+ */
+typedef void (*k_work_queue_cb_t)(struct k_work_q *queue,
+				  const struct k_work_queue_stats *stats,
+				  void *user_data);
+
+/** @brief Iterate over all started work queues.
+ *
+ * The callback is invoked without holding any lock, so it may print or
+ * block.  Queues started during the iteration may or may not be visited.
+ *
+ * @param cb function invoked for every queue.
+ *
+ * @param user_data passed to @p cb.
+ */
+void k_work_queue_foreach(k_work_queue_cb_t cb, void *user_data);
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3403,6 +3685,8 @@ enum {
 	/* Static work queue flags */
 	K_WORK_QUEUE_NO_YIELD_BIT = 8,
 	K_WORK_QUEUE_NO_YIELD = BIT(K_WORK_QUEUE_NO_YIELD_BIT),
+	K_WORK_QUEUE_BATCH_BIT = 9,
+	K_WORK_QUEUE_BATCH = BIT(K_WORK_QUEUE_BATCH_BIT),
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -3459,6 +3743,11 @@ struct k_work {
 	 * It can be RUNNING and CANCELING simultaneously.
 	 */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	/* Cycle count when the item was last put on a pending list. */
+	uint32_t queued_at;
+#endif
 };
 
 #define Z_WORK_INITIALIZER(work_handler) { \
@@ -3582,6 +3871,21 @@ struct k_work_queue_config {
 	 * control.
 	 */
 	bool no_yield;
+
+	/** Control whether the work queue thread runs items in batches.
+	 *
+	 * When set, the thread takes note of how many items are pending
+	 * when it starts working and runs that many back to back:
+	 * completing one item and claiming the next happens under a
+	 * single acquisition of the work lock, and the thread only
+	 * yields once the batch is done.  Items stay on the queue until
+	 * they start, so they can be cancelled as usual.
+	 *
+	 * This reduces the per-item overhead for queues that receive
+	 * bursts of work, at the cost of letting other threads of the
+	 * same priority wait for a whole batch.
+	 */
+	bool batch;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -3604,6 +3908,13 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	/* Node in the list of started queues. */
+	sys_snode_t stats_node;
+
+	struct k_work_queue_stats stats;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4293,6 +4604,63 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages, read from
+ * the array at @a data, to message queue @a msgq. Messages are handed
+ * directly to threads waiting to receive, then copied into the ring
+ * buffer until it is full, all under a single lock acquisition and with
+ * at most one reschedule.
+ *
+ * If no message at all can be sent, the routine waits up to @a timeout
+ * for room for the first one, exactly like k_msgq_put().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Non-negative waiting period to add the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent (which may be fewer than @a num_msgs)
+ *         on success, -ENOMSG if none could be sent without waiting or the
+ *         queue was purged, -EAGAIN if the waiting period timed out.
+ */
+__syscall int k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			       uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq into the array at @a data, in "first in, first out" order.
+ * Room freed in the ring buffer is refilled from threads waiting to send,
+ * all under a single lock acquisition and with at most one reschedule.
+ *
+ * If the queue is empty, the routine waits up to @a timeout for the first
+ * message, exactly like k_msgq_get().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an array able to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received on success, -ENOMSG if the queue was
+ *         empty and no waiting was requested, -EAGAIN if the waiting period
+ *         timed out.
+ */
+__syscall int k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			       uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4547,6 +4915,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4569,6 +4939,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4710,12 +5082,119 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer for writing in place.
+ *
+ * This routine returns the address of a contiguous free region of the
+ * pipe's ring buffer, so that the data can be produced there directly
+ * instead of being copied in by k_pipe_put(). The data only becomes
+ * visible to readers once it is committed with k_pipe_put_commit().
+ *
+ * If the buffer is full, the routine waits for a reader to make room,
+ * as k_pipe_put() would.
+ *
+ * @warning
+ * The pipe must not be written by any other means while a claim is
+ * outstanding, the same restriction as for ring_buf_put_claim().
+ *
+ * @note Not available to user mode threads, which cannot access the
+ * pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed region.
+ * @param size Number of bytes wanted.
+ * @param timeout Waiting period for free space, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of bytes claimed, which may be less than @a size when
+ *         the free space is smaller or wraps around the end of the buffer.
+ * @retval -EINVAL The pipe has no buffer or @a size is zero.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Commit data written to a claimed region of a pipe.
+ *
+ * This routine makes the first @a size bytes of the region returned by
+ * k_pipe_put_claim() available to readers, and hands them to readers
+ * already waiting on the pipe. It releases the claim.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written to the claimed region.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine returns the address of a contiguous region of data in the
+ * pipe's ring buffer, so that it can be consumed directly instead of
+ * being copied out by k_pipe_get(). The space is only released to writers
+ * by k_pipe_get_finish().
+ *
+ * If the pipe is empty, the routine waits for a writer to provide data,
+ * as k_pipe_get() would.
+ *
+ * @warning
+ * The pipe must not be read by any other means while a claim is
+ * outstanding, the same restriction as for ring_buf_get_claim().
+ *
+ * @note Not available to user mode threads, which cannot access the
+ * pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed region.
+ * @param size Maximum number of bytes wanted.
+ * @param timeout Waiting period for data, or one of the special values
+ *                K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of bytes claimed, which may be less than @a size when
+ *         less data is available or it wraps around the end of the buffer.
+ * @retval -EINVAL The pipe has no buffer or @a size is zero.
+ * @retval -EIO Returned without waiting; the pipe is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Release data read from a claimed region of a pipe.
+ *
+ * This routine frees the first @a size bytes of the region returned by
+ * k_pipe_get_claim(), and refills the freed space from writers already
+ * waiting on the pipe. It releases the claim.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed from the claimed region.
+ *
+ * @retval 0 Space released.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU list of free blocks, linked through the blocks like the
+ * slab's free list
+ */
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4723,10 +5202,20 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Updated outside of the lock by the cache fast paths */
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	struct z_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+	atomic_t cache_waiters;
+#else
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#endif
 
 };
 
@@ -4853,7 +5342,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4868,7 +5361,10 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && \
+	defined(CONFIG_MEM_SLAB_CPU_CACHE)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->max_used;
 #else
 	ARG_UNUSED(slab);
@@ -4888,7 +5384,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -4900,10 +5396,38 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_K_HEAP_CACHE
+/**
+ * @brief k_heap allocation cache statistics
+ *
+ * Counters are summed over all CPUs by k_heap_cache_stats_get().
+ */
+struct k_heap_cache_stats {
+	/** Cacheable allocations and frees served by a magazine */
+	uint32_t hits;
+	/** Cacheable allocations and frees that went to the shared heap */
+	uint32_t misses;
+	/** Number of times a non-empty magazine was flushed */
+	uint32_t flushes;
+};
+
+/* Per-CPU magazine of free blocks, one stack per size class */
+struct z_heap_magazine {
+	struct k_spinlock lock;
+	uint8_t count[CONFIG_K_HEAP_CACHE_CLASSES];
+	void *blocks[CONFIG_K_HEAP_CACHE_CLASSES][CONFIG_K_HEAP_CACHE_DEPTH];
+	struct k_heap_cache_stats stats;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_CACHE
+	struct z_heap_magazine cache[CONFIG_MP_NUM_CPUS];
+	atomic_t cache_waiters;
+#endif
 };
 
 /**
@@ -4978,10 +5502,41 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#if defined(CONFIG_K_HEAP_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Return all cached blocks of a k_heap to the shared heap
+ *
+ * With CONFIG_K_HEAP_CACHE, small blocks freed with k_heap_free() are
+ * kept in per-CPU magazines for reuse instead of being returned to
+ * the underlying sys_heap.  The kernel flushes the magazines itself
+ * when an allocation cannot otherwise be satisfied; this call is for
+ * callers that want the memory back in the shared heap right away,
+ * e.g. before inspecting it or handing it over to other code.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param h Heap whose magazines are flushed
+ */
+void k_heap_cache_flush(struct k_heap *h);
+
+/**
+ * @brief Read the allocation cache statistics of a k_heap
+ *
+ * @param h Heap to query
+ * @param stats Filled in with the counters summed over all CPUs
+ */
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats);
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_TLSF
+#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 120 : 108)
+#else
 #define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#endif
 
 /**
  * @brief Define a static k_heap
@@ -5624,6 +6179,76 @@ int k_thread_runtime_stats_get(k_tid_t thread,
  */
 int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+/**
+ * @brief Get the scheduling statistics of a thread
+ *
+ * A thread that is often preempted, waits long in the run queue or
+ * sees a high worst case wakeup latency points at a priority
+ * inversion or at starvation by higher priority threads.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_sched_stats_get(k_tid_t thread, k_thread_sched_stats_t *stats);
+#endif
+
+#endif
+
+#ifdef CONFIG_SCHED_IPI_STATS
+
+/**
+ * @brief Scheduler IPI statistics
+ */
+struct k_sched_ipi_stats {
+	/** IPIs sent by the scheduler, counting each interrupted CPU */
+	uint32_t sent;
+	/** IPIs received */
+	uint32_t received;
+	/** Received IPIs after which the CPU switched to another thread */
+	uint32_t switched;
+};
+
+/**
+ * @brief Get the scheduler IPI statistics
+ *
+ * Comparing @a switched with @a received tells how many IPIs were
+ * wasted on CPUs that went back to the thread they were running.
+ *
+ * @param cpu CPU index, or -1 for the sum over all CPUs
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer or invalid CPU, otherwise 0
+ */
+int k_sched_ipi_stats_get(int cpu, struct k_sched_ipi_stats *stats);
+
+#endif
+
+#ifdef CONFIG_IDLE_STATS
+
+/**
+ * @brief CPU idle statistics
+ */
+struct k_idle_stats {
+	/** Times the CPU went idle and was woken up */
+	uint32_t wakeups;
+	/** Cycles spent idle, including the interrupts that ended it */
+	uint64_t residency_cycles;
+};
+
+/**
+ * @brief Get the CPU idle statistics
+ *
+ * Dividing @a residency_cycles by @a wakeups gives the average time
+ * a CPU stays idle, which power management policies can weigh against
+ * the residency requirements of their low power states.
+ *
+ * @param cpu CPU index, or -1 for the sum over all CPUs
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer or invalid CPU, otherwise 0
+ */
+int k_idle_stats_get(int cpu, struct k_idle_stats *stats);
+
 #endif
 
 #ifdef __cplusplus
@@ -102,6 +102,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds the thread while queued */
+	uint8_t runq_cpu;
+#endif
+
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -157,6 +162,18 @@ struct _mem_domain_info {
 
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/* Kernel objects that passed validation in a system call by this thread */
+struct _obj_cache {
+	/** value of z_object_cache_gen the entries are valid for */
+	uint32_t gen;
+	/** validated objects, indexed by a hash of their address */
+	const void *obj[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** their enum k_objects type */
+	uint8_t type[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+};
+#endif
+
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 struct _thread_userspace_local_data {
 #if defined(CONFIG_ERRNO) && !defined(CONFIG_ERRNO_IN_TLS)
@@ -177,6 +194,29 @@ struct k_thread_runtime_stats {
 
 typedef struct k_thread_runtime_stats k_thread_runtime_stats_t;
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+struct k_thread_sched_stats {
+	/* Times the thread was made ready after blocking */
+	uint32_t wakeups;
+
+	/* Times the thread was switched out while still ready, i.e.
+	 * preempted or yielding
+	 */
+	uint32_t preemptions;
+
+	/* Cycles spent ready but not running */
+	uint64_t ready_cycles;
+
+	/* Cycles from being made ready to running, summed over all
+	 * wakeups, and the worst case
+	 */
+	uint64_t total_latency_cycles;
+	uint32_t max_latency_cycles;
+};
+
+typedef struct k_thread_sched_stats k_thread_sched_stats_t;
+#endif
+
 struct _thread_runtime_stats {
 	/* Timestamp when last switched in */
 #ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
@@ -186,6 +226,20 @@ struct _thread_runtime_stats {
 #endif
 
 	k_thread_runtime_stats_t stats;
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+	/* Timestamp when last made ready, valid while ready_state is
+	 * set, and whether that was a wakeup or a preemption
+	 */
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	timing_t ready_since;
+#else
+	uint32_t ready_since;
+#endif
+	uint8_t ready_state;
+
+	k_thread_sched_stats_t sched;
+#endif
 };
 #endif
 
@@ -215,6 +269,17 @@ struct k_thread {
 	struct z_poller poller;
 #endif
 
+#if defined(CONFIG_EVENTS)
+	/** threads being woken by the same k_event post */
+	struct k_thread *next_event_link;
+
+	/** events the thread waits for, then the events that woke it */
+	uint32_t events;
+
+	/** wait options, K_EVENT_WAIT_ALL or K_EVENT_WAIT_ANY */
+	uint32_t event_options;
+#endif
+
 #if defined(CONFIG_THREAD_MONITOR)
 	/** thread entry and parameters description */
 	struct __thread_entry entry;
@@ -256,6 +321,10 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#if defined(CONFIG_USERSPACE_OBJ_CACHE)
+	/** recently validated kernel objects */
+	struct _obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
@@ -93,6 +93,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in runq */
+	uint32_t count;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -127,6 +132,41 @@ struct _cpu {
 	uint8_t swap_ok;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Threads queued to run on this CPU */
+	struct _ready_q ready_q;
+#endif
+
+#ifdef CONFIG_SCHED_IPI_STATS
+	/* Scheduler IPIs sent by this CPU, received by it, and received
+	 * ones followed by a context switch
+	 */
+	uint32_t ipi_sent;
+	uint32_t ipi_received;
+	uint32_t ipi_switched;
+
+	/* An IPI arrived and no scheduling decision was taken since */
+	uint8_t ipi_pending;
+#endif
+
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+	/* RCU read sections entered on this CPU, and count of the
+	 * quiescent states it went through outside of them
+	 */
+	uint32_t rcu_nesting;
+	atomic_t rcu_qs;
+#endif
+
+#ifdef CONFIG_IDLE_STATS
+	/* Idle periods, cycles spent in them, and start of the current
+	 * one while idling is set
+	 */
+	uint32_t idle_wakeups;
+	uint64_t idle_cycles;
+	uint32_t idle_start;
+	uint8_t idling;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -149,7 +189,9 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
+#ifndef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
+#endif
 
 #ifdef CONFIG_FPU_SHARING
 	/*
@@ -223,11 +265,19 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  Holds
+	 * the absolute expiry tick with CONFIG_TIMEOUT_QUEUE_WHEEL.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed by to share a wakeup */
+	int32_t slack;
+	/* Ticks the pending expiry was delayed by */
+	int32_t slack_delay;
+#endif
 };
 
 #endif /* _ASMLANGUAGE */
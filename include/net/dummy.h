@@ -31,6 +31,13 @@ struct dummy_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+	/** Optional. Send several network packets, in order. Returns the
+	 * number of packets sent, which are the first ones of the array,
+	 * or a negative error code if none could be sent.
+	 */
+	int (*send_burst)(const struct device *dev, struct net_pkt **pkts,
+			  size_t count);
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -150,6 +150,12 @@ enum ethernet_hw_caps {
 	/** DSA switch */
 	ETHERNET_DSA_SLAVE_PORT	= BIT(15),
 	ETHERNET_DSA_MASTER_PORT	= BIT(16),
+
+	/** TCP segmentation offloading supported */
+	ETHERNET_HW_TSO			= BIT(17),
+
+	/** TCP large receive offloading supported */
+	ETHERNET_HW_LRO			= BIT(18),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -287,6 +293,14 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+	/** Optional. Send several network packets, in order. Returns the
+	 * number of packets sent, which are the first ones of the array,
+	 * or a negative error code if none could be sent. Packets are
+	 * handed over like with send().
+	 */
+	int (*send_burst)(const struct device *dev, struct net_pkt **pkts,
+			  size_t count);
 };
 
 /* Make sure that the network interface API is properly setup inside
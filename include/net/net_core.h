@@ -117,6 +117,22 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when several network packets have
+ * been received. This works like calling net_recv_data() for each packet in
+ * turn, but the per call overhead is paid once for the whole array.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of network packets, in the order they were received.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets taken by the stack, which are the first ones of
+ * the array, up to the first empty packet. The caller keeps the others.
+ * <0 if error, in which case no packet was taken.
+ */
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Send data to network.
  *
@@ -199,6 +199,29 @@ enum net_if_flag {
 /** @endcond */
 };
 
+/** Offloads a network interface does on behalf of the network stack */
+enum net_if_offload {
+	/** Checksums of sent IPv4, UDP and TCP packets are calculated
+	 * by the device
+	 */
+	NET_IF_OFFLOAD_TX_CHKSUM	= BIT(0),
+
+	/** Checksums of received IPv4, UDP and TCP packets are verified
+	 * by the device
+	 */
+	NET_IF_OFFLOAD_RX_CHKSUM	= BIT(1),
+
+	/** TCP segmentation: TCP packets larger than the MSS are cut into
+	 * MSS sized segments by the device
+	 */
+	NET_IF_OFFLOAD_TSO		= BIT(2),
+
+	/** Large receive: consecutive TCP segments are coalesced by the
+	 * device before being passed to the network stack
+	 */
+	NET_IF_OFFLOAD_LRO		= BIT(3),
+};
+
 #if defined(CONFIG_NET_OFFLOAD)
 struct net_offload;
 #endif /* CONFIG_NET_OFFLOAD */
@@ -452,6 +475,9 @@ struct net_if_dev {
 	/** The hardware MTU */
 	uint16_t mtu;
 
+	/** Offloads done by the device, see enum net_if_offload */
+	uint8_t offloads;
+
 #if defined(CONFIG_NET_SOCKETS_OFFLOAD)
 	/** Indicate whether interface is offloaded at socket level. */
 	bool offloaded;
@@ -808,6 +834,42 @@ static inline void net_if_set_mtu(struct net_if *iface,
 	iface->if_dev->mtu = mtu;
 }
 
+/**
+ * @brief Get the offloads a network interface does
+ *
+ * @param iface Pointer to a network interface structure
+ *
+ * @return Offloads as a bitmask of enum net_if_offload values
+ */
+static inline uint8_t net_if_get_offloads(struct net_if *iface)
+{
+	if (iface == NULL) {
+		return 0U;
+	}
+
+	return iface->if_dev->offloads;
+}
+
+/**
+ * @brief Set the offloads a network interface does
+ *
+ * @details This is called by the device driver, typically from its
+ * interface init function. The network stack then leaves the offloaded
+ * work to the device.
+ *
+ * @param iface Pointer to a network interface structure
+ * @param offloads Bitmask of enum net_if_offload values
+ */
+static inline void net_if_set_offloads(struct net_if *iface,
+				       uint8_t offloads)
+{
+	if (iface == NULL) {
+		return;
+	}
+
+	iface->if_dev->offloads = offloads;
+}
+
 /**
  * @brief Set the infinite status of the network interface address
  *
@@ -66,6 +66,14 @@ struct net_l2 {
 	 */
 	int (*send)(struct net_if *iface, struct net_pkt *pkt);
 
+	/**
+	 * Optional. This function is used by net core to push several packets
+	 * to lower layer in one go, in order. The value send() would have
+	 * returned for each packet is stored at the same index of status.
+	 */
+	void (*send_burst)(struct net_if *iface, struct net_pkt **pkts,
+			   int *status, size_t count);
+
 	/**
 	 * This function is used to enable/disable traffic over a network
 	 * interface. The function returns <0 if error and >=0 if no error.
@@ -132,15 +140,21 @@ NET_L2_DECLARE_PUBLIC(CANBUS_RAW_L2);
 NET_L2_DECLARE_PUBLIC(CANBUS_L2);
 #endif /* CONFIG_NET_L2_CANBUS */
 
-#define NET_L2_INIT(_name, _recv_fn, _send_fn, _enable_fn, _get_flags_fn) \
+#define NET_L2_INIT_BURST(_name, _recv_fn, _send_fn, _send_burst_fn,	\
+			  _enable_fn, _get_flags_fn)			\
 	const Z_STRUCT_SECTION_ITERABLE(net_l2,				\
 					NET_L2_GET_NAME(_name)) = {	\
 		.recv = (_recv_fn),					\
 		.send = (_send_fn),					\
+		.send_burst = (_send_burst_fn),				\
 		.enable = (_enable_fn),					\
 		.get_flags = (_get_flags_fn),				\
 	}
 
+#define NET_L2_INIT(_name, _recv_fn, _send_fn, _enable_fn, _get_flags_fn) \
+	NET_L2_INIT_BURST(_name, _recv_fn, _send_fn, NULL, _enable_fn,	\
+			  _get_flags_fn)
+
 #define NET_L2_GET_DATA(name, sfx) _net_l2_data_##name##sfx
 
 #define NET_L2_DATA_INIT(name, sfx, ctx_type)				\
@@ -158,6 +172,21 @@ static inline int net_l2_send(net_l2_send_t send_fn,
 	return send_fn(dev, pkt);
 }
 
+typedef int (*net_l2_send_burst_t)(const struct device *dev,
+				   struct net_pkt **pkts, size_t count);
+
+static inline int net_l2_send_burst(net_l2_send_burst_t send_burst_fn,
+				    const struct device *dev,
+				    struct net_if *iface,
+				    struct net_pkt **pkts, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		net_capture_pkt(iface, pkts[i]);
+	}
+
+	return send_burst_fn(dev, pkts, count);
+}
+
 /** @endcond */
 
 /**
@@ -184,6 +184,11 @@ struct net_pkt {
 	uint8_t captured : 1; /* Set to 1 if this packet is already being
 			       * captured
 			       */
+	uint8_t chksum_ok : 1; /* For incoming packet: the IP, UDP and TCP
+				* checksums are known to be valid, either
+				* checked by the device or when received
+				* segments were coalesced.
+				*/
 
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
@@ -207,6 +212,13 @@ struct net_pkt {
 	 */
 	uint8_t priority;
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* For outgoing TCP packet: size of the segments it is cut into
+	 * before reaching the network, 0 if it is sent as it is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -340,6 +352,37 @@ static inline void net_pkt_set_captured(struct net_pkt *pkt, bool is_captured)
 	pkt->captured = is_captured;
 }
 
+static inline bool net_pkt_is_chksum_ok(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_ok);
+}
+
+static inline void net_pkt_set_chksum_ok(struct net_pkt *pkt, bool is_ok)
+{
+	pkt->chksum_ok = is_ok;
+}
+
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	return pkt->gso_size;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	pkt->gso_size = size;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+#endif
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -389,6 +389,16 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on every CPU whose bit is set in
+ * @a cpu_mask.  Only required with CONFIG_ARCH_HAS_DIRECTED_IPIS.
+ *
+ * @param cpu_mask Bitmask of the CPUs to interrupt, by CPU index
+ */
+void arch_sched_directed_ipi(uint32_t cpu_mask);
 #endif /* CONFIG_SMP */
 
 /** @} */
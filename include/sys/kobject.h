@@ -346,6 +346,46 @@ static inline void k_object_free(void *obj)
 /* LCOV_EXCL_STOP */
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
+#if defined(CONFIG_SYSCALL_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief System call profiling data
+ *
+ * Cycles are measured with k_cycle_get_32() from the dispatch of the
+ * system call to the return of its handler.
+ */
+struct k_syscall_stats {
+	/** Number of completed invocations */
+	uint32_t count;
+	/** Longest invocation */
+	uint32_t max_cycles;
+	/** Total time of all invocations */
+	uint64_t cycles;
+};
+
+/**
+ * Get the profiling data of a system call
+ *
+ * Only available with CONFIG_SYSCALL_STATS, from supervisor mode.
+ * System call IDs are the K_SYSCALL_* constants from syscall_list.h and
+ * run from 0 to K_SYSCALL_BAD - 1.
+ *
+ * @param id System call ID
+ * @param stats Where to store the data
+ * @param name If not NULL, set to the name of the system call
+ * @retval 0 on success
+ * @retval -EINVAL if @a id is not a valid system call ID
+ */
+int k_syscall_stats_get(uint32_t id, struct k_syscall_stats *stats,
+			const char **name);
+
+/**
+ * Reset the profiling data of all system calls
+ *
+ * Only available with CONFIG_SYSCALL_STATS, from supervisor mode.
+ */
+void k_syscall_stats_reset(void);
+#endif /* CONFIG_SYSCALL_STATS */
+
 /** @} */
 
 #include <syscalls/kobject.h>
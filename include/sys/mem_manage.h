@@ -105,6 +105,11 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+	struct {
+		/** Number of pages read ahead of a faulting page */
+		unsigned long			pages;
+	} read_ahead;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_P4WQ_WS_H_
+#define ZEPHYR_INCLUDE_SYS_P4WQ_WS_H_
+
+#include <kernel.h>
+#include <sys/p4wq.h>
+
+/* Work-stealing executor running on P4 Work Queue threads
+ *
+ * Each worker owns a deque of tasks.  Tasks spawned by a running task
+ * go to the bottom of its worker's deque and are popped from there by
+ * the same worker (LIFO, so the data they touch is still in that
+ * CPU's cache), while idle workers steal the oldest task from the top
+ * of another worker's deque.  Every worker is a long running
+ * k_p4wq_work item on a queue of its own, so the threads, their
+ * stacks and their priority come from the P4 queue pool.
+ */
+
+struct k_p4wq_ws;
+struct k_p4wq_ws_task;
+struct k_p4wq_ws_worker;
+
+/**
+ * Work-stealing task handler callback
+ */
+typedef void (*k_p4wq_ws_handler_t)(struct k_p4wq_ws_task *task);
+
+/**
+ * @brief Work-stealing task
+ *
+ * User-populated struct representing a single task.  Tasks are usually
+ * embedded in a struct carrying their arguments and results, which the
+ * handler retrieves with CONTAINER_OF().
+ */
+struct k_p4wq_ws_task {
+	/* Filled out by submitting code */
+	k_p4wq_ws_handler_t handler;
+
+	/* reserved for implementation */
+	struct k_p4wq_ws_task *parent;
+	struct k_p4wq_ws_worker *worker;
+	atomic_t pending;
+	struct k_sem done_sem;
+};
+
+/**
+ * @brief Work-stealing worker
+ *
+ * One per thread of the executor.  The statistics are only updated by
+ * the worker itself and may be read at any time.
+ */
+struct k_p4wq_ws_worker {
+	struct k_spinlock lock;
+
+	/* Ring of tasks, the owner works at the bottom and thieves
+	 * take from the top
+	 */
+	struct k_p4wq_ws_task *deque[CONFIG_P4WQ_WS_DEQUE_SIZE];
+	uint32_t top;
+	uint32_t bottom;
+
+	/* Nesting of tasks run while joining */
+	uint32_t depth;
+
+	struct k_p4wq_work work;
+	struct k_p4wq_ws *ws;
+	uint32_t id;
+
+	/* Statistics: tasks run, and how many of those were stolen */
+	uint32_t executed;
+	uint32_t stolen;
+};
+
+/**
+ * @brief Work-stealing executor
+ */
+struct k_p4wq_ws {
+	struct k_p4wq *queues;
+	struct k_thread *threads;
+	struct k_p4wq_ws_worker *workers;
+	uint32_t num_workers;
+
+	/* Workers sleeping for lack of tasks */
+	atomic_t idle;
+	struct k_sem wake_sem;
+
+	/* Round robin position for tasks without affinity */
+	atomic_t next;
+	atomic_t running;
+
+	/* Worker threads started, with their CPU masks set */
+	bool started;
+};
+
+/** Submit to any worker */
+#define K_P4WQ_WS_ANY_WORKER (-1)
+
+/* With CPU masks, worker threads are only started once their masks
+ * are set, by k_p4wq_ws_start()
+ */
+#ifdef CONFIG_SCHED_CPU_MASK
+#define Z_P4WQ_WS_FLAGS K_P4WQ_USER_CPU_MASK
+#else
+#define Z_P4WQ_WS_FLAGS 0
+#endif
+
+/**
+ * @brief Statically define a work-stealing executor
+ *
+ * Defines a struct k_p4wq_ws with the specified number of workers,
+ * each with a P4 queue and thread of its own which are created at boot.
+ * The executor must be started with k_p4wq_ws_start() before tasks
+ * are submitted.
+ *
+ * @param name Symbol name of the struct k_p4wq_ws that will be defined
+ * @param n_workers Number of worker threads
+ * @param stack_sz Requested stack size of each worker thread, in bytes
+ */
+#define K_P4WQ_WS_DEFINE(name, n_workers, stack_sz)			\
+	K_P4WQ_ARRAY_DEFINE(_p4ws_##name, n_workers, stack_sz,		\
+			    Z_P4WQ_WS_FLAGS);				\
+	static struct k_p4wq_ws_worker _p4ws_workers_##name[n_workers]; \
+	static struct k_p4wq_ws name = {				\
+		.queues = _p4ws_##name,					\
+		.threads = _p4threads__p4ws_##name,			\
+		.workers = _p4ws_workers_##name,			\
+		.num_workers = n_workers,				\
+	}
+
+/**
+ * @brief Start a work-stealing executor
+ *
+ * Binds every worker thread to its CPUs and starts the worker loops
+ * at the given priority.  With CONFIG_SCHED_CPU_MASK, worker @em i is
+ * restricted to the CPUs in @a cpu_masks[i], or to CPU
+ * @em i % CONFIG_MP_NUM_CPUS if @a cpu_masks is NULL.  Without it the
+ * workers may run anywhere.  The masks are set when the executor is
+ * first started, and kept by later starts.
+ *
+ * @param ws Executor to start
+ * @param priority Thread priority of the workers
+ * @param cpu_masks Per-worker CPU masks, or NULL
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if the executor is already running
+ */
+int k_p4wq_ws_start(struct k_p4wq_ws *ws, int priority,
+		    const uint32_t *cpu_masks);
+
+/**
+ * @brief Stop a work-stealing executor
+ *
+ * Waits for the worker loops to exit and returns their threads to the
+ * P4 queue pool.  All submitted tasks must have completed.
+ *
+ * @param ws Executor to stop
+ */
+void k_p4wq_ws_stop(struct k_p4wq_ws *ws);
+
+/**
+ * @brief Submit a task to a work-stealing executor
+ *
+ * Queues a root task from outside the executor.  The task is placed
+ * on the deque of the requested worker, so it runs there unless
+ * another worker runs out of work and steals it first.  Its completion
+ * is awaited with k_p4wq_ws_wait().
+ *
+ * @param ws Executor to submit to
+ * @param task Task to run
+ * @param worker Preferred worker, or K_P4WQ_WS_ANY_WORKER
+ *
+ * @retval 0 on success
+ * @retval -ENOSPC if the worker's deque is full
+ */
+int k_p4wq_ws_submit(struct k_p4wq_ws *ws, struct k_p4wq_ws_task *task,
+		     int worker);
+
+/**
+ * @brief Wait for a submitted task to complete
+ *
+ * A task completes once its handler and all of its children have
+ * returned.
+ *
+ * @param task Task passed to k_p4wq_ws_submit()
+ * @param timeout Waiting period, or one of the special values K_NO_WAIT
+ *                and K_FOREVER
+ *
+ * @retval 0 when the task has completed
+ * @retval -EAGAIN when the timeout expired first
+ */
+int k_p4wq_ws_wait(struct k_p4wq_ws_task *task, k_timeout_t timeout);
+
+/**
+ * @brief Spawn a child task
+ *
+ * May only be called from the handler of @a parent.  The child is
+ * pushed on the current worker's deque, from where this worker or a
+ * thief runs it.  If the deque is full the child runs right away in
+ * the caller's context.  The child must stay valid until
+ * k_p4wq_ws_join() on the parent returns; the parent's handler
+ * returning joins implicitly.
+ *
+ * @param parent Task whose handler is running
+ * @param child Task to run
+ */
+void k_p4wq_ws_spawn(struct k_p4wq_ws_task *parent,
+		     struct k_p4wq_ws_task *child);
+
+/**
+ * @brief Wait for all children of a task
+ *
+ * May only be called from the handler of @a task.  Rather than
+ * blocking, the worker runs the children still on its own deque, and
+ * steals from other workers while the remaining ones run elsewhere.
+ *
+ * @param task Task whose handler is running
+ */
+void k_p4wq_ws_join(struct k_p4wq_ws_task *task);
+
+#endif /* ZEPHYR_INCLUDE_SYS_P4WQ_WS_H_ */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_RCU_H_
+#define ZEPHYR_INCLUDE_SYS_RCU_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rcu_apis Read-copy-update APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/* Read-copy-update for read-mostly data reached through a pointer
+ *
+ * Writers never modify data that readers may be looking at: they
+ * build an updated copy, publish it with k_rcu_assign_pointer(), wait
+ * for a grace period with k_rcu_synchronize() and only then free or
+ * reuse the old copy.  Readers bracket their accesses with
+ * k_rcu_read_lock() and k_rcu_read_unlock(), which touch no shared
+ * memory, and fetch the pointer with k_rcu_dereference().
+ *
+ * A read section keeps the thread from being preempted, and must not
+ * block.  A grace period ends once every other CPU has gone through a
+ * context switch or an interrupt exit outside of a read section; CPUs
+ * that do not get there on their own are sent a scheduler IPI.
+ *
+ * Read sections may be used from supervisor threads and ISRs.  User
+ * threads are not allowed to disable preemption; sharing read-mostly
+ * data with them is done with a struct k_seqlock.
+ */
+
+/**
+ * @brief Enter an RCU read section
+ *
+ * Read sections can nest.
+ */
+void k_rcu_read_lock(void);
+
+/**
+ * @brief Leave an RCU read section
+ *
+ * Leaving the outermost read section of a thread reschedules if a
+ * higher priority thread became ready meanwhile.
+ */
+void k_rcu_read_unlock(void);
+
+/**
+ * @brief Wait for all running RCU read sections to end
+ *
+ * Returns once no reader can still hold a pointer it fetched before
+ * the call, so data unpublished before the call may be freed.  Must be
+ * called from a thread, outside of any read section.
+ */
+void k_rcu_synchronize(void);
+
+/**
+ * @brief Fetch an RCU protected pointer
+ *
+ * @param ptr Pointer variable, of type atomic_ptr_t
+ * @return Pointer value, valid until the end of the read section
+ */
+#define k_rcu_dereference(ptr) atomic_ptr_get(&(ptr))
+
+/**
+ * @brief Publish a new value of an RCU protected pointer
+ *
+ * The data pointed to must be fully initialized before.
+ *
+ * @param ptr Pointer variable, of type atomic_ptr_t
+ * @param val New value
+ */
+#define k_rcu_assign_pointer(ptr, val) \
+	((void)atomic_ptr_set(&(ptr), (atomic_ptr_val_t)(val)))
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RCU_H_ */
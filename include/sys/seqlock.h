@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_SEQLOCK_H_
+#define ZEPHYR_INCLUDE_SYS_SEQLOCK_H_
+
+#include <kernel.h>
+#include <spinlock.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup seqlock_apis Sequence lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Sequence lock
+ *
+ * Protects small, read-mostly data that readers can copy out, such as
+ * configuration snapshots or calibration values.  Readers take no lock
+ * and write nothing: they sample a sequence count, read the data and
+ * start over if a writer was active meanwhile.  Writers are serialized
+ * by a spinlock and bump the count before and after updating.
+ *
+ * Readers may run in ISRs, and in user mode when the seqlock and the
+ * data it protects are in a memory partition the thread can read.
+ * Writers must be in supervisor mode.  Since readers may see data in
+ * the middle of an update, they must not follow pointers read under
+ * the lock, and must discard anything they read when
+ * k_seqlock_read_retry() returns true.
+ *
+ * A zero-initialized seqlock is unlocked.
+ */
+struct k_seqlock {
+	atomic_t seq;
+	struct k_spinlock lock;
+};
+
+/* Order the data accesses against the sequence count.  Uniprocessor
+ * readers can only be interrupted by a writer, so keeping the compiler
+ * from reordering is enough there.
+ */
+static ALWAYS_INLINE void z_seqlock_barrier(void)
+{
+#ifdef CONFIG_SMP
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+	compiler_barrier();
+#endif
+}
+
+/**
+ * @brief Start updating data protected by a seqlock
+ *
+ * Locks out other writers, and makes readers retry until
+ * k_seqlock_write_unlock() is called.  Interrupts are masked like with
+ * k_spin_lock(), so the update must be short.
+ *
+ * @param sl Seqlock
+ * @return Key to pass to k_seqlock_write_unlock()
+ */
+static ALWAYS_INLINE k_spinlock_key_t k_seqlock_write_lock(struct k_seqlock *sl)
+{
+	k_spinlock_key_t key = k_spin_lock(&sl->lock);
+
+	atomic_inc(&sl->seq);
+	z_seqlock_barrier();
+
+	return key;
+}
+
+/**
+ * @brief Finish updating data protected by a seqlock
+ *
+ * @param sl Seqlock
+ * @param key Key returned by k_seqlock_write_lock()
+ */
+static ALWAYS_INLINE void k_seqlock_write_unlock(struct k_seqlock *sl,
+						 k_spinlock_key_t key)
+{
+	z_seqlock_barrier();
+	atomic_inc(&sl->seq);
+
+	k_spin_unlock(&sl->lock, key);
+}
+
+/**
+ * @brief Start reading data protected by a seqlock
+ *
+ * Waits for a running update to finish.  Typical use:
+ *
+ * @code
+ * do {
+ *	seq = k_seqlock_read_begin(&lock);
+ *	copy = data;
+ * } while (k_seqlock_read_retry(&lock, seq));
+ * @endcode
+ *
+ * Must not be called on the CPU holding the write lock.
+ *
+ * @param sl Seqlock
+ * @return Sequence count to pass to k_seqlock_read_retry()
+ */
+static ALWAYS_INLINE atomic_val_t k_seqlock_read_begin(const struct k_seqlock *sl)
+{
+	atomic_val_t seq;
+
+	do {
+		seq = atomic_get(&sl->seq);
+	} while ((seq & 1) != 0);
+
+	z_seqlock_barrier();
+
+	return seq;
+}
+
+/**
+ * @brief Check whether data read under a seqlock is consistent
+ *
+ * @param sl Seqlock
+ * @param seq Sequence count returned by k_seqlock_read_begin()
+ * @retval true if a writer got in, and the data must be read again
+ * @retval false if the data read since k_seqlock_read_begin() is valid
+ */
+static ALWAYS_INLINE bool k_seqlock_read_retry(const struct k_seqlock *sl,
+					       atomic_val_t seq)
+{
+	z_seqlock_barrier();
+
+	return atomic_get(&sl->seq) != seq;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SEQLOCK_H_ */
@@ -120,11 +120,32 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+/** @brief Return allocated memory size
+ *
+ * Returns the number of bytes available to the caller in a block
+ * previously returned from sys_heap_alloc() or
+ * sys_heap_aligned_alloc().  This may be larger than the size
+ * originally requested, as the heap rounds allocations up to its
+ * internal chunk granularity.
+ *
+ * @note Unlike the other sys_heap functions this only reads the
+ * header of the (still allocated) block itself, so it is safe to
+ * call without holding the lock that serializes the heap as long as
+ * the caller owns @a mem.
+ *
+ * @param heap Heap containing the block
+ * @param mem A pointer previously returned from sys_heap_alloc()
+ * @return Size of the usable memory region in bytes
+ */
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
  * but a different allocated size.  If the new allocation can be
- * expanded in place, the pointer returned will be identical.
+ * expanded in place, the pointer returned will be identical.  If it
+ * can be expanded into a free block immediately below it instead,
+ * the contents are moved down and the returned pointer is lower.
  * Otherwise the data will be copies to a new block and the old one
  * will be freed as per sys_heap_free().  If the specified size is
  * smaller than the original, the block will be truncated in place and
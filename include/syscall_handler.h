@@ -15,6 +15,7 @@
 #include <sys/arch_interface.h>
 #include <sys/math_extras.h>
 #include <stdbool.h>
+#include <string.h>
 #include <logging/log.h>
 
 extern const _k_syscall_handler_t _k_syscall_table[K_SYSCALL_LIMIT];
@@ -445,11 +446,84 @@ static inline int z_obj_validation_check(struct z_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+BUILD_ASSERT((CONFIG_USERSPACE_OBJ_CACHE_SIZE &
+	      (CONFIG_USERSPACE_OBJ_CACHE_SIZE - 1)) == 0,
+	     "USERSPACE_OBJ_CACHE_SIZE must be a power of two");
+
+/* Incremented whenever a validation result may have changed: on a
+ * permission being revoked, or an object being uninitialized or freed.
+ * Per-thread caches filled under an older value are discarded.
+ */
+extern atomic_t z_object_cache_gen;
+
+/* Start a new thread with an empty object cache */
+static inline void z_obj_cache_init(struct k_thread *thread)
+{
+	(void)memset(thread->obj_cache.type, K_OBJ_ANY,
+		     sizeof(thread->obj_cache.type));
+	thread->obj_cache.gen = (uint32_t)atomic_get(&z_object_cache_gen);
+}
+
+static inline unsigned int z_obj_cache_slot(const void *obj)
+{
+	uintptr_t addr = (uintptr_t)obj;
+
+	return ((addr >> 3) ^ (addr >> 9)) &
+		(CONFIG_USERSPACE_OBJ_CACHE_SIZE - 1);
+}
+
+/* Same as z_obj_validation_check(z_object_find(obj), ...), but objects
+ * that are initialized and accessible by the current thread are
+ * remembered in its object cache, so that the next validation of the
+ * same object is a single comparison.
+ */
+static inline int z_obj_cached_validation_check(const void *obj,
+						enum k_objects otype,
+						enum _obj_init_check init)
+{
+	struct _obj_cache *cache = &_current->obj_cache;
+	unsigned int slot = z_obj_cache_slot(obj);
+	uint32_t gen = (uint32_t)atomic_get(&z_object_cache_gen);
+	struct z_object *ko;
+	int ret;
+
+	if (unlikely(cache->gen != gen)) {
+		(void)memset(cache->type, K_OBJ_ANY, sizeof(cache->type));
+		cache->gen = gen;
+	} else if ((init == _OBJ_INIT_TRUE) && (cache->obj[slot] == obj) &&
+		   (cache->type[slot] != K_OBJ_ANY) &&
+		   ((otype == K_OBJ_ANY) || (cache->type[slot] == otype))) {
+		return 0;
+	}
+
+	ko = z_object_find(obj);
+	ret = z_obj_validation_check(ko, obj, otype, init);
+
+	/* Only "must be initialized" checks are cached, since their
+	 * outcome can only change through something that bumps the
+	 * generation.  An invalidation racing with this check bumped it
+	 * after we read it, so the entry is discarded on next use.
+	 */
+	if ((ret == 0) && (init == _OBJ_INIT_TRUE)) {
+		cache->obj[slot] = obj;
+		cache->type[slot] = ko->type;
+	}
+
+	return ret;
+}
+
+#define Z_SYSCALL_IS_OBJ(ptr, type, init) \
+	Z_SYSCALL_VERIFY_MSG(z_obj_cached_validation_check(		\
+				     (const void *)ptr,			\
+				     type, init) == 0, "access denied")
+#else
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
 				     z_object_find((const void *)ptr),	\
 				     (const void *)ptr,			\
 				     type, init) == 0, "access denied")
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
@@ -275,6 +275,13 @@
  */
 #define sys_port_trace_k_thread_sched_suspend(thread)
 
+/**
+ * @brief Trace the latency of a thread from being made ready to running
+ * @param thread Thread object
+ * @param cycles Latency in cycles
+ */
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)
+
 /**
  * @}
  */ /* end of thread_tracing_apis */
@@ -880,6 +887,81 @@
  * @}
  */ /* end of condvar_tracing_apis */
 
+/**
+ * @brief Event Tracing APIs
+ * @defgroup event_tracing_apis Event Tracing APIs
+ * @ingroup tracing_apis
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of Event
+ * @param event Event object
+ */
+#define sys_port_trace_k_event_init(event)
+
+/**
+ * @brief Trace Event post start
+ * @param event Event object
+ * @param events Events being posted
+ */
+#define sys_port_trace_k_event_post_enter(event, events)
+
+/**
+ * @brief Trace Event post outcome
+ * @param event Event object
+ * @param events Events of the object after the post
+ */
+#define sys_port_trace_k_event_post_exit(event, events)
+
+/**
+ * @brief Trace Event set start
+ * @param event Event object
+ * @param events Events being set
+ */
+#define sys_port_trace_k_event_set_enter(event, events)
+
+/**
+ * @brief Trace Event set outcome
+ * @param event Event object
+ * @param events Events of the object after the set
+ */
+#define sys_port_trace_k_event_set_exit(event, events)
+
+/**
+ * @brief Trace Event clear
+ * @param event Event object
+ * @param events Events being cleared
+ */
+#define sys_port_trace_k_event_clear(event, events)
+
+/**
+ * @brief Trace Event wait start
+ * @param event Event object
+ * @param events Desired events
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+
+/**
+ * @brief Trace Event wait blocking
+ * @param event Event object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_event_wait_blocking(event, timeout)
+
+/**
+ * @brief Trace Event wait outcome
+ * @param event Event object
+ * @param events Desired events
+ * @param ret Matching events, or 0 on timeout
+ */
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+
+/**
+ * @}
+ */ /* end of event_tracing_apis */
+
 
 
 
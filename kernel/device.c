@@ -8,6 +8,7 @@
 #include <device.h>
 #include <sys/atomic.h>
 #include <syscall_handler.h>
+#include <sys/printk.h>
 
 extern const struct init_entry __init_start[];
 extern const struct init_entry __init_PRE_KERNEL_1_start[];
@@ -53,6 +54,203 @@ void z_device_state_init(void)
 	}
 }
 
+static void init_entry_run(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+#ifdef CONFIG_DEVICE_INIT_REPORT
+	uint32_t start = k_cycle_get_32();
+#endif
+	int rc = entry->init(dev);
+
+	if (dev != NULL) {
+#ifdef CONFIG_DEVICE_INIT_REPORT
+		size_t count = 0;
+		const device_handle_t *deps =
+			device_required_handles_get(dev, &count);
+		uint32_t path = 0;
+
+		/* Everything required has completed by now */
+		for (size_t i = 0; i < count; i++) {
+			const struct device *req = device_from_handle(deps[i]);
+
+			if ((req != NULL) && (req->state->init_path > path)) {
+				path = req->state->init_path;
+			}
+		}
+
+		dev->state->init_start = start;
+		dev->state->init_cycles = k_cycle_get_32() - start;
+		dev->state->init_path = path + dev->state->init_cycles;
+#endif
+		/* Mark device initialized.  If initialization
+		 * failed, record the error condition.
+		 */
+		if (rc != 0) {
+			if (rc < 0) {
+				rc = -rc;
+			}
+			if (rc > UINT8_MAX) {
+				rc = UINT8_MAX;
+			}
+			dev->state->init_res = rc;
+		}
+		dev->state->initialized = true;
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks,
+				   CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+static const struct init_entry *
+	init_msgq_buf[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+static struct k_msgq init_msgq;
+static K_SEM_DEFINE(init_done_sem, 0, CONFIG_DEVICE_INIT_PARALLEL_THREADS);
+
+static void init_worker(void *p1, void *p2, void *p3)
+{
+	const struct init_entry *entry;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&init_msgq, &entry, K_FOREVER);
+		if (entry == NULL) {
+			break;
+		}
+
+		init_entry_run(entry);
+		k_sem_give(&init_done_sem);
+	}
+}
+
+/* Devicetree devices only need the devices they require, other entries
+ * may depend on anything initialized before them
+ */
+static bool init_is_parallel(const struct init_entry *entry)
+{
+	return (entry->dev != NULL) && entry->dev->init_deps_known;
+}
+
+/* Whether the devices an entry requires from its batch have completed.
+ * Devices from earlier batches and levels already have, the ones from
+ * later ones would not be initialized in link order either.
+ */
+static bool init_deps_done(const struct init_entry *first,
+			   const struct init_entry *last,
+			   const struct init_entry *entry)
+{
+	size_t count = 0;
+	const device_handle_t *deps =
+		device_required_handles_get(entry->dev, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct device *req = device_from_handle(deps[i]);
+
+		if ((req == NULL) || req->state->initialized) {
+			continue;
+		}
+
+		for (const struct init_entry *e = first; e < last; e++) {
+			if (e->dev == req) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/* Run a batch of devicetree devices on the worker threads, each one as
+ * soon as its dependencies are done, and return once all are done
+ */
+static void init_run_batch(const struct init_entry *first,
+			   const struct init_entry *last)
+{
+	size_t pending = last - first;
+	size_t running = 0;
+
+	while (pending > 0) {
+		for (const struct init_entry *e = first;
+		     (e < last) && (running < CONFIG_DEVICE_INIT_PARALLEL_THREADS);
+		     e++) {
+			if (!e->dev->state->init_queued &&
+			    init_deps_done(first, last, e)) {
+				e->dev->state->init_queued = true;
+				(void)k_msgq_put(&init_msgq, &e, K_FOREVER);
+				running++;
+			}
+		}
+
+		/* Nothing runs and nothing can start: the entries left
+		 * depend on each other.  Devicetree dependencies should
+		 * have no cycles, initialize these in link order.
+		 */
+		if (running == 0) {
+			__ASSERT(false, "device init dependency cycle");
+
+			for (const struct init_entry *e = first; e < last;
+			     e++) {
+				if (!e->dev->state->init_queued) {
+					e->dev->state->init_queued = true;
+					init_entry_run(e);
+				}
+			}
+			break;
+		}
+
+		(void)k_sem_take(&init_done_sem, K_FOREVER);
+		running--;
+		pending--;
+	}
+}
+
+static void init_run_parallel(const struct init_entry *start,
+			      const struct init_entry *end)
+{
+	const struct init_entry *entry = start;
+	const struct init_entry *stop = NULL;
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_msgq_init(&init_msgq, (char *)init_msgq_buf,
+		    sizeof(init_msgq_buf[0]), ARRAY_SIZE(init_msgq_buf));
+
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_worker, NULL, NULL, NULL, prio, 0,
+				K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "devinit");
+	}
+
+	while (entry < end) {
+		const struct init_entry *last = entry;
+
+		while ((last < end) && init_is_parallel(last)) {
+			last++;
+		}
+
+		if (last - entry > 1) {
+			init_run_batch(entry, last);
+			entry = last;
+		} else {
+			init_entry_run(entry);
+			entry++;
+		}
+	}
+
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		(void)k_msgq_put(&init_msgq, &stop, K_FOREVER);
+	}
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		(void)k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -62,6 +260,10 @@ void z_device_state_init(void)
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, levels running in thread context
+ * initialize devicetree devices concurrently, in an order that only
+ * respects their devicetree dependencies.
+ *
  * @param level init level to run.
  */
 void z_sys_init_run_level(int32_t level)
@@ -79,27 +281,75 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if (level >= _SYS_INIT_LEVEL_POST_KERNEL) {
+		init_run_parallel(levels[level], levels[level+1]);
+		return;
+	}
+#endif
+
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int rc = entry->init(dev);
-
-		if (dev != NULL) {
-			/* Mark device initialized.  If initialization
-			 * failed, record the error condition.
-			 */
-			if (rc != 0) {
-				if (rc < 0) {
-					rc = -rc;
-				}
-				if (rc > UINT8_MAX) {
-					rc = UINT8_MAX;
-				}
-				dev->state->init_res = rc;
+		init_entry_run(entry);
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_REPORT
+void z_device_init_report(void)
+{
+	const struct device *dev;
+	const struct device *tail = NULL;
+
+	printk("device                   start(us)  init(us)  path(us)\n");
+	for (dev = __device_start; dev != __device_end; dev++) {
+		struct device_state *state = dev->state;
+
+		if (!state->initialized) {
+			continue;
+		}
+
+		printk("%-24s %9u %9u %9u%s\n", dev->name,
+		       k_cyc_to_us_floor32(state->init_start),
+		       k_cyc_to_us_floor32(state->init_cycles),
+		       k_cyc_to_us_floor32(state->init_path),
+		       state->init_res != 0U ? " (failed)" : "");
+
+		if ((tail == NULL) ||
+		    (state->init_path > tail->state->init_path)) {
+			tail = dev;
+		}
+	}
+
+	if (tail == NULL) {
+		return;
+	}
+
+	/* Walk the critical path back from its last device */
+	printk("critical path %u us: %s",
+	       k_cyc_to_us_floor32(tail->state->init_path), tail->name);
+	for (dev = tail; dev != NULL; ) {
+		size_t count = 0;
+		const device_handle_t *deps =
+			device_required_handles_get(dev, &count);
+		const struct device *next = NULL;
+
+		for (size_t i = 0; i < count; i++) {
+			const struct device *req = device_from_handle(deps[i]);
+
+			if ((req != NULL) && req->state->initialized &&
+			    ((next == NULL) || (req->state->init_path >
+						next->state->init_path))) {
+				next = req;
 			}
-			dev->state->initialized = true;
 		}
+
+		if (next != NULL) {
+			printk(" <- %s", next->name);
+		}
+		dev = next;
 	}
+	printk("\n");
 }
+#endif
 
 const struct device *z_impl_device_get_binding(const char *name)
 {
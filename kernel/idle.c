@@ -61,6 +61,41 @@ void z_pm_save_idle_exit(int32_t ticks)
 	sys_clock_idle_exit();
 }
 
+#ifdef CONFIG_IDLE_STATS
+/* Called with interrupts locked, both from the idle thread when the
+ * CPU wakes up and when the idle thread is switched out, whichever
+ * comes first.
+ */
+void z_idle_stats_exit(void)
+{
+	struct _cpu *cpu = _current_cpu;
+
+	if (cpu->idling != 0U) {
+		cpu->idle_cycles += k_cycle_get_32() - cpu->idle_start;
+		cpu->idle_wakeups++;
+		cpu->idling = 0U;
+	}
+}
+
+int k_idle_stats_get(int cpu, struct k_idle_stats *stats)
+{
+	if ((stats == NULL) || (cpu < -1) || (cpu >= CONFIG_MP_NUM_CPUS)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct k_idle_stats) {};
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu == -1) || (cpu == i)) {
+			stats->wakeups += _kernel.cpus[i].idle_wakeups;
+			stats->residency_cycles += _kernel.cpus[i].idle_cycles;
+		}
+	}
+
+	return 0;
+}
+#endif
+
 void idle(void *unused1, void *unused2, void *unused3)
 {
 	ARG_UNUSED(unused1);
@@ -92,12 +127,24 @@ void idle(void *unused1, void *unused2, void *unused3)
 		 */
 		(void) arch_irq_lock();
 
+#ifdef CONFIG_IDLE_STATS
+		_current_cpu->idle_start = k_cycle_get_32();
+		_current_cpu->idling = 1U;
+#endif
+
 		if (IS_ENABLED(CONFIG_PM)) {
 			pm_save_idle();
 		} else {
 			k_cpu_idle();
 		}
 
+#ifdef CONFIG_IDLE_STATS
+		unsigned int key = arch_irq_lock();
+
+		z_idle_stats_exit();
+		arch_irq_unlock(key);
+#endif
+
 #if !defined(CONFIG_PREEMPT_ENABLED)
 # if !defined(CONFIG_USE_SWITCH) || defined(CONFIG_SPARC)
 		/* A legacy mess: the idle thread is by definition
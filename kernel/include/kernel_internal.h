@@ -58,6 +58,11 @@ FUNC_NORETURN void z_cstart(void);
 
 void z_device_state_init(void);
 
+#ifdef CONFIG_DEVICE_INIT_REPORT
+/* Print how long each device took to initialize */
+void z_device_init_report(void);
+#endif
+
 extern FUNC_NORETURN void z_thread_entry(k_thread_entry_t entry,
 			  void *p1, void *p2, void *p3);
 
@@ -208,6 +213,30 @@ void z_thread_mark_switched_out(void);
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
 
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+/* Report a quiescent state if the current CPU is outside of RCU read
+ * sections.  Called on every context switch and interrupt exit.
+ */
+static inline void z_rcu_qs(void)
+{
+	struct _cpu *cpu = arch_curr_cpu();
+
+	if (cpu->rcu_nesting == 0U) {
+		atomic_inc(&cpu->rcu_qs);
+	}
+}
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+/* Start timing the wakeup latency of a thread made ready */
+void z_sched_stats_ready(struct k_thread *thread);
+#endif
+
+#ifdef CONFIG_IDLE_STATS
+/* Account the end of the current CPU's idle period, if any */
+void z_idle_stats_exit(void);
+#endif
+
 /* Init hook for page frame management, invoked immediately upon entry of
  * main thread, before POST_KERNEL tasks
  */
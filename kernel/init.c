@@ -208,6 +208,10 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	/* Final init level before app starts */
 	z_sys_init_run_level(_SYS_INIT_LEVEL_APPLICATION);
 
+#ifdef CONFIG_DEVICE_INIT_REPORT
+	z_device_init_report();
+#endif
+
 	z_init_static_threads();
 
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -8,11 +8,219 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <init.h>
+#include <string.h>
+#include <sys/math_extras.h>
+
+#ifdef CONFIG_K_HEAP_CACHE
+
+/* Per-CPU magazine caches.
+ *
+ * Each k_heap carries one magazine per CPU, holding a small stack of
+ * free blocks for each power-of-two size class.  A cacheable request
+ * (natural alignment, at most CACHE_CLASS_SIZE(max class) bytes) pops
+ * a block from the magazine of the current CPU and a cacheable free
+ * pushes it back, both under the magazine's own lock, which is only
+ * ever contended by a flush.  On a miss the block is allocated from
+ * the shared heap rounded up to the full class size, so that it can
+ * serve any request of its class once freed (falling back to the
+ * exact size when the rounded one does not fit).
+ *
+ * A free cannot know which class a block was allocated for, so it
+ * classifies by sys_heap_usable_size(): any block of at least
+ * CACHE_CLASS_SIZE(c) and less than twice that size can serve class
+ * c, whatever path allocated it.
+ *
+ * Lock order is heap lock, then magazine lock.  The fast paths only
+ * take the magazine lock; cache_drain() takes all of them under the
+ * heap lock when an allocation is about to fail.  While a thread is
+ * pended on the heap, cache_waiters diverts frees to the shared heap
+ * so that they wake it up.
+ */
+
+#define CACHE_MIN_SHIFT 4
+#define CACHE_CLASS_SIZE(c) BIT(CACHE_MIN_SHIFT + (c))
+#define CACHE_MAX_SIZE CACHE_CLASS_SIZE(CONFIG_K_HEAP_CACHE_CLASSES - 1)
+
+/* Size class serving a request of @bytes, -1 if not cacheable */
+static int cache_alloc_class(size_t align, size_t bytes)
+{
+	if (align > sizeof(void *) || bytes > CACHE_MAX_SIZE) {
+		return -1;
+	}
+	if (bytes <= CACHE_CLASS_SIZE(0)) {
+		return 0;
+	}
+
+	return 32 - u32_count_leading_zeros(bytes - 1) - CACHE_MIN_SHIFT;
+}
+
+/* Size class a block of @usable bytes can serve, -1 if none */
+static int cache_free_class(size_t usable)
+{
+	if (usable < CACHE_CLASS_SIZE(0) || usable >= 2 * CACHE_MAX_SIZE) {
+		return -1;
+	}
+
+	return 31 - u32_count_leading_zeros(usable) - CACHE_MIN_SHIFT;
+}
+
+static struct z_heap_magazine *magazine_lock(struct k_heap *h,
+					     k_spinlock_key_t *key)
+{
+	/* Being migrated between reading the CPU id and taking the
+	 * lock only costs locality, the lock keeps things consistent.
+	 */
+#ifdef CONFIG_SMP
+	struct z_heap_magazine *m = &h->cache[arch_curr_cpu()->id];
+#else
+	struct z_heap_magazine *m = &h->cache[0];
+#endif
+
+	*key = k_spin_lock(&m->lock);
+	return m;
+}
+
+/* Fast path allocation */
+static void *cache_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+	int cls = cache_alloc_class(align, bytes);
+	struct z_heap_magazine *m;
+	k_spinlock_key_t key;
+	void *ret = NULL;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	m = magazine_lock(h, &key);
+	if (m->count[cls] > 0) {
+		ret = m->blocks[cls][--m->count[cls]];
+		m->stats.hits++;
+	} else {
+		m->stats.misses++;
+	}
+	k_spin_unlock(&m->lock, key);
+
+	return ret;
+}
+
+/* Fast path free, returns false if the block must go to the heap */
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	/* The block belongs to the caller, so its chunk header is stable
+	 * and can be read without the heap lock.
+	 */
+	int cls = cache_free_class(sys_heap_usable_size(&h->heap, mem));
+	struct z_heap_magazine *m;
+	k_spinlock_key_t key;
+	bool cached = false;
+
+	if (cls < 0) {
+		return false;
+	}
+
+	m = magazine_lock(h, &key);
+	if (m->count[cls] < CONFIG_K_HEAP_CACHE_DEPTH &&
+	    atomic_get(&h->cache_waiters) == 0) {
+		m->blocks[cls][m->count[cls]++] = mem;
+		m->stats.hits++;
+		cached = true;
+	} else {
+		m->stats.misses++;
+	}
+	k_spin_unlock(&m->lock, key);
+
+	return cached;
+}
+
+/* Returns all cached blocks to the shared heap, with h->lock held */
+static bool cache_drain(struct k_heap *h)
+{
+	bool drained = false;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_magazine *m = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&m->lock);
+		bool flushed = false;
+
+		for (int cls = 0; cls < CONFIG_K_HEAP_CACHE_CLASSES; cls++) {
+			while (m->count[cls] > 0) {
+				sys_heap_free(&h->heap,
+					      m->blocks[cls][--m->count[cls]]);
+				flushed = true;
+			}
+		}
+		if (flushed) {
+			m->stats.flushes++;
+			drained = true;
+		}
+		k_spin_unlock(&m->lock, key);
+	}
+
+	return drained;
+}
+
+/* Slow path allocation from the shared heap, with h->lock held.
+ * Cacheable requests are rounded up to their class size if that
+ * fits; the magazines are only drained once the heap is exhausted.
+ */
+static void *shared_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+	int cls = cache_alloc_class(align, bytes);
+	void *ret = NULL;
+
+	if (cls >= 0) {
+		ret = sys_heap_aligned_alloc(&h->heap, align,
+					     CACHE_CLASS_SIZE(cls));
+	}
+	if (ret == NULL) {
+		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+	}
+	if (ret == NULL && cache_drain(h)) {
+		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+	}
+
+	return ret;
+}
+
+void k_heap_cache_flush(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	if (cache_drain(h) && IS_ENABLED(CONFIG_MULTITHREADING) &&
+	    z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+}
+
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_magazine *m = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&m->lock);
+
+		stats->hits += m->stats.hits;
+		stats->misses += m->stats.misses;
+		stats->flushes += m->stats.flushes;
+		k_spin_unlock(&m->lock, key);
+	}
+}
+
+#endif /* CONFIG_K_HEAP_CACHE */
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_K_HEAP_CACHE
+	memset(h->cache, 0, sizeof(h->cache));
+	atomic_set(&h->cache_waiters, 0);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -31,9 +239,21 @@ SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
-	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	int64_t now, end;
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_K_HEAP_CACHE
+	ret = cache_alloc(h, align, bytes);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+#endif
+
+	end = sys_clock_timeout_end_calc(timeout);
+	key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
 
@@ -42,7 +262,11 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
+#ifdef CONFIG_K_HEAP_CACHE
+		ret = shared_alloc(h, align, bytes);
+#else
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+#endif
 
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
@@ -54,6 +278,13 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			blocked_alloc = true;
 
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_heap, aligned_alloc, h, timeout);
+#ifdef CONFIG_K_HEAP_CACHE
+			/* From now on frees must reach the heap to wake us
+			 * up; drain what was cached before that once more.
+			 */
+			atomic_inc(&h->cache_waiters);
+			continue;
+#endif
 		} else {
 			/**
 			 * @todo	Trace attempt to avoid empty trace segments
@@ -65,6 +296,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_K_HEAP_CACHE
+	if (blocked_alloc) {
+		atomic_dec(&h->cache_waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -84,7 +321,16 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_K_HEAP_CACHE
+	if (mem != NULL && cache_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
 
@@ -72,6 +72,217 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+/* Per-CPU caches.
+ *
+ * Each slab carries one list of free blocks per CPU.  Allocations pop
+ * from, and frees push to, the current CPU's list under its own lock.
+ * An empty cache takes CACHE_BATCH blocks from the shared free list at
+ * once and a full one gives CACHE_BATCH back, so the slab lock is only
+ * taken once per batch.
+ *
+ * Lock order is slab lock, then cache lock.  When the shared free list
+ * runs dry, cache_drain() returns all cached blocks to it before an
+ * allocation fails or pends.  While a thread is pended on the slab,
+ * cache_waiters diverts frees to the shared path so that they wake it.
+ *
+ * num_used and max_used count the blocks held by users, cached ones
+ * are free, and are atomics since the fast paths update them without
+ * the slab lock.
+ */
+
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_DEPTH / 2)
+
+static struct z_mem_slab_cache *cache_lock(struct k_mem_slab *slab,
+					   k_spinlock_key_t *key)
+{
+	/* Being migrated between reading the CPU id and taking the
+	 * lock only costs locality, the lock keeps things consistent.
+	 */
+#ifdef CONFIG_SMP
+	struct z_mem_slab_cache *c = &slab->cache[arch_curr_cpu()->id];
+#else
+	struct z_mem_slab_cache *c = &slab->cache[0];
+#endif
+
+	*key = k_spin_lock(&c->lock);
+	return c;
+}
+
+static void used_inc(struct k_mem_slab *slab)
+{
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max = atomic_get(&slab->max_used);
+
+	while ((used > max) && !atomic_cas(&slab->max_used, max, used)) {
+		max = atomic_get(&slab->max_used);
+	}
+#else
+	ARG_UNUSED(used);
+#endif
+}
+
+static void used_dec(struct k_mem_slab *slab)
+{
+	(void)atomic_dec(&slab->num_used);
+}
+
+/* Moves up to n blocks from one free list to another */
+static uint32_t move_blocks(char **from, char **to, uint32_t n)
+{
+	uint32_t moved = 0U;
+
+	while ((moved < n) && (*from != NULL)) {
+		char *block = *from;
+
+		*from = *(char **)block;
+		*(char **)block = *to;
+		*to = block;
+		moved++;
+	}
+
+	return moved;
+}
+
+/* Fast path allocation, refilling the cache from the shared free list
+ * when it is empty.  Returns NULL if both are.
+ */
+static char *cache_alloc(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache *c;
+	k_spinlock_key_t key, ckey;
+	char *block = NULL;
+
+	c = cache_lock(slab, &ckey);
+	if (c->free_list != NULL) {
+		block = c->free_list;
+		c->free_list = *(char **)block;
+		c->count--;
+	}
+	k_spin_unlock(&c->lock, ckey);
+
+	if (block == NULL) {
+		/* Interrupts stay locked from here, so the cache is
+		 * that of the CPU we end up on
+		 */
+		key = k_spin_lock(&slab->lock);
+		if (slab->free_list != NULL) {
+			block = slab->free_list;
+			slab->free_list = *(char **)block;
+
+			c = cache_lock(slab, &ckey);
+			c->count += move_blocks(&slab->free_list,
+						&c->free_list,
+						CACHE_BATCH - 1);
+			k_spin_unlock(&c->lock, ckey);
+		}
+		k_spin_unlock(&slab->lock, key);
+	}
+
+	if (block != NULL) {
+		used_inc(slab);
+	}
+
+	return block;
+}
+
+/* Fast path free, returns false if the block must go to the shared
+ * path because a thread waits for it
+ */
+static bool cache_free(struct k_mem_slab *slab, char *block)
+{
+	struct z_mem_slab_cache *c;
+	k_spinlock_key_t key, ckey;
+
+	c = cache_lock(slab, &ckey);
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		k_spin_unlock(&c->lock, ckey);
+		return false;
+	}
+
+	if (c->count < CONFIG_MEM_SLAB_CPU_CACHE_DEPTH) {
+		*(char **)block = c->free_list;
+		c->free_list = block;
+		c->count++;
+		k_spin_unlock(&c->lock, ckey);
+		used_dec(slab);
+		return true;
+	}
+	k_spin_unlock(&c->lock, ckey);
+
+	/* Full: give a batch back to the shared list, in lock order */
+	key = k_spin_lock(&slab->lock);
+	c = cache_lock(slab, &ckey);
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		k_spin_unlock(&c->lock, ckey);
+		k_spin_unlock(&slab->lock, key);
+		return false;
+	}
+
+	c->count -= move_blocks(&c->free_list, &slab->free_list,
+				MIN(c->count, CACHE_BATCH));
+	*(char **)block = c->free_list;
+	c->free_list = block;
+	c->count++;
+	k_spin_unlock(&c->lock, ckey);
+	k_spin_unlock(&slab->lock, key);
+	used_dec(slab);
+
+	return true;
+}
+
+/* Returns all cached blocks to the shared free list, with slab->lock
+ * held.  Returns true if there were any.
+ */
+static bool cache_drain(struct k_mem_slab *slab)
+{
+	bool drained = false;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_cache *c = &slab->cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&c->lock);
+
+		if (c->count > 0U) {
+			(void)move_blocks(&c->free_list, &slab->free_list,
+					  c->count);
+			c->count = 0U;
+			drained = true;
+		}
+		k_spin_unlock(&c->lock, ckey);
+	}
+
+	return drained;
+}
+
+static void cache_init(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		slab->cache[i] = (struct z_mem_slab_cache) {};
+	}
+	atomic_set(&slab->cache_waiters, 0);
+}
+
+#else
+
+static inline void used_inc(struct k_mem_slab *slab)
+{
+	slab->num_used++;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->max_used = MAX(slab->num_used, slab->max_used);
+#endif
+}
+
+static inline void used_dec(struct k_mem_slab *slab)
+{
+	slab->num_used--;
+}
+
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -80,11 +291,19 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->num_blocks = num_blocks;
 	slab->block_size = block_size;
 	slab->buffer = buffer;
-	slab->num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_set(&slab->num_used, 0);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_set(&slab->max_used, 0);
+#endif
+	cache_init(slab);
+#else
+	slab->num_used = 0U;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->max_used = 0U;
+#endif
 #endif
 
 	rc = create_free_list(slab);
@@ -102,19 +321,47 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	*mem = cache_alloc(slab);
+	if (*mem != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout,
+					       0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool waiter = false;
+
+	if (slab->free_list == NULL) {
+		/* Have frees come through here from now on if we may
+		 * have to wait, then get back whatever the caches hold
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+		    IS_ENABLED(CONFIG_MULTITHREADING)) {
+			atomic_inc(&slab->cache_waiters);
+			waiter = true;
+		}
+		(void)cache_drain(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
-
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
+		used_inc(slab);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (waiter) {
+			atomic_dec(&slab->cache_waiters);
+		}
 #endif
 
 		result = 0;
@@ -132,6 +379,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		atomic_dec(&slab->cache_waiters);
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
@@ -146,9 +397,19 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -163,7 +424,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	}
 	**(char ***) mem = slab->free_list;
 	slab->free_list = *(char **) mem;
-	slab->num_used--;
+	used_dec(slab);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
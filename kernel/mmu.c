@@ -282,6 +282,43 @@ static void virt_region_free(void *vaddr, size_t size)
 	(void)sys_bitarray_free(&virt_region_bitmap, num_bits, offset);
 }
 
+#if CONFIG_MMU_LARGE_PAGE_SIZE > 0
+/* Get a virtual region at the same offset within a large page as phys, so
+ * that the arch code may map the aligned blocks of the region with large
+ * pages.
+ */
+static void *virt_region_alloc_aligned(uintptr_t phys, size_t size)
+{
+	size_t slack = CONFIG_MMU_LARGE_PAGE_SIZE - CONFIG_MMU_PAGE_SIZE;
+	uint8_t *start, *dest;
+	size_t offset;
+
+	if (size < CONFIG_MMU_LARGE_PAGE_SIZE) {
+		return virt_region_alloc(size);
+	}
+
+	start = virt_region_alloc(size + slack);
+	if (start == NULL) {
+		/* No room to line it up, settle for small pages */
+		return virt_region_alloc(size);
+	}
+
+	offset = (phys - POINTER_TO_UINT(start)) &
+		 (CONFIG_MMU_LARGE_PAGE_SIZE - 1);
+	dest = start + offset;
+
+	/* Give back what's left before and after the region */
+	if (offset > 0) {
+		virt_region_free(start, offset);
+	}
+	if (offset < slack) {
+		virt_region_free(dest + size, slack - offset);
+	}
+
+	return dest;
+}
+#endif /* CONFIG_MMU_LARGE_PAGE_SIZE > 0 */
+
 /*
  * Free page frames management
  *
@@ -651,7 +688,11 @@ void z_phys_map(uint8_t **virt_ptr, uintptr_t phys, size_t size, uint32_t flags)
 
 	key = k_spin_lock(&z_mm_lock);
 	/* Obtain an appropriately sized chunk of virtual memory */
+#if CONFIG_MMU_LARGE_PAGE_SIZE > 0
+	dest_addr = virt_region_alloc_aligned(aligned_phys, aligned_size);
+#else
 	dest_addr = virt_region_alloc(aligned_size);
+#endif
 	if (!dest_addr) {
 		goto fail;
 	}
@@ -1145,6 +1186,18 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_read_ahead_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.read_ahead.pages++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.read_ahead.pages++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1179,14 +1232,130 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+/*
+ * Bring the data page at addr in from page_in_location in the backing store,
+ * evicting another page if no page frame is free. Called with interrupts
+ * locked, which with CONFIG_DEMAND_PAGING_ALLOW_IRQ are unlocked during the
+ * backing store transfers; *key_ptr is updated with the new lock key.
+ */
+static struct z_page_frame *page_in_locked(void *addr,
+					   uintptr_t page_in_location,
+					   struct k_thread *faulting_thread,
+					   int *key_ptr)
 {
 	struct z_page_frame *pf;
-	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	uintptr_t page_out_location;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx", pf->addr,
+			z_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+	(void)ret;
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key_ptr);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key_ptr = irq_lock();
+	pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	pf->flags |= Z_PAGE_FRAME_MAPPED;
+	pf->addr = addr;
+	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+
+	return pf;
+}
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+/*
+ * Whether a page frame can be had for reading ahead, either free or
+ * evictable. Once the pages pinned by reading ahead are all that is left
+ * to evict, the eviction algorithm would have nothing to select.
+ */
+static bool read_ahead_frame_available(void)
+{
+	struct z_page_frame *pf;
+	uintptr_t phys;
+
+	if (z_free_page_count > 0) {
+		return true;
+	}
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (z_page_frame_is_evictable(pf)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Page in the data pages following the one which just faulted into pf,
+ * stopping at the first one which isn't paged out, or when no page frame
+ * is left that isn't pinned. The pages brought in are pinned until we are
+ * done, so that reading ahead can't evict the faulting page or the pages
+ * read ahead of it.
+ */
+static void read_ahead_locked(void *addr, struct z_page_frame *pf,
+			      struct k_thread *faulting_thread, int *key_ptr)
+{
+	struct z_page_frame *pinned[CONFIG_DEMAND_PAGING_READ_AHEAD + 1];
+	uintptr_t location;
+	uint8_t *pos = addr;
+	int count = 0;
+
+	pf->flags |= Z_PAGE_FRAME_PINNED;
+	pinned[count++] = pf;
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_READ_AHEAD; i++) {
+		pos += CONFIG_MMU_PAGE_SIZE;
+		if (pos >= Z_VIRT_RAM_END ||
+		    arch_page_location_get(pos, &location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT ||
+		    !read_ahead_frame_available()) {
+			break;
+		}
+
+		pf = page_in_locked(pos, location, faulting_thread, key_ptr);
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+		pinned[count++] = pf;
+		paging_stats_read_ahead_inc(faulting_thread);
+	}
+
+	while (count > 0) {
+		pinned[--count]->flags &= ~Z_PAGE_FRAME_PINNED;
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
+static bool do_page_fault(void *addr, bool pin, bool read_ahead)
+{
+	struct z_page_frame *pf;
+	int key;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
@@ -1255,42 +1424,17 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx", pf->addr,
-			z_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	irq_unlock(key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = irq_lock();
-	pf->flags &= ~Z_PAGE_FRAME_BUSY;
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	pf = page_in_locked(addr, page_in_location, faulting_thread, &key);
 	if (pin) {
 		pf->flags |= Z_PAGE_FRAME_PINNED;
 	}
-	pf->flags |= Z_PAGE_FRAME_MAPPED;
-	pf->addr = addr;
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	if (read_ahead) {
+		read_ahead_locked(addr, pf, faulting_thread, &key);
+	}
+#else
+	ARG_UNUSED(read_ahead);
+#endif
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -1304,7 +1448,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1321,7 +1465,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1336,7 +1480,7 @@ void k_mem_pin(void *addr, size_t size)
 
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	return do_page_fault(addr, false, true);
 }
 
 static void do_mem_unpin(void *addr)
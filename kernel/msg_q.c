@@ -281,6 +281,205 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+/* Copy @a count messages into the ring buffer, at most two memcpy()s */
+static void msgq_ring_write(struct k_msgq *msgq, const char *src,
+			    uint32_t count)
+{
+	size_t len = count * msgq->msg_size;
+	size_t room = msgq->buffer_end - msgq->write_ptr;
+
+	if (len >= room) {
+		(void)memcpy(msgq->write_ptr, src, room);
+		src += room;
+		len -= room;
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	(void)memcpy(msgq->write_ptr, src, len);
+	msgq->write_ptr += len;
+	msgq->used_msgs += count;
+}
+
+/* Copy @a count messages out of the ring buffer, at most two memcpy()s */
+static void msgq_ring_read(struct k_msgq *msgq, char *dst, uint32_t count)
+{
+	size_t len = count * msgq->msg_size;
+	size_t room = msgq->buffer_end - msgq->read_ptr;
+
+	if (len >= room) {
+		(void)memcpy(dst, msgq->read_ptr, room);
+		dst += room;
+		len -= room;
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	(void)memcpy(dst, msgq->read_ptr, len);
+	msgq->read_ptr += len;
+	msgq->used_msgs -= count;
+}
+
+int z_impl_k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			    uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t sent = 0U;
+	uint32_t count;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	if (msgq->used_msgs < msgq->max_msgs) {
+		/* A non-full queue only has readers waiting, and only when
+		 * it is empty: serve them first, straight from @a data.
+		 */
+		while (sent < num_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			(void)memcpy(pending_thread->base.swap_data, src,
+				     msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+			src += msgq->msg_size;
+			sent++;
+		}
+
+		count = MIN(num_msgs - sent, msgq->max_msgs - msgq->used_msgs);
+		if (count > 0U) {
+			msgq_ring_write(msgq, src, count);
+			sent += count;
+#ifdef CONFIG_POLL
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+		}
+	}
+
+	if (sent > 0U || num_msgs == 0U) {
+		result = (int)sent;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* wait until a reader takes the first message */
+		_current->base.swap_data = (void *) data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_batch(struct k_msgq *msgq,
+					  const void *data, uint32_t num_msgs,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_batch(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_batch_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			    uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t received = 0U;
+	uint32_t count;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	while (received < num_msgs && msgq->used_msgs > 0U) {
+		/* take as many queued messages as fit */
+		count = MIN(num_msgs - received, msgq->used_msgs);
+		msgq_ring_read(msgq, dst, count);
+		dst += count * msgq->msg_size;
+		received += count;
+
+		/* refill the freed slots from threads waiting to write,
+		 * keeping their messages behind the ones already queued
+		 */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			msgq_ring_write(msgq, pending_thread->base.swap_data, 1U);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+		}
+	}
+
+	if (received > 0U || num_msgs == 0U) {
+		result = (int)received;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* wait for the first message */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_batch(struct k_msgq *msgq, void *data,
+					  uint32_t num_msgs,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_batch(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_batch_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
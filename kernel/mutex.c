@@ -92,6 +92,64 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* True if @a owner is running on some CPU right now, which can't be
+ * ours as we are running.  The owner is only compared with the current
+ * thread of each CPU, never dereferenced: read without the lock, it may
+ * be a thread which has exited since.  This is only a hint of whether
+ * the mutex will be released soon.
+ */
+static bool owner_is_running(struct k_thread *owner)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (*(struct k_thread *volatile *)&_kernel.cpus[i].current ==
+		    owner) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* True while the mutex is still held by the thread found owning it
+ * when spinning started, and that thread keeps running
+ */
+static bool owner_keeps_running(struct k_mutex *mutex,
+				struct k_thread *owner)
+{
+	return (*(volatile uint32_t *)&mutex->lock_count != 0U) &&
+		(*(struct k_thread *volatile *)&mutex->owner == owner) &&
+		owner_is_running(owner);
+}
+
+/* Called with the mutex lock held and the mutex owned by another
+ * thread.  Busy-waits with the lock released, for at most @a limit
+ * cycles and only while the owner keeps running, for the mutex to be
+ * released.  Returns with the lock held again, the mutex being then
+ * either free or still owned by someone else.
+ */
+static k_spinlock_key_t mutex_spin(struct k_mutex *mutex,
+				   k_spinlock_key_t key, uint32_t limit)
+{
+	struct k_thread *owner = mutex->owner;
+	uint32_t start = k_cycle_get_32();
+
+	while (owner_keeps_running(mutex, owner) &&
+	       ((k_cycle_get_32() - start) < limit)) {
+		k_spin_unlock(&lock, key);
+
+		while (owner_keeps_running(mutex, owner) &&
+		       ((k_cycle_get_32() - start) < limit)) {
+			arch_nop();
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	return key;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -104,6 +162,42 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* Time spent spinning is taken off the timeout */
+		int64_t end = (int64_t)sys_clock_timeout_end_calc(timeout);
+		uint32_t limit =
+			k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			limit = MIN(limit, k_ticks_to_cyc_floor64(
+					    MAX(remaining, 0)));
+		}
+
+		key = mutex_spin(mutex, key, limit);
+
+		if ((mutex->lock_count != 0U) &&
+		    (mutex->owner != _current) &&
+		    !K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				k_spin_unlock(&lock, key);
+
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock,
+							       mutex, timeout,
+							       -EAGAIN);
+
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(remaining);
+		}
+	}
+#endif
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -92,6 +92,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -825,3 +827,226 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+/**
+ * @brief Wait for the next transfer on the other side of a pipe
+ *
+ * Pends on @a wait_q with an empty request. A zero byte request is always
+ * satisfied by the next transfer, which readies the thread without copying
+ * anything, so claims block exactly as long as k_pipe_put()/k_pipe_get()
+ * would, without a buffer of their own.
+ */
+static void pipe_claim_wait(struct k_pipe *pipe, k_spinlock_key_t key,
+			    _wait_q_t *wait_q, k_timeout_t timeout)
+{
+	unsigned char dummy;
+	struct k_pipe_desc pipe_desc;
+
+	pipe_desc.buffer        = &dummy;
+	pipe_desc.bytes_to_xfer = 0;
+
+	_current->base.swap_data = &pipe_desc;
+	(void)z_pend_curr(&pipe->lock, key, wait_q, timeout);
+}
+
+/**
+ * @brief Wait for a contiguous region of a pipe's buffer
+ *
+ * @a avail_fn returns the size of the contiguous region (free space or
+ * data) available at the current index; called with the lock held.
+ *
+ * @return Size of the region or a negative error, with the lock held
+ */
+static int pipe_claim(struct k_pipe *pipe, k_spinlock_key_t *key,
+		      size_t (*avail_fn)(struct k_pipe *pipe),
+		      _wait_q_t *wait_q, k_timeout_t timeout)
+{
+	int64_t end = (int64_t)sys_clock_timeout_end_calc(timeout);
+	k_timeout_t wait = timeout;
+	size_t avail;
+
+	while ((avail = avail_fn(pipe)) == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EIO;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				return -EAGAIN;
+			}
+			wait = K_TICKS(remaining);
+		}
+
+		pipe_claim_wait(pipe, *key, wait_q, wait);
+		*key = k_spin_lock(&pipe->lock);
+	}
+
+	return (int)MIN(avail, (size_t)INT_MAX);
+}
+
+static size_t pipe_put_avail(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+static size_t pipe_get_avail(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+/**
+ * @brief Serve threads pended on @a wait_q in order
+ *
+ * @a xfer_fn moves as much of the thread's request as possible between
+ * its buffer and the pipe's buffer. Threads whose request completes are
+ * readied; the first one that cannot complete stays pended, keeping what
+ * it got so far, as with k_pipe_put()/k_pipe_get().
+ *
+ * @return true if a thread was readied
+ */
+static bool pipe_serve_waiters(struct k_pipe *pipe, _wait_q_t *wait_q,
+			       size_t (*xfer_fn)(struct k_pipe *pipe,
+						 unsigned char *buf,
+						 size_t size))
+{
+	struct k_thread *thread;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	bool readied = false;
+
+	while ((thread = z_waitq_head(wait_q)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = xfer_fn(pipe, desc->buffer, desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		pipe_thread_ready(thread);
+		readied = true;
+	}
+
+	return readied;
+}
+
+static size_t pipe_buffer_put_xfer(struct k_pipe *pipe, unsigned char *buf,
+				   size_t size)
+{
+	return pipe_buffer_put(pipe, buf, size);
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int ret;
+
+	CHECKIF((pipe->buffer == NULL) || (pipe->size == 0U) || (size == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	ret = pipe_claim(pipe, &key, pipe_put_avail, &pipe->wait_q.writers,
+			 timeout);
+	if (ret > 0) {
+		ret = (int)MIN((size_t)ret, size);
+		*data = pipe->buffer + pipe->write_index;
+		pipe->put_claimed = ret;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/* Readers only pend on an empty pipe: hand them the new data */
+	if (pipe_serve_waiters(pipe, &pipe->wait_q.readers, pipe_buffer_get)) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int ret;
+
+	CHECKIF((pipe->buffer == NULL) || (pipe->size == 0U) || (size == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	ret = pipe_claim(pipe, &key, pipe_get_avail, &pipe->wait_q.readers,
+			 timeout);
+	if (ret > 0) {
+		ret = (int)MIN((size_t)ret, size);
+		*data = pipe->buffer + pipe->read_index;
+		pipe->get_claimed = ret;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/* Writers only pend on a full pipe: refill the freed space */
+	if (pipe_serve_waiters(pipe, &pipe->wait_q.writers,
+			       pipe_buffer_put_xfer)) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
@@ -125,6 +125,28 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 	sys_dlist_append(events, &event->_node);
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/* Queues only take the locked, poll-signalling append path while they
+ * see a waiter, so claim one before looking at the queue state.
+ */
+static inline void queue_poller_get(struct k_poll_event *event)
+{
+	if (event->type == K_POLL_TYPE_DATA_AVAILABLE) {
+		atomic_inc(&event->queue->waiters);
+	}
+}
+
+static inline void queue_poller_put(struct k_poll_event *event)
+{
+	if (event->type == K_POLL_TYPE_DATA_AVAILABLE) {
+		atomic_dec(&event->queue->waiters);
+	}
+}
+#else
+#define queue_poller_get(event) do { } while (false)
+#define queue_poller_put(event) do { } while (false)
+#endif
+
 /* must be called with interrupts locked */
 static inline void register_event(struct k_poll_event *event,
 				 struct z_poller *poller)
@@ -191,6 +213,8 @@ static inline void clear_event_registration(struct k_poll_event *event)
 	if (remove_event && sys_dnode_is_linked(&event->_node)) {
 		sys_dlist_remove(&event->_node);
 	}
+
+	queue_poller_put(event);
 }
 
 /* must be called with interrupts locked */
@@ -223,14 +247,16 @@ static inline int register_events(struct k_poll_event *events,
 		uint32_t state;
 
 		key = k_spin_lock(&lock);
+		queue_poller_get(&events[ii]);
 		if (is_condition_met(&events[ii], &state)) {
 			set_event_ready(&events[ii], state);
 			poller->is_polling = false;
+			queue_poller_put(&events[ii]);
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
 			events_registered += 1;
 		} else {
-			;
+			queue_poller_put(&events[ii]);
 		}
 		k_spin_unlock(&lock, key);
 	}
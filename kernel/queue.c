@@ -63,6 +63,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	atomic_ptr_clear(&queue->inbox);
+	atomic_clear(&queue->waiters);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_queue, queue);
 
@@ -91,6 +95,92 @@ static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+
+/* Lock-free append.
+ *
+ * While nobody waits on the queue, k_queue_append() pushes onto
+ * queue->inbox, a LIFO stack, with a compare-and-swap.  Everything
+ * that looks at data_q does so under the queue lock and first moves
+ * the inbox over to the tail of data_q in FIFO order (inbox_drain()),
+ * so the inbox only ever holds items newer than those in data_q and
+ * ordering is preserved.
+ *
+ * A consumer about to pend (or a poller registering) increments
+ * queue->waiters and then checks the inbox again; a producer pushes
+ * and then checks waiters again.  One of the two is therefore
+ * guaranteed to see the other: either the consumer finds the item,
+ * or the producer takes the lock and hands it over (inbox_kick()).
+ * With waiters non-zero, appends take the locked path.
+ */
+
+static void inbox_drain(struct k_queue *queue)
+{
+	sys_sfnode_t *node = atomic_ptr_set(&queue->inbox, NULL);
+	sys_sfnode_t *head = NULL, *tail = node;
+
+	if (node == NULL) {
+		return;
+	}
+
+	/* Reverse into FIFO order, links carry no flags */
+	while (node != NULL) {
+		sys_sfnode_t *next = (sys_sfnode_t *)node->next_and_flags;
+
+		node->next_and_flags = (unative_t)head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+static void inbox_sync(struct k_queue *queue)
+{
+	if (atomic_ptr_get(&queue->inbox) != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		inbox_drain(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+static void inbox_kick(struct k_queue *queue);
+
+static bool inbox_push(struct k_queue *queue, sys_sfnode_t *node)
+{
+	void *head;
+
+	if (atomic_get(&queue->waiters) != 0) {
+		return false;
+	}
+
+	do {
+		head = atomic_ptr_get(&queue->inbox);
+		node->next_and_flags = (unative_t)head;
+	} while (!atomic_ptr_cas(&queue->inbox, head, node));
+
+	if (atomic_get(&queue->waiters) != 0) {
+		inbox_kick(queue);
+	}
+
+	return true;
+}
+
+#else
+
+static inline void inbox_drain(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline void inbox_sync(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+#endif /* CONFIG_QUEUE_LOCKFREE_APPEND */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, cancel_wait, queue);
@@ -125,6 +215,8 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
 
+	inbox_drain(queue);
+
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
@@ -181,10 +273,42 @@ void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, insert, queue);
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/* Hands pushed items to the consumers that showed up meanwhile */
+static void inbox_kick(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	struct k_thread *thread;
+
+	inbox_drain(queue);
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+		prepare_thread_to_run(thread, z_queue_node_peek(
+				sys_sflist_get_not_empty(&queue->data_q), true));
+	}
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+	}
+	z_reschedule(&queue->lock, key);
+}
+#endif
+
 void k_queue_append(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, append, queue);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (inbox_push(queue, data)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, append, queue);
+		return;
+	}
+#endif
+
 	(void)queue_insert(queue, NULL, data, false, true);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, append, queue);
@@ -255,6 +379,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+	inbox_drain(queue);
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -318,6 +444,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
+	inbox_drain(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -340,8 +468,30 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* Divert producers to the locked path, then catch anything
+	 * pushed before they noticed.
+	 */
+	atomic_inc(&queue->waiters);
+	inbox_drain(queue);
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		atomic_dec(&queue->waiters);
+		data = z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q),
+					 true);
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
+
+		return data;
+	}
+#endif
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	atomic_dec(&queue->waiters);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout,
 		(ret != 0) ? NULL : _current->base.swap_data);
 
@@ -352,6 +502,8 @@ bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
 
+	inbox_sync(queue);
+
 	bool ret = sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, remove, queue, ret);
@@ -365,6 +517,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 	sys_sfnode_t *test;
 
+	inbox_sync(queue);
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, unique_append, queue, false);
@@ -382,6 +536,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	inbox_sync(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_head, queue, ret);
@@ -391,6 +547,8 @@ void *z_impl_k_queue_peek_head(struct k_queue *queue)
 
 void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	inbox_sync(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_tail, queue, ret);
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <ksched.h>
+#include <kernel_internal.h>
+#include <sys/rcu.h>
+
+/* Polls of the other CPUs, a microsecond apart, before sleeping a tick
+ * between polls instead
+ */
+#define RCU_SPIN_POLLS 100
+
+void k_rcu_read_lock(void)
+{
+	if (!arch_is_in_isr()) {
+		z_sched_lock();
+	}
+
+#ifdef CONFIG_SMP
+	/* Can't migrate with preemption disabled, nor in an ISR */
+	arch_curr_cpu()->rcu_nesting++;
+#endif
+}
+
+void k_rcu_read_unlock(void)
+{
+#ifdef CONFIG_SMP
+	__ASSERT(arch_curr_cpu()->rcu_nesting != 0U, "not in a read section");
+	arch_curr_cpu()->rcu_nesting--;
+#endif
+
+	if (arch_is_in_isr()) {
+		return;
+	}
+
+	/* sched_locked counts down from zero.  Only leaving the outermost
+	 * lock has to pick up threads readied meanwhile.
+	 */
+	if (_current->base.sched_locked == (uint8_t)-1) {
+		k_sched_unlock();
+	} else {
+		z_sched_unlock_no_reschedule();
+	}
+}
+
+#ifdef CONFIG_SMP
+/* Clear from @pending the CPUs that went through a quiescent state
+ * since @snap was taken
+ */
+static uint32_t rcu_pending(const atomic_val_t *snap, uint32_t pending)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((pending & BIT(i)) &&
+		    (atomic_get(&_kernel.cpus[i].rcu_qs) != snap[i])) {
+			pending &= ~BIT(i);
+		}
+	}
+
+	return pending;
+}
+#endif
+
+void k_rcu_synchronize(void)
+{
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(_current->base.sched_locked == 0U,
+		 "called with preemption disabled");
+
+#ifdef CONFIG_SMP
+	atomic_val_t snap[CONFIG_MP_NUM_CPUS];
+	uint32_t pending = BIT_MASK(CONFIG_MP_NUM_CPUS);
+	unsigned int key;
+
+	/* The caller's own CPU is outside of any read section */
+	key = arch_irq_lock();
+	pending &= ~BIT(_current_cpu->id);
+	arch_irq_unlock(key);
+
+	/* atomic_get() orders the snapshot after the caller's update */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		snap[i] = atomic_get(&_kernel.cpus[i].rcu_qs);
+	}
+
+	for (int polls = 0; ; polls++) {
+		pending = rcu_pending(snap, pending);
+		if (pending == 0U) {
+			break;
+		}
+
+		/* Idle CPUs or ones running a single thread take no
+		 * interrupt on their own: kick them, so they report a
+		 * quiescent state on the way out of the IPI
+		 */
+		if ((polls % RCU_SPIN_POLLS) == 0) {
+			arch_sched_ipi();
+		}
+
+		if (polls < RCU_SPIN_POLLS) {
+			k_busy_wait(1);
+		} else {
+			k_sleep(K_TICKS(1));
+		}
+	}
+#endif
+
+	compiler_barrier();
+}
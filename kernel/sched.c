@@ -16,6 +16,7 @@
 #include <kernel_internal.h>
 #include <logging/log.h>
 #include <sys/atomic.h>
+#include <sys/math_extras.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
 #if defined(CONFIG_SCHED_DUMB)
@@ -170,6 +171,109 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+/* Run queue holding @thread.  With CONFIG_SCHED_CPU_RUNQ every CPU
+ * has its own, and base.runq_cpu records which one a queued thread
+ * is on.
+ */
+static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+#else
+	ARG_UNUSED(thread);
+
+	return &_kernel.ready_q.runq;
+#endif
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* CPUs whose run queue is not empty, so that picking the next thread
+ * only looks at remote queues that have something to steal.
+ *
+ * Like the queues themselves this is protected by sched_spinlock.
+ * That lock is kept global on purpose: besides the run queues it
+ * serialises every thread state transition (pend, ready, suspend,
+ * abort, priority changes) against next_up(), and per-queue locks
+ * would have to be taken in addition to it, not instead.
+ */
+static uint32_t runq_busy;
+
+BUILD_ASSERT(CONFIG_MP_NUM_CPUS <= 32, "runq_busy is a 32 bit mask");
+
+/* Threads are queued on the CPU they last ran on, to keep them on a
+ * warm cache, unless their CPU mask forbids it.
+ */
+static ALWAYS_INLINE int runq_cpu_select(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t mask = thread->base.cpu_mask;
+
+	if ((mask & BIT(cpu)) == 0U && mask != 0U) {
+		cpu = u32_count_trailing_zeros(mask);
+	}
+#endif
+	return cpu;
+}
+#endif
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	int cpu = runq_cpu_select(thread);
+
+	thread->base.runq_cpu = cpu;
+	_kernel.cpus[cpu].ready_q.count++;
+	runq_busy |= BIT(cpu);
+#endif
+	_priq_run_add(thread_runq(thread), thread);
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	if (--_kernel.cpus[thread->base.runq_cpu].ready_q.count == 0U) {
+		runq_busy &= ~BIT(thread->base.runq_cpu);
+	}
+#endif
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	int cpu = _current_cpu->id;
+	struct k_thread *thread, *t;
+
+	thread = _priq_run_best(&_kernel.cpus[cpu].ready_q.runq);
+
+	/* Take work queued on another CPU only when it outranks our
+	 * own (ties stay local).  An idle CPU thereby steals whatever
+	 * is runnable, while busy ones still honour the global
+	 * priority order.  With CONFIG_SCHED_CPU_MASK the _best
+	 * function only returns threads allowed on this CPU.
+	 */
+	for (int i = 1; i < CONFIG_MP_NUM_CPUS; i++) {
+		int c = (cpu + i) % CONFIG_MP_NUM_CPUS;
+
+		if ((runq_busy & BIT(c)) == 0U) {
+			continue;
+		}
+
+		t = _priq_run_best(&_kernel.cpus[c].ready_q.runq);
+		if (t != NULL &&
+		    (thread == NULL || z_sched_prio_cmp(t, thread) > 0)) {
+			thread = t;
+		}
+	}
+
+	return thread;
+#else
+	return _priq_run_best(&_kernel.ready_q.runq);
+#endif
+}
+
 /* _current is never in the run queue until context switch on
  * SMP configurations, see z_requeue_current()
  */
@@ -178,12 +282,11 @@ static inline bool should_queue_thread(struct k_thread *th)
 	return !IS_ENABLED(CONFIG_SMP) || th != _current;
 }
 
-static ALWAYS_INLINE void queue_thread(void *pq,
-				       struct k_thread *thread)
+static ALWAYS_INLINE void queue_thread(struct k_thread *thread)
 {
 	thread->base.thread_state |= _THREAD_QUEUED;
 	if (should_queue_thread(thread)) {
-		_priq_run_add(pq, thread);
+		runq_add(thread);
 	}
 #ifdef CONFIG_SMP
 	if (thread == _current) {
@@ -193,12 +296,11 @@ static ALWAYS_INLINE void queue_thread(void *pq,
 #endif
 }
 
-static ALWAYS_INLINE void dequeue_thread(void *pq,
-					 struct k_thread *thread)
+static ALWAYS_INLINE void dequeue_thread(struct k_thread *thread)
 {
 	thread->base.thread_state &= ~_THREAD_QUEUED;
 	if (should_queue_thread(thread)) {
-		_priq_run_remove(pq, thread);
+		runq_remove(thread);
 	}
 }
 
@@ -212,7 +314,7 @@ static ALWAYS_INLINE void dequeue_thread(void *pq,
 void z_requeue_current(struct k_thread *curr)
 {
 	if (z_is_thread_queued(curr)) {
-		_priq_run_add(&_kernel.ready_q.runq, curr);
+		runq_add(curr);
 	}
 }
 #endif
@@ -226,7 +328,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 	struct k_thread *thread;
 
-	thread = _priq_run_best(&_kernel.ready_q.runq);
+	thread = runq_best();
 
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
@@ -292,12 +394,12 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	/* Put _current back into the queue */
 	if (thread != _current && active &&
 		!z_is_idle_thread_object(_current) && !queued) {
-		queue_thread(&_kernel.ready_q.runq, _current);
+		queue_thread(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(thread)) {
-		dequeue_thread(&_kernel.ready_q.runq, thread);
+		dequeue_thread(thread);
 	}
 
 	_current_cpu->swap_ok = false;
@@ -308,9 +410,9 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		dequeue_thread(&_kernel.ready_q.runq, thread);
+		dequeue_thread(thread);
 	}
-	queue_thread(&_kernel.ready_q.runq, thread);
+	queue_thread(thread);
 	update_cache(thread == _current);
 }
 
@@ -464,6 +566,76 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+/* Interrupt the CPUs in cpu_mask so they reschedule.  Without
+ * CONFIG_SCHED_IPI_TARGETED the mask is ignored and all other CPUs
+ * are interrupted.
+ */
+static void signal_ipi(uint32_t cpu_mask)
+{
+#ifdef CONFIG_SCHED_IPI_TARGETED
+	cpu_mask &= ~BIT(_current_cpu->id);
+	if (cpu_mask == 0U) {
+		return;
+	}
+
+#ifdef CONFIG_SCHED_IPI_STATS
+	_current_cpu->ipi_sent += popcount(cpu_mask);
+#endif
+	arch_sched_directed_ipi(cpu_mask);
+#else
+	ARG_UNUSED(cpu_mask);
+
+#ifdef CONFIG_SCHED_IPI_STATS
+	_current_cpu->ipi_sent += CONFIG_MP_NUM_CPUS - 1;
+#endif
+	arch_sched_ipi();
+#endif
+}
+
+/* The CPUs that may have to switch to a thread which just became
+ * runnable: among those it may run on, the idle ones and the ones
+ * running a thread that it preempts.  All of them are interrupted,
+ * not only the best one: when several threads are readied in a row,
+ * the current thread of the CPUs already interrupted is not updated
+ * yet, and each pick would fall on the same CPU.  A CPU finding
+ * nothing better to run just goes back to what it was doing.
+ * signal_ipi() leaves out this CPU, which reschedules on its own.
+ */
+static uint32_t ipi_mask_ready(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_IPI_TARGETED
+	uint32_t mask = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+		if (curr == NULL) {
+			/* Not started yet */
+			continue;
+		}
+
+		if (z_is_idle_thread_object(curr) ||
+		    ((is_preempt(curr) || is_metairq(thread)) &&
+		     (z_sched_prio_cmp(thread, curr) > 0))) {
+			mask |= BIT(i);
+		}
+	}
+
+	return mask;
+#else
+	ARG_UNUSED(thread);
+
+	return 0;
+#endif
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -476,10 +648,13 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
-		queue_thread(&_kernel.ready_q.runq, thread);
+#ifdef CONFIG_SCHED_THREAD_STATS
+		z_sched_stats_ready(thread);
+#endif
+		queue_thread(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		signal_ipi(ipi_mask_ready(thread));
 #endif
 	}
 }
@@ -522,7 +697,7 @@ void z_impl_k_thread_suspend(struct k_thread *thread)
 
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			dequeue_thread(&_kernel.ready_q.runq, thread);
+			dequeue_thread(thread);
 		}
 		z_mark_thread_as_suspended(thread);
 		update_cache(thread == _current);
@@ -583,7 +758,7 @@ static _wait_q_t *pended_on_thread(struct k_thread *thread)
 static void unready_thread(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		dequeue_thread(&_kernel.ready_q.runq, thread);
+		dequeue_thread(thread);
 	}
 	update_cache(thread == _current);
 }
@@ -746,9 +921,9 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				dequeue_thread(&_kernel.ready_q.runq, thread);
+				dequeue_thread(thread);
 				thread->base.prio = prio;
-				queue_thread(&_kernel.ready_q.runq, thread);
+				queue_thread(thread);
 			} else {
 				thread->base.prio = prio;
 			}
@@ -768,7 +943,19 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 	bool need_sched = z_set_prio(thread, prio);
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
+	uint32_t ipi_mask = 0;
+
+	/* A running thread's CPU may now have something better to do,
+	 * a queued one may now preempt another CPU
+	 */
+	LOCKED(&sched_spinlock) {
+		if (thread_active_elsewhere(thread)) {
+			ipi_mask = BIT(thread->base.cpu);
+		} else if (z_is_thread_queued(thread)) {
+			ipi_mask = ipi_mask_ready(thread);
+		}
+	}
+	signal_ipi(ipi_mask);
 #endif
 
 	if (need_sched && _current->base.sched_locked == 0U) {
@@ -872,6 +1059,10 @@ void *z_get_next_switch_handle(void *interrupted)
 #ifdef CONFIG_SMP
 	void *ret = NULL;
 
+#ifdef CONFIG_RCU
+	z_rcu_qs();
+#endif
+
 	LOCKED(&sched_spinlock) {
 		struct k_thread *old_thread = _current, *new_thread;
 
@@ -880,6 +1071,15 @@ void *z_get_next_switch_handle(void *interrupted)
 		}
 		new_thread = next_up();
 
+#ifdef CONFIG_SCHED_IPI_STATS
+		if (_current_cpu->ipi_pending) {
+			_current_cpu->ipi_pending = 0;
+			if (old_thread != new_thread) {
+				_current_cpu->ipi_switched++;
+			}
+		}
+#endif
+
 		if (old_thread != new_thread) {
 			update_metairq_preempt(new_thread);
 			wait_for_switch(new_thread);
@@ -889,6 +1089,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			z_reset_time_slice();
 #endif
 			_current_cpu->swap_ok = 0;
+			new_thread->base.cpu = _current_cpu->id;
 			set_current(new_thread);
 
 #ifdef CONFIG_SPIN_VALIDATE
@@ -907,8 +1108,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			 * will not return into it.
 			 */
 			if (z_is_thread_queued(old_thread)) {
-				_priq_run_add(&_kernel.ready_q.runq,
-					      old_thread);
+				runq_add(old_thread);
 			}
 		}
 		old_thread->switch_handle = interrupted;
@@ -1081,14 +1281,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -1096,10 +1296,21 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
+	}
+#else
+	init_ready_q(&_kernel.ready_q);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	k_sched_time_slice_set(CONFIG_TIMESLICE_SIZE,
@@ -1158,8 +1369,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
-			dequeue_thread(&_kernel.ready_q.runq, thread);
-			queue_thread(&_kernel.ready_q.runq, thread);
+			dequeue_thread(thread);
+			queue_thread(thread);
 		}
 	}
 }
@@ -1190,10 +1401,9 @@ void z_impl_k_yield(void)
 
 	if (!IS_ENABLED(CONFIG_SMP) ||
 	    z_is_thread_queued(_current)) {
-		dequeue_thread(&_kernel.ready_q.runq,
-			       _current);
+		dequeue_thread(_current);
 	}
-	queue_thread(&_kernel.ready_q.runq, _current);
+	queue_thread(_current);
 	update_cache(1);
 	z_swap(&sched_spinlock, key);
 }
@@ -1332,7 +1542,10 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_ready_thread(thread);
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
+	/* Targeted IPIs already went out from z_ready_thread() */
+	if (!IS_ENABLED(CONFIG_SCHED_IPI_TARGETED)) {
+		signal_ipi(0);
+	}
 #endif
 
 	if (!arch_is_in_isr()) {
@@ -1353,6 +1566,32 @@ void z_sched_ipi(void)
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif
+#ifdef CONFIG_SCHED_IPI_STATS
+	/* Whether it switches is known at the next scheduling decision */
+	_current_cpu->ipi_received++;
+	_current_cpu->ipi_pending = 1;
+#endif
+}
+#endif
+
+#ifdef CONFIG_SCHED_IPI_STATS
+int k_sched_ipi_stats_get(int cpu, struct k_sched_ipi_stats *stats)
+{
+	if ((stats == NULL) || (cpu < -1) || (cpu >= CONFIG_MP_NUM_CPUS)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct k_sched_ipi_stats) {};
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu == -1) || (cpu == i)) {
+			stats->sent += _kernel.cpus[i].ipi_sent;
+			stats->received += _kernel.cpus[i].ipi_received;
+			stats->switched += _kernel.cpus[i].ipi_switched;
+		}
+	}
+
+	return 0;
 }
 #endif
 
@@ -1469,7 +1708,7 @@ static void end_thread(struct k_thread *thread)
 		thread->base.thread_state |= _THREAD_DEAD;
 		thread->base.thread_state &= ~_THREAD_ABORTING;
 		if (z_is_thread_queued(thread)) {
-			dequeue_thread(&_kernel.ready_q.runq, thread);
+			dequeue_thread(thread);
 		}
 		if (thread->base.pended_on != NULL) {
 			unpend_thread_no_timeout(thread);
@@ -1513,7 +1752,7 @@ void z_thread_abort(struct k_thread *thread)
 		thread->base.thread_state |= _THREAD_ABORTING;
 
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
-		arch_sched_ipi();
+		signal_ipi(BIT(thread->base.cpu));
 #endif
 	}
 
@@ -25,6 +25,7 @@ static int k_sys_work_q_init(const struct device *dev)
 	struct k_work_queue_config cfg = {
 		.name = "sysworkq",
 		.no_yield = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_NO_YIELD),
+		.batch = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_BATCH),
 	};
 
 	k_work_queue_start(&k_sys_work_q,
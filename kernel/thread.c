@@ -527,6 +527,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	z_obj_cache_init(new_thread);
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -780,6 +783,7 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	thread_base->cpu = 0;
 #endif
 
 	/* swap_data does not need to be initialized */
@@ -1005,6 +1009,74 @@ static inline k_ticks_t z_vrfy_k_thread_timeout_expires_ticks(
 #endif
 
 #ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
+#ifdef CONFIG_SCHED_THREAD_STATS
+#define READY_WOKEN 1U
+#define READY_PREEMPTED 2U
+
+static inline void sched_stats_stamp(struct k_thread *thread)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	thread->rt_stats.ready_since = timing_counter_get();
+#else
+	thread->rt_stats.ready_since = k_cycle_get_32();
+#endif
+}
+
+/* Waits are far below the range of the 32 bit counter */
+static inline uint32_t sched_stats_since(struct k_thread *thread)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	timing_t now = timing_counter_get();
+
+	return (uint32_t)timing_cycles_get(&thread->rt_stats.ready_since,
+					   &now);
+#else
+	return k_cycle_get_32() - thread->rt_stats.ready_since;
+#endif
+}
+
+void z_sched_stats_ready(struct k_thread *thread)
+{
+	sched_stats_stamp(thread);
+	thread->rt_stats.ready_state = READY_WOKEN;
+	thread->rt_stats.sched.wakeups++;
+}
+
+static void sched_stats_switched_in(struct k_thread *thread)
+{
+	k_thread_sched_stats_t *stats = &thread->rt_stats.sched;
+	uint32_t wait;
+
+	if ((thread->rt_stats.ready_state == 0U) ||
+	    (thread->base.thread_state == _THREAD_DUMMY)) {
+		return;
+	}
+
+	wait = sched_stats_since(thread);
+	stats->ready_cycles += wait;
+
+	if (thread->rt_stats.ready_state == READY_WOKEN) {
+		stats->total_latency_cycles += wait;
+		stats->max_latency_cycles = MAX(stats->max_latency_cycles,
+						wait);
+		SYS_PORT_TRACING_FUNC(k_thread, sched_latency, thread, wait);
+	}
+
+	thread->rt_stats.ready_state = 0U;
+}
+
+static void sched_stats_switched_out(struct k_thread *thread)
+{
+	if (z_is_thread_ready(thread)) {
+		sched_stats_stamp(thread);
+		thread->rt_stats.ready_state = READY_PREEMPTED;
+		thread->rt_stats.sched.preemptions++;
+	} else {
+		thread->rt_stats.ready_state = 0U;
+	}
+}
+#endif /* CONFIG_SCHED_THREAD_STATS */
+
 void z_thread_mark_switched_in(void)
 {
 #ifdef CONFIG_TRACING
@@ -1021,11 +1093,18 @@ void z_thread_mark_switched_in(void)
 	thread->rt_stats.last_switched_in = k_cycle_get_32();
 #endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+	sched_stats_switched_in(thread);
+#endif
 #endif /* CONFIG_THREAD_RUNTIME_STATS */
 }
 
 void z_thread_mark_switched_out(void)
 {
+#ifdef CONFIG_IDLE_STATS
+	z_idle_stats_exit();
+#endif
+
 #ifdef CONFIG_THREAD_RUNTIME_STATS
 #ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
 	timing_t now;
@@ -1048,6 +1127,10 @@ void z_thread_mark_switched_out(void)
 		return;
 	}
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+	sched_stats_switched_out(thread);
+#endif
+
 #ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
 	now = timing_counter_get();
 	diff = timing_cycles_get(&thread->rt_stats.last_switched_in, &now);
@@ -1092,6 +1175,20 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 
 	return 0;
 }
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+int k_thread_sched_stats_get(k_tid_t thread, k_thread_sched_stats_t *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	(void)memcpy(stats, &thread->rt_stats.sched,
+		     sizeof(thread->rt_stats.sched));
+
+	return 0;
+}
+#endif
 #endif /* CONFIG_THREAD_RUNTIME_STATS */
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
@@ -11,11 +11,10 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,288 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+/* Timeout queue backends.  Each one provides, with timeout_lock held:
+ *
+ * timeout_insert()  - queue a timeout expiring @ticks after curr_tick
+ * remove_timeout()  - unlink a queued timeout
+ * is_first()        - true if @to is the earliest queued timeout
+ * first_dticks()    - ticks from curr_tick to the earliest timeout
+ *                     (K_TICKS_FOREVER if none)
+ * timeout_dticks()  - ticks from curr_tick to a given queued timeout
+ * pop_expired()     - unlink and return the next timeout expiring
+ *                     within announce_remaining, advancing curr_tick
+ *                     and announce_remaining to its expiry
+ * announce_done()   - account for the announce_remaining ticks left
+ *                     over once nothing else expires
+ */
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* Hierarchical timing wheel.  Level N has WHEEL_SLOTS lists, each
+ * spanning WHEEL_SLOTS^N ticks.  A timeout is queued in the lowest
+ * level whose span covers its distance from curr_tick, and cascades
+ * down a level each time curr_tick crosses the start of its slot.
+ * Timeouts too far out for the top level wait on wheel_overflow
+ * until the top level wraps.  Slot occupancy is tracked in a bitmap
+ * per level (slot lists are only valid while their bit is set), so
+ * finding the next slot to process never walks empty slots.
+ *
+ * In this mode the dticks field of struct _timeout holds the
+ * absolute expiry tick rather than a delta.
+ */
+#define WHEEL_BITS	6
+#define WHEEL_SLOTS	BIT(WHEEL_BITS)
+#define WHEEL_MASK	(WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_occupied[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Cached absolute tick of the earliest timeout, recomputed lazily
+ * when the timeout it came from is removed.
+ */
+static uint64_t wheel_next = UINT64_MAX;
+static bool wheel_next_stale;
+
+/* Index of the first occupied slot of a level at or after @from */
+static unsigned int wheel_next_slot(int lvl, unsigned int from)
+{
+	uint64_t bits = wheel_occupied[lvl];
+
+	from &= WHEEL_MASK;
+	if (from != 0U) {
+		bits = (bits >> from) | (bits << (WHEEL_SLOTS - from));
+	}
+
+	return (from + u64_count_trailing_zeros(bits)) & WHEEL_MASK;
+}
+
+/* Start tick of the first occupied slot of level @lvl (> 0), which
+ * is also a lower bound for every timeout queued in that level.
+ * Slot starts are always in the future: a slot whose start has been
+ * crossed was cascaded, and the current slot index maps to the next
+ * revolution.
+ */
+static uint64_t wheel_slot_start(int lvl, unsigned int *slot)
+{
+	int shift = lvl * WHEEL_BITS;
+	uint64_t blk = curr_tick >> shift;
+
+	*slot = wheel_next_slot(lvl, blk + 1U);
+
+	return (blk + 1U + ((*slot - (blk + 1U)) & WHEEL_MASK)) << shift;
+}
+
+static void timeout_insert(struct _timeout *to, k_ticks_t ticks)
+{
+	uint64_t delta = (uint64_t)ticks;
+	sys_dlist_t *list = &wheel_overflow;
+	int lvl = (delta == 0U) ? 0
+		: (63 - u64_count_leading_zeros(delta)) / WHEEL_BITS;
+
+	to->dticks = curr_tick + delta;
+
+	if (lvl < WHEEL_LEVELS) {
+		unsigned int slot = (to->dticks >> (lvl * WHEEL_BITS))
+				    & WHEEL_MASK;
+
+		list = &wheel[lvl][slot];
+		if ((wheel_occupied[lvl] & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			wheel_occupied[lvl] |= BIT64(slot);
+		}
+	}
+
+	sys_dlist_append(list, &to->node);
+
+	if (!wheel_next_stale) {
+		wheel_next = MIN(wheel_next, (uint64_t)to->dticks);
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_t *list = t->node.next;
+
+	/* Only the sole entry of a list has the head on both sides */
+	if (list == t->node.prev && list != &wheel_overflow) {
+		int idx = list - &wheel[0][0];
+
+		wheel_occupied[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+	}
+
+	if ((uint64_t)t->dticks == wheel_next) {
+		wheel_next_stale = true;
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+static uint64_t wheel_first(void)
+{
+	struct _timeout *t;
+	uint64_t best = UINT64_MAX;
+
+	if (!wheel_next_stale) {
+		return wheel_next;
+	}
+
+	/* Level 0 slots are one tick wide, so its first occupied slot
+	 * is exact.  Higher levels only need scanning when their first
+	 * occupied slot could start before the best candidate so far.
+	 */
+	if (wheel_occupied[0] != 0U) {
+		unsigned int slot = wheel_next_slot(0, curr_tick);
+
+		best = curr_tick + ((slot - curr_tick) & WHEEL_MASK);
+	}
+
+	for (int lvl = 1; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int slot;
+
+		if (wheel_occupied[lvl] == 0U ||
+		    wheel_slot_start(lvl, &slot) >= best) {
+			continue;
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel[lvl][slot], t, node) {
+			best = MIN(best, (uint64_t)t->dticks);
+		}
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&wheel_overflow, t, node) {
+		best = MIN(best, (uint64_t)t->dticks);
+	}
+
+	wheel_next = best;
+	wheel_next_stale = false;
+
+	return best;
+}
+
+static bool is_first(struct _timeout *to)
+{
+	return (uint64_t)to->dticks == wheel_first();
+}
+
+static k_ticks_t first_dticks(void)
+{
+	uint64_t next = wheel_first();
+
+	return next == UINT64_MAX ? K_TICKS_FOREVER : next - curr_tick;
+}
+
+static k_ticks_t timeout_dticks(const struct _timeout *timeout)
+{
+	return timeout->dticks - curr_tick;
+}
+
+/* Next tick after curr_tick at which a level 0 slot expires or a
+ * populated slot of a higher level (or the overflow list) must be
+ * cascaded.
+ */
+static uint64_t wheel_next_event(void)
+{
+	uint64_t ev = UINT64_MAX;
+	unsigned int slot;
+
+	if (wheel_occupied[0] != 0U) {
+		slot = wheel_next_slot(0, curr_tick + 1U);
+		ev = curr_tick + 1U + ((slot - (curr_tick + 1U)) & WHEEL_MASK);
+	}
+
+	for (int lvl = 1; lvl < WHEEL_LEVELS; lvl++) {
+		if (wheel_occupied[lvl] != 0U) {
+			ev = MIN(ev, wheel_slot_start(lvl, &slot));
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		int shift = WHEEL_LEVELS * WHEEL_BITS;
+
+		ev = MIN(ev, ((curr_tick >> shift) + 1U) << shift);
+	}
+
+	return ev;
+}
+
+/* Redistribute the slots whose span starts at curr_tick, top level
+ * first so entries can fall through several levels at once.  Entries
+ * always land strictly below the level they came from.
+ */
+static void wheel_cascade(void)
+{
+	struct _timeout *t, *tmp;
+	int shift = WHEEL_LEVELS * WHEEL_BITS;
+
+	if ((curr_tick & BIT64_MASK(shift)) == 0U) {
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel_overflow, t, tmp,
+						  node) {
+			uint64_t delta = t->dticks - curr_tick;
+
+			if (delta < BIT64(shift)) {
+				sys_dlist_remove(&t->node);
+				timeout_insert(t, delta);
+			}
+		}
+	}
+
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		unsigned int slot;
+
+		shift = lvl * WHEEL_BITS;
+		slot = (curr_tick >> shift) & WHEEL_MASK;
+
+		if ((curr_tick & BIT64_MASK(shift)) != 0U ||
+		    (wheel_occupied[lvl] & BIT64(slot)) == 0U) {
+			continue;
+		}
+
+		wheel_occupied[lvl] &= ~BIT64(slot);
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel[lvl][slot], t, tmp,
+						  node) {
+			sys_dlist_remove(&t->node);
+			timeout_insert(t, t->dticks - curr_tick);
+		}
+	}
+}
+
+static struct _timeout *pop_expired(void)
+{
+	uint64_t end = curr_tick + announce_remaining;
+
+	for (;;) {
+		unsigned int slot = curr_tick & WHEEL_MASK;
+		uint64_t ev;
+
+		if ((wheel_occupied[0] & BIT64(slot)) != 0U) {
+			sys_dnode_t *n = sys_dlist_peek_head(&wheel[0][slot]);
+			struct _timeout *t = CONTAINER_OF(n, struct _timeout,
+							  node);
+
+			remove_timeout(t);
+			return t;
+		}
+
+		ev = wheel_next_event();
+		if (ev > end) {
+			return NULL;
+		}
+
+		announce_remaining -= ev - curr_tick;
+		curr_tick = ev;
+		wheel_cascade();
+	}
+}
+
+static void announce_done(void)
+{
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +340,79 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static void timeout_insert(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+static bool is_first(struct _timeout *to)
+{
+	return to == first();
+}
+
+static k_ticks_t first_dticks(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? K_TICKS_FOREVER : to->dticks;
+}
+
+static k_ticks_t timeout_dticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static struct _timeout *pop_expired(void)
+{
+	struct _timeout *t = first();
+	int dt;
+
+	if (t == NULL || t->dticks > announce_remaining) {
+		return NULL;
+	}
+
+	dt = t->dticks;
+	curr_tick += dt;
+	announce_remaining -= dt;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+static void announce_done(void)
+{
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -66,10 +420,10 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t dt = first_dticks();
 	int32_t ticks_elapsed = elapsed();
-	int32_t ret = to == NULL ? MAX_WAIT
-		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+	int32_t ret = dt == K_TICKS_FOREVER ? MAX_WAIT
+		: CLAMP(dt - ticks_elapsed, 0, MAX_WAIT);
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -79,6 +433,34 @@ static int32_t next_timeout(void)
 	return ret;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Move an expiry @ticks after curr_tick as late as its slack allows
+ * while keeping as many low bits clear as possible, as Linux used to
+ * do for timer slack.  Timeouts whose windows overlap end up on the
+ * same tick and expire from a single wakeup.  The delay is kept in
+ * the timeout, for periodic timers to count from the nominal expiry.
+ */
+static k_ticks_t apply_slack(struct _timeout *to, k_ticks_t ticks)
+{
+	uint64_t expiry, limit;
+	int bit;
+
+	to->slack_delay = 0;
+
+	if ((to->slack <= 0) || (ticks > INT32_MAX - to->slack)) {
+		return ticks;
+	}
+
+	expiry = curr_tick + ticks;
+	limit = expiry + to->slack;
+	bit = 63 - u64_count_leading_zeros(expiry ^ limit);
+	limit &= ~(BIT64(bit) - 1);
+	to->slack_delay = (int32_t)(limit - expiry);
+
+	return ticks + to->slack_delay;
+}
+#endif
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -94,31 +476,22 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			ticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_SLACK
+		ticks = apply_slack(to, ticks);
+#endif
+		timeout_insert(to, ticks);
 
-		if (to == first()) {
+		if (is_first(to)) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -158,20 +531,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return timeout_dticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -237,26 +601,17 @@ void sys_clock_announce(int32_t ticks)
 #endif
 
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct _timeout *t;
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
+	while ((t = pop_expired()) != NULL) {
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	announce_done();
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -33,8 +33,18 @@ void z_timer_expiration_handler(struct _timeout *t)
 	 */
 	if (!K_TIMEOUT_EQ(timer->period, K_NO_WAIT) &&
 	    !K_TIMEOUT_EQ(timer->period, K_FOREVER)) {
+		k_timeout_t period = timer->period;
+
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Count the period from the nominal expiry, or the
+		 * delays of each period would add up
+		 */
+		if (Z_TICK_ABS(period.ticks) < 0) {
+			period.ticks = MAX(period.ticks - t->slack_delay, 0);
+		}
+#endif
 		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-			     timer->period);
+			     period);
 	}
 
 	/* update timer's status */
@@ -195,6 +205,28 @@ static inline uint32_t z_vrfy_k_timer_status_get(struct k_timer *timer)
 #include <syscalls/k_timer_status_get_mrsh.c>
 #endif
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void z_impl_k_timer_slack_set(struct k_timer *timer, k_timeout_t slack)
+{
+	if (K_TIMEOUT_EQ(slack, K_FOREVER)) {
+		timer->timeout.slack = INT32_MAX;
+	} else {
+		timer->timeout.slack = (int32_t)CLAMP(slack.ticks, 0,
+						      INT32_MAX);
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+#endif
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 uint32_t z_impl_k_timer_status_sync(struct k_timer *timer)
 {
 	__ASSERT(!arch_is_in_isr(), "");
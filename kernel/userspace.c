@@ -59,6 +59,20 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct z_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+atomic_t z_object_cache_gen;
+
+/* Discard the object validations cached by all threads */
+static inline void obj_cache_invalidate(void)
+{
+	(void)atomic_inc(&z_object_cache_gen);
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -396,6 +410,7 @@ void k_object_free(void *obj)
 	if (dyn != NULL) {
 		rb_remove(&obj_rb_tree, &dyn->node);
 		sys_dlist_remove(&dyn->dobj_list);
+		obj_cache_invalidate();
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -463,6 +478,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+	obj_cache_invalidate();
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
 	struct dyn_obj *dyn =
@@ -712,6 +728,7 @@ void z_object_recycle(const void *obj)
 
 	if (ko != NULL) {
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+		obj_cache_invalidate();
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
@@ -728,6 +745,7 @@ void z_object_uninit(const void *obj)
 	}
 
 	ko->flags &= ~K_OBJ_FLAG_INITIALIZED;
+	obj_cache_invalidate();
 }
 
 /*
@@ -890,4 +908,68 @@ static uintptr_t handler_no_syscall(uintptr_t arg1, uintptr_t arg2,
 	CODE_UNREACHABLE; /* LCOV_EXCL_LINE */
 }
 
+#ifdef CONFIG_SYSCALL_STATS
+static struct k_spinlock syscall_stats_lock;
+static struct k_syscall_stats syscall_stats[K_SYSCALL_BAD];
+
+extern const char *const z_syscall_names[K_SYSCALL_LIMIT];
+
+static void syscall_stats_record(uint32_t id, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+	k_spinlock_key_t key = k_spin_lock(&syscall_stats_lock);
+	struct k_syscall_stats *stats = &syscall_stats[id];
+
+	stats->count++;
+	stats->cycles += cycles;
+	stats->max_cycles = MAX(stats->max_cycles, cycles);
+	k_spin_unlock(&syscall_stats_lock, key);
+}
+
+/* Defines z_stats_<handler>, which the dispatch table points to instead
+ * of the handler itself.  Handlers that oops or abort the calling thread
+ * don't return here and aren't counted.
+ */
+#define Z_SYSCALL_STATS_WRAPPER(id, handler)				\
+	static uintptr_t z_stats_##handler(uintptr_t arg1, uintptr_t arg2, \
+					   uintptr_t arg3, uintptr_t arg4, \
+					   uintptr_t arg5, uintptr_t arg6, \
+					   void *ssf)			\
+	{								\
+		uint32_t start = k_cycle_get_32();			\
+		uintptr_t ret = handler(arg1, arg2, arg3, arg4, arg5,	\
+					arg6, ssf);			\
+									\
+		syscall_stats_record(id, start);			\
+		return ret;						\
+	}
+
+int k_syscall_stats_get(uint32_t id, struct k_syscall_stats *stats,
+			const char **name)
+{
+	if (id >= K_SYSCALL_BAD) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&syscall_stats_lock);
+
+	*stats = syscall_stats[id];
+	k_spin_unlock(&syscall_stats_lock, key);
+
+	if (name != NULL) {
+		*name = z_syscall_names[id];
+	}
+
+	return 0;
+}
+
+void k_syscall_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&syscall_stats_lock);
+
+	(void)memset(syscall_stats, 0, sizeof(syscall_stats));
+	k_spin_unlock(&syscall_stats_lock, key);
+}
+#endif /* CONFIG_SYSCALL_STATS */
+
 #include <syscall_dispatch.c>
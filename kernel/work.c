@@ -80,6 +80,92 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
+#ifdef CONFIG_WORKQUEUE_STATS
+/* List of started work queues. */
+static sys_slist_t work_queues;
+
+static inline uint32_t stats_cycles(void)
+{
+	return k_cycle_get_32();
+}
+
+/* Account for an item put on the pending list of a queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_queued_locked(struct k_work_q *queue,
+				       struct k_work *work)
+{
+	struct k_work_queue_stats *stats = &queue->stats;
+
+	work->queued_at = k_cycle_get_32();
+	stats->depth++;
+	stats->max_depth = MAX(stats->max_depth, stats->depth);
+}
+
+/* Account for an item taken off the pending list of a queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_dequeued_locked(struct k_work_q *queue)
+{
+	queue->stats.depth--;
+}
+
+/* Account for an item taken off the pending list to be run.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_started_locked(struct k_work_q *queue,
+					struct k_work *work)
+{
+	struct k_work_queue_stats *stats = &queue->stats;
+	uint32_t wait = k_cycle_get_32() - work->queued_at;
+
+	stats->depth--;
+	stats->total_wait_cycles += wait;
+	stats->max_wait_cycles = MAX(stats->max_wait_cycles, wait);
+}
+
+/* Account for a completed handler.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_ran_locked(struct k_work_q *queue,
+				    uint32_t cycles)
+{
+	struct k_work_queue_stats *stats = &queue->stats;
+
+	stats->executed++;
+	stats->total_run_cycles += cycles;
+	stats->max_run_cycles = MAX(stats->max_run_cycles, cycles);
+}
+#else
+static inline uint32_t stats_cycles(void)
+{
+	return 0;
+}
+
+static inline void stats_queued_locked(struct k_work_q *queue,
+				       struct k_work *work)
+{
+}
+
+static inline void stats_dequeued_locked(struct k_work_q *queue)
+{
+}
+
+static inline void stats_started_locked(struct k_work_q *queue,
+					struct k_work *work)
+{
+}
+
+static inline void stats_ran_locked(struct k_work_q *queue,
+				    uint32_t cycles)
+{
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 /* Initialize a canceler record and add it to the list of pending
  * cancels.
  *
@@ -190,6 +276,7 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_prepend(&queue->pending, &flusher->work.node);
 	}
+	stats_queued_locked(queue, &flusher->work);
 }
 
 /* Try to remove a work item from the given queue.
@@ -203,7 +290,9 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
-		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+		if (sys_slist_find_and_remove(&queue->pending, &work->node)) {
+			stats_dequeued_locked(queue);
+		}
 	}
 }
 
@@ -236,7 +325,7 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  * thread (chained submission).
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify queue of pending work.
  *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
@@ -275,8 +364,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		ret = -EBUSY;
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
+		stats_queued_locked(queue, work);
 		ret = 1;
-		(void)notify_queue_locked(queue);
 	}
 
 	return ret;
@@ -290,7 +379,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * * the candidate queue rejects the submission.
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify *queuep of pending work if this returns a positive
+ * value.
  *
  * @param work the work structure to be submitted
 
@@ -308,8 +398,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  */
-static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+static int enqueue_locked(struct k_work *work,
+			  struct k_work_q **queuep)
 {
 	int ret = 0;
 
@@ -355,6 +445,23 @@ static int submit_to_queue_locked(struct k_work *work,
 	return ret;
 }
 
+/* As enqueue_locked(), but notifies the queue the work was put on.
+ *
+ * Invoked with work lock held.
+ * Conditionally notifies queue.
+ */
+static int submit_to_queue_locked(struct k_work *work,
+				  struct k_work_q **queuep)
+{
+	int ret = enqueue_locked(work, queuep);
+
+	if (ret > 0) {
+		(void)notify_queue_locked(*queuep);
+	}
+
+	return ret;
+}
+
 int k_work_submit_to_queue(struct k_work_q *queue,
 			    struct k_work *work)
 {
@@ -393,6 +500,65 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works, size_t count)
+{
+	__ASSERT_NO_MSG((works != NULL) || (count == 0));
+
+	struct k_work_q *notify = NULL;
+	bool queued = false;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *wq = queue;
+
+		__ASSERT_NO_MSG(works[i] != NULL);
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit_to_queue, queue,
+						works[i]);
+
+		int rc = enqueue_locked(works[i], &wq);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, submit_to_queue, queue,
+					       works[i], rc);
+
+		if (rc < 0) {
+			if (i == 0) {
+				ret = rc;
+			}
+			break;
+		}
+
+		ret++;
+
+		/* Items normally all land on the same queue, which is
+		 * then woken only once below.  Notify early only when
+		 * that changes.
+		 */
+		if ((rc > 0) && (wq != notify)) {
+			(void)notify_queue_locked(notify);
+			notify = wq;
+		}
+		queued = queued || (rc > 0);
+	}
+
+	(void)notify_queue_locked(notify);
+	k_spin_unlock(&lock, key);
+
+	/* As in k_work_submit_to_queue() */
+	if (queued && (k_is_preempt_thread() != 0)) {
+		k_yield();
+	}
+
+	return ret;
+}
+
+int k_work_submit_batch(struct k_work **works, size_t count)
+{
+	return k_work_submit_batch_to_queue(&k_sys_work_q, works, count);
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -573,6 +739,73 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+/* Take the next pending item off a queue and mark it running.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from
+ *
+ * @return the item to run, or NULL if nothing is pending
+ */
+static struct k_work *queue_claim_locked(struct k_work_q *queue)
+{
+	sys_snode_t *node = sys_slist_get(&queue->pending);
+	struct k_work *work;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	/* Mark that there's some work active that's not on the pending
+	 * list.
+	 */
+	flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	work = CONTAINER_OF(node, struct k_work, node);
+	flag_set(&work->flags, K_WORK_RUNNING_BIT);
+	flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+	stats_started_locked(queue, work);
+
+	return work;
+}
+
+/* Mark a work item as no longer running and deal with any cancellation
+ * issued while it was running.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue that ran the item
+ * @param work the item whose handler has returned
+ */
+static void queue_complete_locked(struct k_work_q *queue,
+				  struct k_work *work)
+{
+	flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+	if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+		finalize_cancel_locked(work);
+	}
+
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+/* Number of items to run before yielding, when starting with one item
+ * already claimed.
+ *
+ * Invoked with work lock held.
+ */
+static size_t queue_batch_locked(struct k_work_q *queue)
+{
+	size_t batch = 1;
+	sys_snode_t *node;
+
+	if (flag_test(&queue->flags, K_WORK_QUEUE_BATCH_BIT)) {
+		SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+			batch++;
+		}
+	}
+
+	return batch;
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -582,24 +815,16 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
-		k_work_handler_t handler = NULL;
+		struct k_work *work;
+		size_t batch;
+		bool yield;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
-			/* Mark that there's some work active that's
-			 * not on the pending list.
-			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
-			flag_set(&work->flags, K_WORK_RUNNING_BIT);
-			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
-			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		work = queue_claim_locked(queue);
+		if ((work == NULL)
+		    && flag_test_and_clear(&queue->flags,
+					   K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -610,11 +835,6 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * submissions.
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
-		} else {
-			/* No work is available and no queue state requires
-			 * special handling.
-			 */
-			;
 		}
 
 		if (work == NULL) {
@@ -629,36 +849,41 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			continue;
 		}
 
-		k_spin_unlock(&lock, key);
+		/* In batch mode run everything that is pending now before
+		 * yielding; otherwise just this item.
+		 */
+		batch = queue_batch_locked(queue);
 
-		if (work != NULL) {
-			bool yield;
+		do {
+			k_work_handler_t handler = work->handler;
+			uint32_t start;
+
+			k_spin_unlock(&lock, key);
 
 			__ASSERT_NO_MSG(handler != NULL);
+			start = stats_cycles();
 			handler(work);
+			start = stats_cycles() - start;
 
-			/* Mark the work item as no longer running and deal
-			 * with any cancellation issued while it was running.
-			 * Clear the BUSY flag and optionally yield to prevent
-			 * starving other threads.
+			/* Complete the item, and in batch mode claim the
+			 * next one under the same lock.
 			 */
 			key = k_spin_lock(&lock);
 
-			flag_clear(&work->flags, K_WORK_RUNNING_BIT);
-			if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
-				finalize_cancel_locked(work);
-			}
+			stats_ran_locked(queue, start);
+			queue_complete_locked(queue, work);
+			batch--;
+			work = (batch > 0) ? queue_claim_locked(queue) : NULL;
+		} while (work != NULL);
 
-			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
-			k_spin_unlock(&lock, key);
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
+		k_spin_unlock(&lock, key);
 
-			/* Optionally yield to prevent the work queue from
-			 * starving other threads.
-			 */
-			if (yield) {
-				k_yield();
-			}
+		/* Optionally yield to prevent the work queue from
+		 * starving other threads.
+		 */
+		if (yield) {
+			k_yield();
 		}
 	}
 }
@@ -683,6 +908,17 @@ void k_work_queue_start(struct k_work_q *queue,
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
+	if ((cfg != NULL) && cfg->batch) {
+		flags |= K_WORK_QUEUE_BATCH;
+	}
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	queue->stats = (struct k_work_queue_stats){};
+	sys_slist_append(&work_queues, &queue->stats_node);
+	k_spin_unlock(&lock, key);
+#endif
 
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
@@ -755,6 +991,59 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_STATS
+
+void k_work_queue_stats_get(struct k_work_q *queue,
+			    struct k_work_queue_stats *stats)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stats);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = queue->stats;
+	k_spin_unlock(&lock, key);
+}
+
+void k_work_queue_stats_reset(struct k_work_q *queue)
+{
+	__ASSERT_NO_MSG(queue);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	queue->stats = (struct k_work_queue_stats){
+		.depth = queue->stats.depth,
+		.max_depth = queue->stats.depth,
+	};
+	k_spin_unlock(&lock, key);
+}
+
+void k_work_queue_foreach(k_work_queue_cb_t cb, void *user_data)
+{
+	__ASSERT_NO_MSG(cb);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_snode_t *node = sys_slist_peek_head(&work_queues);
+
+	/* Queues are never removed from the list, so a node stays valid
+	 * while the lock is dropped for the callback.
+	 */
+	while (node != NULL) {
+		struct k_work_q *queue =
+			CONTAINER_OF(node, struct k_work_q, stats_node);
+		struct k_work_queue_stats stats = queue->stats;
+
+		k_spin_unlock(&lock, key);
+		cb(queue, &stats, user_data);
+		key = k_spin_lock(&lock);
+		node = sys_slist_peek_next(node);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
 /* Timeout handler for delayable work.
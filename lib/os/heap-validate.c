@@ -17,9 +17,12 @@
  * running one and corrupting it. YMMV.
  */
 
+/* Not end_chunk - min_chunk_size(h): on big heaps the last chunk
+ * may legitimately be a one unit solo free header.
+ */
 static chunkid_t max_chunkid(struct z_heap *h)
 {
-	return h->end_chunk - min_chunk_size(h);
+	return h->end_chunk - 1;
 }
 
 #define VALIDATE(cond) do { if (!(cond)) { return false; } } while (0)
@@ -52,23 +55,23 @@ static bool valid_chunk(struct z_heap *h, chunkid_t c)
 	return true;
 }
 
-/* Validate multiple state dimensions for the bucket "next" pointer
- * and see that they match.  Probably should unify the design a
- * bit...
+/* Validate multiple state dimensions for the free list "next"
+ * pointer and see that they match.  Probably should unify the design
+ * a bit...
  */
-static inline void check_nexts(struct z_heap *h, int bidx)
+static inline void check_nexts(struct z_heap *h, int lidx)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+	chunkid_t next = *free_list_head(h, lidx);
 
-	bool emptybit = (h->avail_buckets & (1 << bidx)) == 0;
-	bool emptylist = b->next == 0;
+	bool emptybit = !free_list_avail(h, lidx);
+	bool emptylist = next == 0;
 	bool empties_match = emptybit == emptylist;
 
 	(void)empties_match;
 	CHECK(empties_match);
 
-	if (b->next != 0) {
-		CHECK(valid_chunk(h, b->next));
+	if (next != 0) {
+		CHECK(valid_chunk(h, next));
 	}
 }
 
@@ -93,32 +96,46 @@ bool sys_heap_validate(struct sys_heap *heap)
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
 	 */
-	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
-		chunkid_t c0 = h->buckets[b].next;
+	for (int l = 0; l < nb_free_lists(h); l++) {
+		chunkid_t c0 = *free_list_head(h, l);
 		uint32_t n = 0;
 
-		check_nexts(h, b);
+		check_nexts(h, l);
 
 		for (c = c0; c != 0 && (n == 0 || c != c0);
 		     n++, c = next_free_chunk(h, c)) {
 			if (!valid_chunk(h, c)) {
 				return false;
 			}
+			if (free_list_idx(h, chunk_size(h, c)) != l) {
+				return false;
+			}
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & (1 << b)) == 0;
+		bool empty = !free_list_avail(h, l);
 		bool zero = n == 0;
 
 		if (empty != zero) {
 			return false;
 		}
 
-		if (empty && h->buckets[b].next != 0) {
+		if (empty && c0 != 0) {
 			return false;
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* The first level bitmap must summarize the second level ones */
+	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+		bool bit = (h->avail_buckets & (1U << b)) != 0U;
+
+		if (bit != (h->buckets[b].avail_lists != 0U)) {
+			return false;
+		}
+	}
+#endif
+
 	/*
 	 * Walk through the chunks linearly again, verifying that all chunks
 	 * but solo headers are now USED (i.e. all free blocks were found
@@ -145,8 +162,8 @@ bool sys_heap_validate(struct sys_heap *heap)
 	 * pass caught all the blocks and that they now show UNUSED.
 	 * Mark them USED.
 	 */
-	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
-		chunkid_t c0 = h->buckets[b].next;
+	for (int l = 0; l < nb_free_lists(h); l++) {
+		chunkid_t c0 = *free_list_head(h, l);
 		int n = 0;
 
 		if (c0 == 0) {
@@ -329,12 +346,16 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 	       "             threshold       chunks      (units)      (bytes)\n"
 	       "  -----------------------------------------------------------\n");
 	for (i = 0; i < nb_buckets; i++) {
-		chunkid_t first = h->buckets[i].next;
 		chunksz_t largest = 0;
 		int count = 0;
 
-		if (first) {
+		for (int j = 0; j < SL_LISTS; j++) {
+			chunkid_t first = *free_list_head(h, (i << SL_BITS) | j);
 			chunkid_t curr = first;
+
+			if (!first) {
+				continue;
+			}
 			do {
 				count++;
 				largest = MAX(largest, chunk_size(h, curr));
@@ -18,23 +18,23 @@ static void *chunk_mem(struct z_heap *h, chunkid_t c)
 	return ret;
 }
 
-static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
+static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int lidx)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+	chunkid_t *head = free_list_head(h, lidx);
 
 	CHECK(!chunk_used(h, c));
-	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & (1 << bidx));
+	CHECK(*head != 0);
+	CHECK(free_list_avail(h, lidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~(1 << bidx);
-		b->next = 0;
+		set_free_list_avail(h, lidx, false);
+		*head = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
 			  second = next_free_chunk(h, c);
 
-		b->next = second;
+		*head = second;
 		set_next_free_chunk(h, first, second);
 		set_prev_free_chunk(h, second, first);
 	}
@@ -43,28 +43,28 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 static void free_list_remove(struct z_heap *h, chunkid_t c)
 {
 	if (!solo_free_header(h, c)) {
-		int bidx = bucket_idx(h, chunk_size(h, c));
-		free_list_remove_bidx(h, c, bidx);
+		int lidx = free_list_idx(h, chunk_size(h, c));
+		free_list_remove_bidx(h, c, lidx);
 	}
 }
 
-static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
+static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int lidx)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+	chunkid_t *head = free_list_head(h, lidx);
 
-	if (b->next == 0U) {
-		CHECK((h->avail_buckets & (1 << bidx)) == 0);
+	if (*head == 0U) {
+		CHECK(!free_list_avail(h, lidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= (1 << bidx);
-		b->next = c;
+		set_free_list_avail(h, lidx, true);
+		*head = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & (1 << bidx));
+		CHECK(free_list_avail(h, lidx));
 
 		/* Insert before (!) the "next" pointer */
-		chunkid_t second = b->next;
+		chunkid_t second = *head;
 		chunkid_t first = prev_free_chunk(h, second);
 
 		set_prev_free_chunk(h, c, first);
@@ -77,8 +77,8 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 static void free_list_add(struct z_heap *h, chunkid_t c)
 {
 	if (!solo_free_header(h, c)) {
-		int bidx = bucket_idx(h, chunk_size(h, c));
-		free_list_add_bidx(h, c, bidx);
+		int lidx = free_list_idx(h, chunk_size(h, c));
+		free_list_add_bidx(h, c, lidx);
 	}
 }
 
@@ -167,6 +167,92 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	free_chunk(h, c);
 }
 
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	size_t addr = (size_t)mem;
+	size_t chunk_base = (size_t)&chunk_buf(h)[c];
+	size_t chunk_sz = chunk_size(h, c) * CHUNK_UNIT;
+
+	return chunk_sz - (addr - chunk_base);
+}
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+
+/* Two level segregated fit.  Every list above the one a request maps
+ * to holds only chunks that are large enough, so after a single
+ * probe of that list's head (which may well fit, and keeps small
+ * heaps from failing on exact-size requests) the first non-empty
+ * list above it is found with one bitmap lookup per level and its
+ * head used unconditionally.  Only if there is none, i.e. the heap is
+ * nearly exhausted, is a bounded number of further entries of the
+ * request's own list tried, as in the default allocator.  This makes
+ * allocation O(1) regardless of fragmentation.
+ */
+static int find_larger_list(struct z_heap *h, int lidx)
+{
+	int bidx = lidx >> SL_BITS;
+
+	if (bidx > bucket_idx(h, h->end_chunk)) {
+		return -1;
+	}
+
+	uint32_t slmask = h->buckets[bidx].avail_lists &
+			  ~((1U << (lidx & (SL_LISTS - 1))) - 1);
+
+	if (slmask == 0U) {
+		uint32_t bmask = h->avail_buckets & ~((1U << (bidx + 1)) - 1);
+
+		if (bmask == 0U) {
+			return -1;
+		}
+		bidx = __builtin_ctz(bmask);
+		slmask = h->buckets[bidx].avail_lists;
+	}
+
+	return (bidx << SL_BITS) | __builtin_ctz(slmask);
+}
+
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int lidx = free_list_idx(h, sz);
+	chunkid_t *head = free_list_head(h, lidx);
+	chunkid_t c = *head;
+
+	CHECK(bucket_idx(h, sz) <= bucket_idx(h, h->end_chunk));
+
+	if (c != 0U && chunk_size(h, c) >= sz) {
+		free_list_remove_bidx(h, c, lidx);
+		return c;
+	}
+
+	int larger = find_larger_list(h, lidx + 1);
+
+	if (larger >= 0) {
+		c = *free_list_head(h, larger);
+		free_list_remove_bidx(h, c, larger);
+		CHECK(chunk_size(h, c) >= sz);
+		return c;
+	}
+
+	if (c != 0U) {
+		chunkid_t first = c;
+		int i = CONFIG_SYS_HEAP_ALLOC_LOOPS;
+
+		while (--i && (c = next_free_chunk(h, c)) != first) {
+			if (chunk_size(h, c) >= sz) {
+				free_list_remove_bidx(h, c, lidx);
+				return c;
+			}
+		}
+	}
+
+	return 0;
+}
+
+#else
+
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -219,6 +305,8 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -361,6 +449,43 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		merge_chunks(h, c, rc);
 		set_chunk_used(h, c, true);
 		return ptr;
+	} else if (align_gap == 0 && !chunk_used(h, left_chunk(h, c)) &&
+		   (!align || !((uintptr_t)chunk_mem(h, left_chunk(h, c)) &
+				(align - 1)))) {
+		/* Expand downwards: absorb the free left chunk (and the
+		 * right one too if still needed) and slide the data down,
+		 * which is still much cheaper than a new allocation plus
+		 * copy and leaves no hole behind.
+		 */
+		chunkid_t lc = left_chunk(h, c);
+		chunksz_t avail = chunk_size(h, lc) + chunk_size(h, c);
+		bool take_rc = avail < chunks_need && !chunk_used(h, rc);
+
+		if (take_rc) {
+			avail += chunk_size(h, rc);
+		}
+
+		if (avail >= chunks_need) {
+			size_t prev_size = chunksz_to_bytes(h, chunk_size(h, c));
+			void *ptr2 = chunk_mem(h, lc);
+
+			free_list_remove(h, lc);
+			merge_chunks(h, lc, c);
+			if (take_rc) {
+				free_list_remove(h, rc);
+				merge_chunks(h, lc, rc);
+			}
+			memmove(ptr2, ptr, MIN(prev_size, bytes));
+
+			if (chunk_size(h, lc) > chunks_need) {
+				split_chunks(h, lc, lc + chunks_need);
+				set_chunk_used(h, lc, true);
+				free_chunk(h, lc + chunks_need);
+			} else {
+				set_chunk_used(h, lc, true);
+			}
+			return ptr2;
+		}
 	} else {
 		;
 	}
@@ -406,7 +531,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
 	for (int i = 0; i < nb_buckets; i++) {
-		h->buckets[i].next = 0;
+#ifdef CONFIG_SYS_HEAP_TLSF
+		h->buckets[i].avail_lists = 0U;
+#endif
+		for (int j = 0; j < SL_LISTS; j++) {
+			*free_list_head(h, (i << SL_BITS) | j) = 0;
+		}
 	}
 
 	/* chunk containing our struct z_heap */
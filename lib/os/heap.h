@@ -41,10 +41,17 @@
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
  * The free lists are circular lists, one for each power-of-two size
- * category.  The free list pointers exist only for free chunks,
- * obviously.  This memory is part of the user's buffer when
+ * category (a "bucket").  The free list pointers exist only for free
+ * chunks, obviously.  This memory is part of the user's buffer when
  * allocated.
  *
+ * With CONFIG_SYS_HEAP_TLSF each bucket is further split into
+ * SL_LISTS second level lists of equal size ranges, TLSF style, and a
+ * second level bitmap per bucket tracks which of them are non-empty.
+ * A free list is then identified by its "list index", the bucket
+ * index shifted left by SL_BITS plus the second level index (which is
+ * simply the bucket index without TLSF).
+ *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
  * the following chunk at the top. This ordering allows for quick buffer
@@ -61,8 +68,20 @@ typedef struct { char bytes[CHUNK_UNIT]; } chunk_unit_t;
 typedef uint32_t chunkid_t;
 typedef uint32_t chunksz_t;
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+#define SL_BITS 2
+#else
+#define SL_BITS 0
+#endif
+#define SL_LISTS (1U << SL_BITS)
+
 struct z_heap_bucket {
+#ifdef CONFIG_SYS_HEAP_TLSF
+	uint32_t avail_lists;
+	chunkid_t next[SL_LISTS];
+#else
 	chunkid_t next;
+#endif
 };
 
 struct z_heap {
@@ -242,6 +261,73 @@ static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
+/* Free list index a free chunk of size @a sz is kept on */
+static inline int free_list_idx(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int bidx = 31 - __builtin_clz(usable_sz);
+	unsigned int sl;
+
+	if (bidx >= SL_BITS) {
+		sl = usable_sz >> (bidx - SL_BITS);
+	} else {
+		sl = usable_sz << (SL_BITS - bidx);
+	}
+
+	return (bidx << SL_BITS) | (sl & (SL_LISTS - 1));
+}
+
+static inline int nb_free_lists(struct z_heap *h)
+{
+	return (bucket_idx(h, h->end_chunk) + 1) << SL_BITS;
+}
+
+static inline chunkid_t *free_list_head(struct z_heap *h, int lidx)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	return &h->buckets[lidx >> SL_BITS].next[lidx & (SL_LISTS - 1)];
+#else
+	return &h->buckets[lidx].next;
+#endif
+}
+
+static inline bool free_list_avail(struct z_heap *h, int lidx)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	struct z_heap_bucket *b = &h->buckets[lidx >> SL_BITS];
+
+	return (b->avail_lists & (1U << (lidx & (SL_LISTS - 1)))) != 0U;
+#else
+	return (h->avail_buckets & (1U << lidx)) != 0U;
+#endif
+}
+
+static inline void set_free_list_avail(struct z_heap *h, int lidx,
+				       bool avail)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	int bidx = lidx >> SL_BITS;
+	struct z_heap_bucket *b = &h->buckets[bidx];
+	uint32_t bit = 1U << (lidx & (SL_LISTS - 1));
+
+	if (avail) {
+		b->avail_lists |= bit;
+		h->avail_buckets |= (1U << bidx);
+	} else {
+		b->avail_lists &= ~bit;
+		if (b->avail_lists == 0U) {
+			h->avail_buckets &= ~(1U << bidx);
+		}
+	}
+#else
+	if (avail) {
+		h->avail_buckets |= (1U << lidx);
+	} else {
+		h->avail_buckets &= ~(1U << lidx);
+	}
+#endif
+}
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
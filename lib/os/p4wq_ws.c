@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <sys/p4wq_ws.h>
+#include <kernel.h>
+
+#define DEQUE_MASK (CONFIG_P4WQ_WS_DEQUE_SIZE - 1)
+
+BUILD_ASSERT((CONFIG_P4WQ_WS_DEQUE_SIZE & DEQUE_MASK) == 0,
+	     "deque size must be a power of two");
+
+static void ws_run(struct k_p4wq_ws_worker *w, struct k_p4wq_ws_task *t);
+
+static bool deque_full(struct k_p4wq_ws_worker *w)
+{
+	return w->bottom - w->top == CONFIG_P4WQ_WS_DEQUE_SIZE;
+}
+
+/* Spawned tasks go to the bottom, where the owner pops them */
+static bool push_bottom(struct k_p4wq_ws_worker *w, struct k_p4wq_ws_task *t)
+{
+	k_spinlock_key_t k = k_spin_lock(&w->lock);
+	bool ret = !deque_full(w);
+
+	if (ret) {
+		w->deque[w->bottom & DEQUE_MASK] = t;
+		w->bottom++;
+	}
+
+	k_spin_unlock(&w->lock, k);
+	return ret;
+}
+
+/* Submitted tasks go to the top: they are stolen first and never end
+ * up under the spawned tasks a joining worker pops
+ */
+static bool push_top(struct k_p4wq_ws_worker *w, struct k_p4wq_ws_task *t)
+{
+	k_spinlock_key_t k = k_spin_lock(&w->lock);
+	bool ret = !deque_full(w);
+
+	if (ret) {
+		w->top--;
+		w->deque[w->top & DEQUE_MASK] = t;
+	}
+
+	k_spin_unlock(&w->lock, k);
+	return ret;
+}
+
+static struct k_p4wq_ws_task *pop_bottom(struct k_p4wq_ws_worker *w,
+					 bool roots)
+{
+	struct k_p4wq_ws_task *t = NULL;
+	k_spinlock_key_t k = k_spin_lock(&w->lock);
+
+	if (w->bottom != w->top) {
+		t = w->deque[(w->bottom - 1) & DEQUE_MASK];
+		if (roots || t->parent != NULL) {
+			w->bottom--;
+		} else {
+			t = NULL;
+		}
+	}
+
+	k_spin_unlock(&w->lock, k);
+	return t;
+}
+
+static struct k_p4wq_ws_task *steal_top(struct k_p4wq_ws_worker *w)
+{
+	struct k_p4wq_ws_task *t = NULL;
+	k_spinlock_key_t k = k_spin_lock(&w->lock);
+
+	if (w->bottom != w->top) {
+		t = w->deque[w->top & DEQUE_MASK];
+		w->top++;
+	}
+
+	k_spin_unlock(&w->lock, k);
+	return t;
+}
+
+static struct k_p4wq_ws_task *steal(struct k_p4wq_ws_worker *w)
+{
+	struct k_p4wq_ws *ws = w->ws;
+
+	for (uint32_t i = 1; i < ws->num_workers; i++) {
+		struct k_p4wq_ws_worker *v =
+			&ws->workers[(w->id + i) % ws->num_workers];
+		struct k_p4wq_ws_task *t = steal_top(v);
+
+		if (t != NULL) {
+			w->stolen++;
+			return t;
+		}
+	}
+
+	return NULL;
+}
+
+static void wake_one(struct k_p4wq_ws *ws)
+{
+	if (atomic_get(&ws->idle) != 0) {
+		k_sem_give(&ws->wake_sem);
+	}
+}
+
+static void wait_children(struct k_p4wq_ws_worker *w,
+			  struct k_p4wq_ws_task *task)
+{
+	while (atomic_get(&task->pending) != 0) {
+		/* Our own deque first: its bottom holds our children,
+		 * or tasks spawned by them.  Stolen work nests on this
+		 * stack, so only take it while nesting is shallow.
+		 */
+		struct k_p4wq_ws_task *t = pop_bottom(w, false);
+
+		if ((t == NULL) && (w->depth < CONFIG_P4WQ_WS_STEAL_DEPTH)) {
+			t = steal(w);
+		}
+
+		if (t != NULL) {
+			w->depth++;
+			ws_run(w, t);
+			w->depth--;
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void ws_run(struct k_p4wq_ws_worker *w, struct k_p4wq_ws_task *t)
+{
+	struct k_p4wq_ws_task *parent = t->parent;
+
+	t->worker = w;
+	t->handler(t);
+	wait_children(w, t);
+	w->executed++;
+
+	/* The task may be gone once its parent or submitter sees it
+	 * complete, don't touch it afterwards
+	 */
+	if (parent != NULL) {
+		atomic_dec(&parent->pending);
+	} else {
+		k_sem_give(&t->done_sem);
+	}
+}
+
+static void ws_loop(struct k_p4wq_work *work)
+{
+	struct k_p4wq_ws_worker *w =
+		CONTAINER_OF(work, struct k_p4wq_ws_worker, work);
+	struct k_p4wq_ws *ws = w->ws;
+
+	while (true) {
+		struct k_p4wq_ws_task *t = pop_bottom(w, true);
+
+		if (t == NULL) {
+			t = steal(w);
+		}
+
+		if (t == NULL) {
+			/* Announce ourselves idle before looking once
+			 * more, so that a task pushed meanwhile is
+			 * either found here or followed by a wakeup
+			 */
+			atomic_inc(&ws->idle);
+			t = pop_bottom(w, true);
+			if (t == NULL) {
+				t = steal(w);
+			}
+			if ((t == NULL) && atomic_get(&ws->running)) {
+				k_sem_take(&ws->wake_sem, K_FOREVER);
+			}
+			atomic_dec(&ws->idle);
+		}
+
+		if (t != NULL) {
+			ws_run(w, t);
+		} else if (!atomic_get(&ws->running)) {
+			break;
+		}
+	}
+}
+
+/* Default CPU mask of worker @a i */
+static uint32_t worker_cpu_mask(const uint32_t *cpu_masks, uint32_t i)
+{
+	return cpu_masks != NULL ? cpu_masks[i] : BIT(i % CONFIG_MP_NUM_CPUS);
+}
+
+int k_p4wq_ws_start(struct k_p4wq_ws *ws, int priority,
+		    const uint32_t *cpu_masks)
+{
+	if (!atomic_cas(&ws->running, 0, 1)) {
+		return -EBUSY;
+	}
+
+	atomic_clear(&ws->idle);
+	k_sem_init(&ws->wake_sem, 0, ws->num_workers);
+
+	for (uint32_t i = 0; i < ws->num_workers; i++) {
+		struct k_p4wq_ws_worker *w = &ws->workers[i];
+
+		w->lock = (struct k_spinlock) {};
+		w->top = 0;
+		w->bottom = 0;
+		w->depth = 0;
+		w->ws = ws;
+		w->id = i;
+		w->executed = 0;
+		w->stolen = 0;
+
+		/* The threads were created without being started, the
+		 * CPU mask of a runnable one cannot be changed
+		 */
+		if (!ws->started) {
+			k_p4wq_enable_static_thread(&ws->queues[i],
+						    &ws->threads[i],
+						    worker_cpu_mask(cpu_masks,
+								    i));
+		}
+
+		w->work.priority = priority;
+		w->work.deadline = 0;
+		w->work.handler = ws_loop;
+		w->work.sync = true;
+		k_p4wq_submit(&ws->queues[i], &w->work);
+	}
+
+	ws->started = true;
+
+	return 0;
+}
+
+void k_p4wq_ws_stop(struct k_p4wq_ws *ws)
+{
+	atomic_clear(&ws->running);
+
+	for (uint32_t i = 0; i < ws->num_workers; i++) {
+		k_sem_give(&ws->wake_sem);
+	}
+
+	for (uint32_t i = 0; i < ws->num_workers; i++) {
+		struct k_p4wq_ws_worker *w = &ws->workers[i];
+
+		k_p4wq_wait(&w->work, K_FOREVER);
+		__ASSERT(w->top == w->bottom, "tasks left on worker %u", i);
+	}
+}
+
+int k_p4wq_ws_submit(struct k_p4wq_ws *ws, struct k_p4wq_ws_task *task,
+		     int worker)
+{
+	if (worker == K_P4WQ_WS_ANY_WORKER) {
+		worker = (uint32_t)atomic_inc(&ws->next) % ws->num_workers;
+	}
+
+	__ASSERT_NO_MSG((worker >= 0) && ((uint32_t)worker < ws->num_workers));
+
+	task->parent = NULL;
+	task->worker = NULL;
+	atomic_clear(&task->pending);
+	k_sem_init(&task->done_sem, 0, 1);
+
+	if (!push_top(&ws->workers[worker], task)) {
+		return -ENOSPC;
+	}
+
+	wake_one(ws);
+	return 0;
+}
+
+int k_p4wq_ws_wait(struct k_p4wq_ws_task *task, k_timeout_t timeout)
+{
+	return k_sem_take(&task->done_sem, timeout);
+}
+
+void k_p4wq_ws_spawn(struct k_p4wq_ws_task *parent,
+		     struct k_p4wq_ws_task *child)
+{
+	struct k_p4wq_ws_worker *w = parent->worker;
+
+	child->parent = parent;
+	child->worker = NULL;
+	atomic_clear(&child->pending);
+	atomic_inc(&parent->pending);
+
+	if (push_bottom(w, child)) {
+		wake_one(w->ws);
+	} else {
+		ws_run(w, child);
+	}
+}
+
+void k_p4wq_ws_join(struct k_p4wq_ws_task *task)
+{
+	wait_children(task->worker, task);
+}
@@ -50,6 +50,19 @@ table_template = """/* auto-generated by gen_syscalls.py, don't edit */
  */
 %s
 
+#ifdef CONFIG_SYSCALL_STATS
+/* Profiling wrappers, see Z_SYSCALL_STATS_WRAPPER() in userspace.c */
+%s
+
+const char *const z_syscall_names[K_SYSCALL_LIMIT] = {
+\t%s
+};
+
+#define Z_SYSCALL_HANDLER(handler) z_stats_##handler
+#else
+#define Z_SYSCALL_HANDLER(handler) handler
+#endif
+
 const _k_syscall_handler_t _k_syscall_table[K_SYSCALL_LIMIT] = {
 \t%s
 };
@@ -331,7 +344,7 @@ def analyze_fn(match_group):
     invocation = wrapper_defs(func_name, func_type, args)
 
     # Entry in _k_syscall_table
-    table_entry = "[%s] = %s" % (sys_id, handler)
+    table_entry = "[%s] = Z_SYSCALL_HANDLER(%s)" % (sys_id, handler)
 
     return (handler, invocation, marshaller, sys_id, table_entry)
 
@@ -372,9 +385,15 @@ def main():
     ids = []
     table_entries = []
     handlers = []
+    stats_wrappers = []
+    names = []
 
     for match_group, fn in syscalls:
         handler, inv, mrsh, sys_id, entry = analyze_fn(match_group)
+        func_name = typename_split(match_group[0])[1]
+        stats_wrappers.append("Z_SYSCALL_STATS_WRAPPER(%s, %s)"
+                              % (sys_id, handler))
+        names.append("[%s] = \"%s\"" % (sys_id, func_name))
 
         if fn not in invocations:
             invocations[fn] = []
@@ -401,6 +420,8 @@ def main():
                                    % s for s in noweak])
 
         fp.write(table_template % (weak_defines,
+                                   "\n".join(stats_wrappers),
+                                   ",\n\t".join(names),
                                    ",\n\t".join(table_entries)))
 
     # Listing header emitted to stdout
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+#include <init.h>
+
+/* The page frames form a circle which a clock hand sweeps around, one
+ * frame per step. Recently accessed frames have their accessed bit
+ * cleared and are passed over, the first frame found not accessed since
+ * the previous sweep is evicted. This approximates LRU without a
+ * periodic timer, and every frame skipped over by a selection has its
+ * accessed bit cleared, so the number of steps is bounded by two sweeps
+ * and amortizes to a small constant per eviction.
+ *
+ * The hand stays where the last selection stopped, so that the frames
+ * behind it, which were just looked at, get a full sweep to be accessed
+ * again before being considered for eviction.
+ */
+static size_t clock_hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t flags;
+
+	for (size_t steps = 0; steps < 2 * Z_NUM_PAGE_FRAMES; steps++) {
+		pf = &z_page_frames[clock_hand];
+		clock_hand = (clock_hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Clears the accessed bit, giving the page a second chance
+		 * if it was set
+		 */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0UL) {
+			*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+			return pf;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(false, "no page to evict");
+
+	return NULL;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	clock_hand = 0;
+}
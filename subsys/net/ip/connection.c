@@ -54,11 +54,116 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Handler of a single connection, as opposed to a listening one */
+#define NET_CONN_CONNECTED		(NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define CONN_HASH_SIZE BIT(CONFIG_NET_CONN_HASH_BITS)
+
+/* UDP and TCP handlers are also linked in one of these lists, so that
+ * unicast packets are matched against a few candidates only:
+ *
+ * - connected handlers, hashed on protocol, remote address and ports,
+ * - handlers with a local port, hashed on protocol and local port,
+ * - all the others.
+ */
+static sys_slist_t conn_connected[CONN_HASH_SIZE];
+static sys_slist_t conn_listen[CONN_HASH_SIZE];
+static sys_slist_t conn_wild;
+
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	/* Multiplicative hashing, the top bits are the best mixed */
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+static inline uint32_t conn_hash_bucket(uint32_t hash)
+{
+	return hash >> (32 - CONFIG_NET_CONN_HASH_BITS);
+}
+
+/* Addresses and ports are hashed in network byte order, as found in
+ * both the handlers and the packet headers.
+ */
+static uint32_t conn_hash_connected(uint8_t proto, sa_family_t family,
+				    const void *remote_addr,
+				    uint16_t remote_port, uint16_t local_port)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+	const uint8_t *addr = remote_addr;
+	uint32_t hash;
+
+	hash = conn_hash_mix(proto, ((uint32_t)remote_port << 16) | local_port);
+
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash,
+				     UNALIGNED_GET((const uint32_t *)&addr[i]));
+	}
+
+	return conn_hash_bucket(hash);
+}
+
+static uint32_t conn_hash_listen(uint8_t proto, uint16_t local_port)
+{
+	return conn_hash_bucket(conn_hash_mix(proto, local_port));
+}
+
+static bool conn_proto_is_hashed(uint16_t proto)
+{
+	return (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+	       (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP);
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	if (!conn_proto_is_hashed(conn->proto)) {
+		return &conn_wild;
+	}
+
+	if ((conn->flags & NET_CONN_CONNECTED) == NET_CONN_CONNECTED &&
+	    (conn->family == AF_INET || conn->family == AF_INET6) &&
+	    conn->remote_addr.sa_family == conn->family) {
+		const void *addr = conn->family == AF_INET6 ?
+			(const void *)&net_sin6(&conn->remote_addr)->sin6_addr :
+			(const void *)&net_sin(&conn->remote_addr)->sin_addr;
+
+		return &conn_connected[conn_hash_connected(
+				conn->proto, conn->family, addr,
+				net_sin(&conn->remote_addr)->sin_port,
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_PORT_SPEC) {
+		return &conn_listen[conn_hash_listen(
+				conn->proto,
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	return &conn_wild;
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_hash_del(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -132,6 +237,7 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -380,6 +486,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 
 	conn_set_unused(conn);
 
@@ -507,6 +614,169 @@ static bool conn_are_end_points_valid(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+static inline bool conn_is_bound_elsewhere(struct net_conn *conn,
+					   struct net_pkt *pkt)
+{
+	return conn->context != NULL &&
+	       net_context_is_bound_to_iface(conn->context) &&
+	       net_pkt_iface(pkt) != net_context_get_iface(conn->context);
+}
+
+/* Check the ports and addresses of a UDP or TCP handler against the
+ * packet.  Ports are in network byte order.
+ */
+static bool conn_ports_addrs_match(struct net_conn *conn,
+				   struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   uint16_t src_port,
+				   uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static bool conn_lookup_is_hashed(struct net_pkt *pkt, uint8_t proto,
+				  bool is_mcast_pkt)
+{
+	/* Multicast packets go to every matching handler */
+	return !is_mcast_pkt && conn_proto_is_hashed(proto) &&
+	       ((IS_ENABLED(CONFIG_NET_IPV4) &&
+		 net_pkt_family(pkt) == AF_INET) ||
+		(IS_ENABLED(CONFIG_NET_IPV6) &&
+		 net_pkt_family(pkt) == AF_INET6));
+}
+
+static bool conn_pkt_match(struct net_conn *conn, struct net_pkt *pkt,
+			   union net_ip_header *ip_hdr, uint8_t proto,
+			   uint16_t src_port, uint16_t dst_port)
+{
+	if (conn_is_bound_elsewhere(conn, pkt)) {
+		return false;
+	}
+
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != AF_UNSPEC &&
+	    conn->family != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	return conn_ports_addrs_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Find the handler of a unicast UDP or TCP packet.  A connected
+ * handler always wins, otherwise the best ranked handler is picked
+ * the same way as when scanning all of them.
+ */
+static struct net_conn *conn_lookup_hashed(struct net_pkt *pkt,
+					   union net_ip_header *ip_hdr,
+					   uint8_t proto,
+					   uint16_t src_port,
+					   uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	sys_slist_t *lists[2];
+	const void *src;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else {
+		src = &ip_hdr->ipv4->src;
+	}
+
+	lists[0] = &conn_connected[conn_hash_connected(proto,
+						       net_pkt_family(pkt),
+						       src, src_port,
+						       dst_port)];
+
+	SYS_SLIST_FOR_EACH_CONTAINER(lists[0], conn, hash_node) {
+		if (!conn_pkt_match(conn, pkt, ip_hdr, proto,
+				    src_port, dst_port)) {
+			continue;
+		}
+
+		if (best_rank < NET_CONN_RANK(conn->flags)) {
+			best_rank = NET_CONN_RANK(conn->flags);
+			best_match = conn;
+		}
+	}
+
+	if (best_match != NULL) {
+		return best_match;
+	}
+
+	lists[0] = &conn_listen[conn_hash_listen(proto, dst_port)];
+	lists[1] = &conn_wild;
+
+	for (int i = 0; i < ARRAY_SIZE(lists); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (!conn_pkt_match(conn, pkt, ip_hdr, proto,
+					    src_port, dst_port)) {
+				continue;
+			}
+
+			/* A handler with a remote port is not overridden
+			 * by listening ones
+			 */
+			if (best_match != NULL &&
+			    best_match->flags & NET_CONN_REMOTE_PORT_SPEC) {
+				return best_match;
+			}
+
+			if (best_rank < NET_CONN_RANK(conn->flags)) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#else
+static inline bool conn_lookup_is_hashed(struct net_pkt *pkt, uint8_t proto,
+					 bool is_mcast_pkt)
+{
+	return false;
+}
+
+static inline struct net_conn *conn_lookup_hashed(struct net_pkt *pkt,
+						  union net_ip_header *ip_hdr,
+						  uint8_t proto,
+						  uint16_t src_port,
+						  uint16_t dst_port)
+{
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 					struct net_conn *conn, uint8_t proto)
 {
@@ -623,10 +893,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	if (conn_lookup_is_hashed(pkt, proto, is_mcast_pkt)) {
+		best_match = conn_lookup_hashed(pkt, ip_hdr, proto,
+						src_port, dst_port);
+		goto deliver;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		if (conn->context != NULL &&
-		    net_context_is_bound_to_iface(conn->context) &&
-		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		if (conn_is_bound_elsewhere(conn, pkt)) {
 			continue;
 		}
 
@@ -693,34 +967,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_ports_addrs_match(conn, pkt, ip_hdr,
+						    src_port, dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -796,6 +1045,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+deliver:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -856,6 +1106,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_connected[i]);
+		sys_slist_init(&conn_listen[i]);
+	}
+
+	sys_slist_init(&conn_wild);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -51,6 +51,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node for the hash table lookup */
+	sys_snode_t hash_node;
+#endif
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -1334,6 +1334,39 @@ static void context_finalize_packet(struct net_context *context,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* TCP cuts the data it is given into segments itself, so with GSO a
+ * write is not limited to the MTU but to the largest GSO packet.
+ */
+static struct net_pkt *context_alloc_gso_pkt(struct net_context *context,
+					     size_t len, k_timeout_t timeout)
+{
+	struct net_if *iface = net_context_get_iface(context);
+	uint16_t mtu = net_if_get_mtu(iface);
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_on_iface(iface, timeout);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_family(pkt, net_context_get_family(context));
+	net_pkt_set_context(pkt, context);
+
+	/* Lifts the MTU limit of the buffer allocation */
+	net_pkt_set_gso_size(pkt, mtu);
+
+	len = MIN(len, (size_t)mtu * CONFIG_NET_TCP_GSO_MAX_SEGS);
+
+	if (net_pkt_alloc_buffer(pkt, len, IPPROTO_TCP, timeout)) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static struct net_pkt *context_alloc_pkt(struct net_context *context,
 					 size_t len, k_timeout_t timeout)
 {
@@ -1359,6 +1392,13 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 
 		return pkt;
 	}
+#endif
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_context_get_ip_proto(context) == IPPROTO_TCP &&
+	    net_context_get_iface(context) &&
+	    net_if_get_mtu(net_context_get_iface(context))) {
+		return context_alloc_gso_pkt(context, len, timeout);
+	}
 #endif
 	pkt = net_pkt_alloc_with_buffer(net_context_get_iface(context), len,
 					net_context_get_family(context),
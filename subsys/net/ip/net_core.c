@@ -57,8 +57,10 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
-static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+/* Receive a packet up to L2 included. NET_CONTINUE means that it is to be
+ * passed to L3.
+ */
+static enum net_verdict process_l2(struct net_pkt *pkt, bool is_loopback)
 {
 	int ret;
 	bool locally_routed = false;
@@ -115,6 +117,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	 */
 	net_pkt_cursor_init(pkt);
 
+	return NET_CONTINUE;
+}
+
+static enum net_verdict process_l3(struct net_pkt *pkt, bool is_loopback)
+{
 	/* IP version and header length. */
 	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
 #if defined(CONFIG_NET_IPV6)
@@ -135,15 +142,30 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	return NET_DROP;
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static inline enum net_verdict process_data(struct net_pkt *pkt,
+					    bool is_loopback)
+{
+	enum net_verdict ret;
+
+	ret = process_l2(pkt, is_loopback);
+	if (ret != NET_CONTINUE) {
+		return ret;
+	}
+
+	return process_l3(pkt, is_loopback);
+}
+
+static void processing_done(struct net_pkt *pkt, bool is_loopback,
+			    enum net_verdict verdict)
 {
 again:
-	switch (process_data(pkt, is_loopback)) {
+	switch (verdict) {
 	case NET_CONTINUE:
 		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
 			/* If we have a tunneling packet, feed it back
 			 * to the stack in this case.
 			 */
+			verdict = process_data(pkt, is_loopback);
 			goto again;
 		} else {
 			NET_DBG("Dropping pkt %p", pkt);
@@ -161,6 +183,11 @@ again:
 	}
 }
 
+static void processing_data(struct net_pkt *pkt, bool is_loopback)
+{
+	processing_done(pkt, is_loopback, process_data(pkt, is_loopback));
+}
+
 /* Things to setup after we are able to RX and TX */
 static void net_post_init(void)
 {
@@ -328,6 +355,10 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* Checksums left to an offloading device were never made */
+		net_pkt_set_chksum_ok(pkt, true);
+
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -339,9 +370,22 @@ int net_send_data(struct net_pkt *pkt)
 	return 0;
 }
 
+static bool net_rx_is_loopback(struct net_if *iface)
+{
+	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
+#ifdef CONFIG_NET_L2_DUMMY
+		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+			return true;
+		}
+#endif
+	}
+
+	return false;
+}
+
 static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 {
-	bool is_loopback = false;
+	bool is_loopback = net_rx_is_loopback(iface);
 	size_t pkt_len;
 
 	pkt_len = net_pkt_get_len(pkt);
@@ -350,14 +394,6 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	net_stats_update_bytes_recv(iface, pkt_len);
 
-	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
-#ifdef CONFIG_NET_L2_DUMMY
-		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
-			is_loopback = true;
-		}
-#endif
-	}
-
 	processing_data(pkt, is_loopback);
 
 	net_print_statistics();
@@ -373,7 +409,51 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+/* Process packets received together: L2 first for all of them, then
+ * received TCP segments are coalesced, then L3 and above.
+ */
+void net_process_rx_burst(struct net_pkt **pkts, size_t count)
+{
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+	struct net_if *iface;
+	size_t i, n;
+
+	for (i = 0, n = 0; i < count; i++) {
+		pkt = pkts[i];
+		iface = net_pkt_iface(pkt);
+
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+		net_capture_pkt(iface, pkt);
+
+		NET_DBG("Received pkt %p len %zu", pkt, net_pkt_get_len(pkt));
+
+		net_stats_update_bytes_recv(iface, net_pkt_get_len(pkt));
+
+		verdict = process_l2(pkt, net_rx_is_loopback(iface));
+		if (verdict == NET_CONTINUE) {
+			pkts[n++] = pkt;
+		} else {
+			processing_done(pkt, net_rx_is_loopback(iface),
+					verdict);
+		}
+	}
+
+	n = net_gro_receive(pkts, n);
+
+	for (i = 0; i < n; i++) {
+		bool is_loopback = net_rx_is_loopback(net_pkt_iface(pkts[i]));
+
+		processing_done(pkts[i], is_loopback,
+				process_l3(pkts[i], is_loopback));
+	}
+
+	net_print_statistics();
+	net_pkt_print();
+}
+
+static uint8_t net_rx_classify(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
@@ -388,6 +468,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_rx_classify(iface, pkt);
+
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
@@ -395,6 +482,21 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+static void net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
+		iface, pkt, net_pkt_get_len(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+		net_pkt_set_orig_iface(pkt, iface);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+}
+
 /* Called by driver when an IP packet has been received */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 {
@@ -410,21 +512,49 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		return -ENETDOWN;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
+	net_recv_prepare(iface, pkt);
 
-	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
-		iface, pkt, net_pkt_get_len(pkt));
+	net_queue_rx(iface, pkt);
 
-	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
-		net_pkt_set_orig_iface(pkt, iface);
+	return 0;
+}
+
+/* Called by driver when several packets have been received */
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	size_t i;
+
+	if (!pkts || !iface) {
+		return -EINVAL;
 	}
 
-	net_pkt_set_iface(pkt, iface);
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
 
-	net_queue_rx(iface, pkt);
+	/* The packets up to the first empty one are taken */
+	for (i = 0; i < count; i++) {
+		if (!pkts[i] || net_pkt_is_empty(pkts[i])) {
+			break;
+		}
 
-	return 0;
+		net_recv_prepare(iface, pkts[i]);
+
+		(void)net_rx_classify(iface, pkts[i]);
+	}
+
+	if (i == 0) {
+		return count ? -ENODATA : 0;
+	}
+
+	if (NET_TC_RX_COUNT == 0) {
+		net_process_rx_burst(pkts, i);
+	} else {
+		net_tc_submit_burst_to_rx_queue(pkts, i);
+	}
+
+	return i;
 }
 
 static inline void l3_init(void)
@@ -0,0 +1,259 @@
+/** @file
+ * @brief TCP segment coalescing done in software
+ *
+ * Consecutive in order segments of a TCP connection, found among the
+ * packets an Rx thread processes at once, are merged here into one
+ * packet after L2 processing, so that IP and TCP handle them only once.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_gro, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Headers of a TCP segment that can be merged with others. They are all
+ * in the first buffer of the packet.
+ */
+struct gro_seg {
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+	};
+	struct tcphdr *th;
+	uint16_t hdr_len;
+	uint16_t data_len;
+};
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t len = net_pkt_get_len(pkt);
+	sa_family_t family;
+	uint8_t ip_len;
+
+	if (net_if_get_offloads(net_pkt_iface(pkt)) & NET_IF_OFFLOAD_LRO) {
+		return false;
+	}
+
+	if (!buf || buf->len < NET_IPV4TCPH_LEN) {
+		return false;
+	}
+
+	switch (buf->data[0] & 0xf0) {
+#if defined(CONFIG_NET_IPV4)
+	case 0x40:
+		seg->ipv4 = (struct net_ipv4_hdr *)buf->data;
+
+		/* No options, no fragment, no padding */
+		if (seg->ipv4->vhl != 0x45 || seg->ipv4->proto != IPPROTO_TCP ||
+		    (seg->ipv4->offset[0] & 0x3f) || seg->ipv4->offset[1] ||
+		    ntohs(seg->ipv4->len) != len) {
+			return false;
+		}
+
+		family = AF_INET;
+		ip_len = NET_IPV4H_LEN;
+		break;
+#endif
+#if defined(CONFIG_NET_IPV6)
+	case 0x60:
+		if (buf->len < NET_IPV6TCPH_LEN) {
+			return false;
+		}
+
+		seg->ipv6 = (struct net_ipv6_hdr *)buf->data;
+
+		/* No extension header, no padding */
+		if (seg->ipv6->nexthdr != IPPROTO_TCP ||
+		    ntohs(seg->ipv6->len) + NET_IPV6H_LEN != len) {
+			return false;
+		}
+
+		family = AF_INET6;
+		ip_len = NET_IPV6H_LEN;
+		break;
+#endif
+	default:
+		return false;
+	}
+
+	seg->th = (struct tcphdr *)(buf->data + ip_len);
+	seg->hdr_len = ip_len + th_off(seg->th) * 4U;
+
+	if (th_off(seg->th) < 5 || buf->len < seg->hdr_len ||
+	    len <= seg->hdr_len) {
+		return false;
+	}
+
+	/* Plain data segments only */
+	if ((th_flags(seg->th) & ~PSH) != ACK) {
+		return false;
+	}
+
+	seg->data_len = len - seg->hdr_len;
+
+	net_pkt_set_family(pkt, family);
+	net_pkt_set_ip_hdr_len(pkt, ip_len);
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	/* A merged segment has no valid checksum, so they are checked
+	 * before. Those passing are not checked again by IP and TCP, and
+	 * those failing are left to them to drop.
+	 */
+	if (net_pkt_need_calc_rx_checksum(pkt)) {
+#if defined(CONFIG_NET_IPV4)
+		if (family == AF_INET && net_calc_chksum_ipv4(pkt) != 0U) {
+			return false;
+		}
+#endif
+
+		if (net_calc_chksum_tcp(pkt) != 0U) {
+			return false;
+		}
+
+		net_pkt_set_chksum_ok(pkt, true);
+	}
+
+	return true;
+}
+
+/* Only segments to this host are merged, not the forwarded ones */
+static bool gro_is_local(struct net_pkt *pkt, struct gro_seg *seg)
+{
+#if defined(CONFIG_NET_IPV4)
+	if (net_pkt_family(pkt) == AF_INET) {
+		return net_ipv4_is_my_addr(&seg->ipv4->dst);
+	}
+#endif
+
+#if defined(CONFIG_NET_IPV6)
+	if (net_pkt_family(pkt) == AF_INET6) {
+		return net_ipv6_is_my_addr(&seg->ipv6->dst);
+	}
+#endif
+
+	return false;
+}
+
+static bool gro_can_merge(struct net_pkt *head_pkt, struct gro_seg *head,
+			  struct net_pkt *pkt, struct gro_seg *seg)
+{
+	if (net_pkt_iface(head_pkt) != net_pkt_iface(pkt) ||
+	    net_pkt_family(head_pkt) != net_pkt_family(pkt) ||
+	    head->hdr_len != seg->hdr_len) {
+		return false;
+	}
+
+	if (net_pkt_get_len(head_pkt) + seg->data_len > UINT16_MAX) {
+		return false;
+	}
+
+#if defined(CONFIG_NET_IPV4)
+	if (net_pkt_family(pkt) == AF_INET &&
+	    (head->ipv4->tos != seg->ipv4->tos ||
+	     head->ipv4->ttl != seg->ipv4->ttl ||
+	     memcmp(&head->ipv4->src, &seg->ipv4->src,
+		    2 * sizeof(struct in_addr)))) {
+		return false;
+	}
+#endif
+
+#if defined(CONFIG_NET_IPV6)
+	if (net_pkt_family(pkt) == AF_INET6 &&
+	    (memcmp(head->ipv6, seg->ipv6, 4) ||
+	     head->ipv6->hop_limit != seg->ipv6->hop_limit ||
+	     memcmp(&head->ipv6->src, &seg->ipv6->src,
+		    2 * sizeof(struct in6_addr)))) {
+		return false;
+	}
+#endif
+
+	/* Same ports, acknowledgment and options, the data following on */
+	return UNALIGNED_GET(&head->th->th_sport) ==
+		UNALIGNED_GET(&seg->th->th_sport) &&
+		UNALIGNED_GET(&head->th->th_dport) ==
+		UNALIGNED_GET(&seg->th->th_dport) &&
+		th_ack(head->th) == th_ack(seg->th) &&
+		th_seq(head->th) + head->data_len == th_seq(seg->th) &&
+		!memcmp(head->th + 1, seg->th + 1,
+			th_off(head->th) * 4U - sizeof(struct tcphdr));
+}
+
+static void gro_merge(struct net_pkt *head_pkt, struct gro_seg *head,
+		      struct net_pkt *pkt, struct gro_seg *seg)
+{
+	uint16_t data_len = seg->data_len;
+
+	/* The last segment tells the window, and whether to push */
+	UNALIGNED_PUT(UNALIGNED_GET(&seg->th->th_win), &head->th->th_win);
+	head->th->th_flags |= th_flags(seg->th) & PSH;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_pull(pkt, seg->hdr_len);
+
+	net_pkt_append_buffer(head_pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	head->data_len += data_len;
+
+#if defined(CONFIG_NET_IPV4)
+	if (net_pkt_family(head_pkt) == AF_INET) {
+		head->ipv4->len = htons(ntohs(head->ipv4->len) + data_len);
+	}
+#endif
+
+#if defined(CONFIG_NET_IPV6)
+	if (net_pkt_family(head_pkt) == AF_INET6) {
+		head->ipv6->len = htons(ntohs(head->ipv6->len) + data_len);
+	}
+#endif
+
+	net_pkt_cursor_init(head_pkt);
+}
+
+size_t net_gro_receive(struct net_pkt **pkts, size_t count)
+{
+	struct gro_seg head = { 0 };
+	struct gro_seg seg;
+	bool have_head = false;
+	size_t i, n;
+
+	for (i = 0, n = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+
+		if (!gro_parse(pkt, &seg)) {
+			have_head = false;
+			pkts[n++] = pkt;
+			continue;
+		}
+
+		if (have_head && gro_can_merge(pkts[n - 1], &head, pkt, &seg)) {
+			NET_DBG("pkt %p merged into %p", pkt, pkts[n - 1]);
+
+			gro_merge(pkts[n - 1], &head, pkt, &seg);
+			continue;
+		}
+
+		pkts[n++] = pkt;
+		head = seg;
+		have_head = gro_is_local(pkt, &seg);
+	}
+
+	return n;
+}
@@ -0,0 +1,244 @@
+/** @file
+ * @brief TCP segmentation done in software
+ *
+ * GSO packets built by TCP are cut here into MSS sized segments, right
+ * before reaching the driver of an interface that does no TCP
+ * segmentation offload.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_gso, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/net_l2.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+/* Segments handed over to the driver at once */
+#if defined(CONFIG_NET_TC_TX_BURST)
+#define GSO_BURST CONFIG_NET_TC_TX_BURST
+#else
+#define GSO_BURST 1
+#endif
+
+/* The drivers free the segments sent so far, so it is worth waiting for
+ * them a bit
+ */
+#define GSO_ALLOC_TIMEOUT K_MSEC(100)
+
+/* Length of the IP and TCP headers, options included */
+static int gso_hdr_len(struct net_pkt *pkt, size_t *hdr_len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct tcphdr *th;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		return -EINVAL;
+	}
+
+	*hdr_len = ip_len + th_off(th) * 4U;
+
+	return 0;
+}
+
+static int gso_finalize(struct net_pkt *seg, uint32_t seq_offset, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct tcphdr *th;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) +
+			 net_pkt_ip_opts_len(seg))) {
+		return -ENOBUFS;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	UNALIGNED_PUT(htonl(th_seq(th) + seq_offset), &th->th_seq);
+
+	/* Only the last segment pushes the data or ends the stream */
+	if (!last) {
+		th->th_flags &= ~(PSH | FIN);
+	}
+
+	net_pkt_set_data(seg, &tcp_access);
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+/* Build the segment holding @len bytes of data found at @data, which is
+ * @seq_offset bytes into the data of @pkt
+ */
+static struct net_pkt *gso_segment(struct net_if *iface, struct net_pkt *pkt,
+				   size_t hdr_len,
+				   struct net_pkt_cursor *data,
+				   uint32_t seq_offset, size_t len, bool last)
+{
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(iface, hdr_len + len, AF_UNSPEC, 0,
+					GSO_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_clone_attributes(pkt, seg);
+	net_pkt_set_gso_size(seg, 0);
+
+	*net_pkt_lladdr_src(seg) = *net_pkt_lladdr_src(pkt);
+	*net_pkt_lladdr_dst(seg) = *net_pkt_lladdr_dst(pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_restore(pkt, data);
+
+	if (net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_backup(pkt, data);
+
+	if (gso_finalize(seg, seq_offset, last) < 0) {
+		goto fail;
+	}
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+/* Send segments, returning the number of bytes sent or the first error */
+static int gso_flush(struct net_if *iface, struct net_pkt **segs,
+		     size_t count)
+{
+	const struct net_l2 *l2 = net_if_l2(iface);
+	int status[GSO_BURST];
+	int sent = 0;
+	size_t i;
+
+	if (count > 1 && l2->send_burst) {
+		l2->send_burst(iface, segs, status, count);
+	} else {
+		for (i = 0; i < count; i++) {
+			status[i] = l2->send(iface, segs[i]);
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		if (status[i] < 0) {
+			net_pkt_unref(segs[i]);
+
+			if (sent >= 0) {
+				sent = status[i];
+			}
+		} else if (sent >= 0) {
+			sent += status[i];
+		}
+	}
+
+	return sent;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_pkt *segs[GSO_BURST];
+	struct net_pkt_cursor data;
+	size_t hdr_len, total, offset, len;
+	size_t count = 0;
+	int sent = 0;
+	int ret;
+
+	ret = gso_hdr_len(pkt, &hdr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	total = net_pkt_get_len(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, hdr_len);
+	net_pkt_cursor_backup(pkt, &data);
+
+	NET_DBG("pkt %p len %zu into segments of %u", pkt, total, mss);
+
+	for (offset = hdr_len; offset < total; offset += len) {
+		bool last;
+
+		len = MIN(mss, total - offset);
+		last = (offset + len == total);
+
+		segs[count] = gso_segment(iface, pkt, hdr_len, &data,
+					  offset - hdr_len, len, last);
+		if (!segs[count]) {
+			NET_DBG("Cannot build segment at %zu", offset);
+			ret = -ENOMEM;
+		} else {
+			count++;
+		}
+
+		if (count == GSO_BURST || last || ret < 0) {
+			int flushed = count ? gso_flush(iface, segs, count) : 0;
+
+			count = 0;
+
+			if (flushed < 0 && ret == 0) {
+				ret = flushed;
+			}
+
+			if (ret < 0) {
+				return ret;
+			}
+
+			sent += flushed;
+		}
+	}
+
+	/* The segments replace the packet, as if it had been sent */
+	net_pkt_unref(pkt);
+
+	return sent;
+}
@@ -203,24 +203,25 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
-static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
-{
-	struct net_linkaddr ll_dst = {
-		.addr = NULL
-	};
+/* Per packet bookkeeping done around the L2 send */
+struct net_if_tx_state {
+	struct net_linkaddr ll_dst;
 	struct net_linkaddr_storage ll_dst_storage;
 	struct net_context *context;
 	uint32_t create_time;
-	int status;
 
 	/* We collect send statistics for each socket priority if enabled */
 	uint8_t pkt_priority;
 
-	if (!pkt) {
-		return false;
-	}
+	/* Whether the interface was up, so that L2 got the packet */
+	bool up;
+};
 
-	create_time = net_pkt_create_time(pkt);
+static void net_if_tx_begin(struct net_if *iface, struct net_pkt *pkt,
+			    struct net_if_tx_state *state)
+{
+	state->ll_dst.addr = NULL;
+	state->create_time = net_pkt_create_time(pkt);
 
 	debug_check_packet(pkt);
 
@@ -229,71 +230,71 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	 * case packet is freed before callback is called.
 	 */
 	if (!sys_slist_is_empty(&link_callbacks)) {
-		if (net_linkaddr_set(&ll_dst_storage,
+		if (net_linkaddr_set(&state->ll_dst_storage,
 				     net_pkt_lladdr_dst(pkt)->addr,
 				     net_pkt_lladdr_dst(pkt)->len) == 0) {
-			ll_dst.addr = ll_dst_storage.addr;
-			ll_dst.len = ll_dst_storage.len;
-			ll_dst.type = net_pkt_lladdr_dst(pkt)->type;
+			state->ll_dst.addr = state->ll_dst_storage.addr;
+			state->ll_dst.len = state->ll_dst_storage.len;
+			state->ll_dst.type = net_pkt_lladdr_dst(pkt)->type;
 		}
 	}
 
-	context = net_pkt_context(pkt);
+	state->context = net_pkt_context(pkt);
+	state->up = net_if_flag_is_set(iface, NET_IF_UP);
 
-	if (net_if_flag_is_set(iface, NET_IF_UP)) {
-		if (IS_ENABLED(CONFIG_NET_TCP) &&
-		    net_pkt_family(pkt) != AF_UNSPEC) {
-			net_pkt_set_queued(pkt, false);
-		}
+	if (!state->up) {
+		return;
+	}
 
-		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
-			pkt_priority = net_pkt_priority(pkt);
+	if (IS_ENABLED(CONFIG_NET_TCP) &&
+	    net_pkt_family(pkt) != AF_UNSPEC) {
+		net_pkt_set_queued(pkt, false);
+	}
 
-			if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
-				/* Make sure the statistics information is not
-				 * lost by keeping the net_pkt over L2 send.
-				 */
-				net_pkt_ref(pkt);
-			}
-		}
+	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+		state->pkt_priority = net_pkt_priority(pkt);
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
+			/* Make sure the statistics information is not
+			 * lost by keeping the net_pkt over L2 send.
+			 */
+			net_pkt_ref(pkt);
+		}
+	}
+}
 
-		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
-			uint32_t end_tick = k_cycle_get_32();
+static void net_if_tx_end(struct net_if *iface, struct net_pkt *pkt,
+			  struct net_if_tx_state *state, int status)
+{
+	if (state->up && IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+		uint32_t end_tick = k_cycle_get_32();
 
-			net_pkt_set_tx_stats_tick(pkt, end_tick);
+		net_pkt_set_tx_stats_tick(pkt, end_tick);
 
-			net_stats_update_tc_tx_time(iface,
-						    pkt_priority,
-						    create_time,
-						    end_tick);
+		net_stats_update_tc_tx_time(iface,
+					    state->pkt_priority,
+					    state->create_time,
+					    end_tick);
 
-			if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
-				update_txtime_stats_detail(
-					pkt,
-					create_time,
-					end_tick);
+		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
+			update_txtime_stats_detail(
+				pkt,
+				state->create_time,
+				end_tick);
 
-				net_stats_update_tc_tx_time_detail(
-					iface, pkt_priority,
-					net_pkt_stats_tick(pkt));
+			net_stats_update_tc_tx_time_detail(
+				iface, state->pkt_priority,
+				net_pkt_stats_tick(pkt));
 
-				/* For TCP connections, we might keep the pkt
-				 * longer so that we can resend it if needed.
-				 * Because of that we need to clear the
-				 * statistics here.
-				 */
-				net_pkt_stats_tick_reset(pkt);
+			/* For TCP connections, we might keep the pkt
+			 * longer so that we can resend it if needed.
+			 * Because of that we need to clear the
+			 * statistics here.
+			 */
+			net_pkt_stats_tick_reset(pkt);
 
-				net_pkt_unref(pkt);
-			}
+			net_pkt_unref(pkt);
 		}
-
-	} else {
-		/* Drop packet if interface is not up */
-		NET_WARN("iface %p is down", iface);
-		status = -ENETDOWN;
 	}
 
 	if (status < 0) {
@@ -302,20 +303,132 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		net_stats_update_bytes_sent(iface, status);
 	}
 
-	if (context) {
+	if (state->context) {
 		NET_DBG("Calling context send cb %p status %d",
-			context, status);
+			state->context, status);
+
+		net_context_send_cb(state->context, status);
+	}
+
+	if (state->ll_dst.addr) {
+		net_if_call_link_cb(iface, &state->ll_dst, status);
+	}
+}
 
-		net_context_send_cb(context, status);
+/* Whether a GSO packet is to be cut into segments by the stack */
+static inline bool net_if_need_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	return net_pkt_gso_size(pkt) &&
+		!(net_if_get_offloads(iface) & NET_IF_OFFLOAD_TSO);
+}
+
+static int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_if_need_gso(iface, pkt)) {
+		return net_gso_send(iface, pkt);
 	}
+#endif
+
+	return net_if_l2(iface)->send(iface, pkt);
+}
+
+static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_if_tx_state state;
+	int status;
 
-	if (ll_dst.addr) {
-		net_if_call_link_cb(iface, &ll_dst, status);
+	if (!pkt) {
+		return false;
 	}
 
+	net_if_tx_begin(iface, pkt, &state);
+
+	if (state.up) {
+		status = net_if_l2_send(iface, pkt);
+	} else {
+		/* Drop packet if interface is not up */
+		NET_WARN("iface %p is down", iface);
+		status = -ENETDOWN;
+	}
+
+	net_if_tx_end(iface, pkt, &state, status);
+
 	return true;
 }
 
+#if defined(CONFIG_NET_TC_TX_BURST) && CONFIG_NET_TC_TX_BURST > 1
+/* Send packets that all go out through the same interface */
+static void net_if_tx_burst(struct net_if *iface, struct net_pkt **pkts,
+			    size_t count)
+{
+	struct net_if_tx_state state[CONFIG_NET_TC_TX_BURST];
+	int status[CONFIG_NET_TC_TX_BURST];
+	const struct net_l2 *l2 = net_if_l2(iface);
+	size_t i, first, n;
+
+	__ASSERT_NO_MSG(count <= CONFIG_NET_TC_TX_BURST);
+
+	if (!l2->send_burst || !net_if_flag_is_set(iface, NET_IF_UP)) {
+		for (i = 0; i < count; i++) {
+			net_if_tx(iface, pkts[i]);
+		}
+
+		return;
+	}
+
+	for (first = 0; first < count; first += n) {
+		/* GSO packets cut in software are sent on their own */
+		for (n = 0; first + n < count &&
+			    !net_if_need_gso(iface, pkts[first + n]); n++) {
+		}
+
+		if (n == 0) {
+			net_if_tx(iface, pkts[first]);
+			n = 1;
+			continue;
+		}
+
+		for (i = first; i < first + n; i++) {
+			net_if_tx_begin(iface, pkts[i], &state[i]);
+		}
+
+		l2->send_burst(iface, &pkts[first], &status[first], n);
+
+		for (i = first; i < first + n; i++) {
+			net_if_tx_end(iface, pkts[i], &state[i], status[i]);
+		}
+	}
+}
+
+void net_process_tx_burst(struct net_pkt **pkts, size_t count)
+{
+	struct net_if *iface;
+	size_t i, first;
+
+	for (i = 0; i < count; i++) {
+		net_pkt_set_tx_stats_tick(pkts[i], k_cycle_get_32());
+	}
+
+	/* Hand over the runs of packets going to the same interface,
+	 * keeping the order they were queued in.
+	 */
+	for (first = 0; first < count; first = i) {
+		iface = net_pkt_iface(pkts[first]);
+
+		for (i = first + 1;
+		     i < count && net_pkt_iface(pkts[i]) == iface; i++) {
+		}
+
+		net_if_tx_burst(iface, &pkts[first], i - first);
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending -= i - first;
+#endif
+	}
+}
+#endif
+
 void net_process_tx_packet(struct net_pkt *pkt)
 {
 	struct net_if *iface;
@@ -3912,30 +4025,20 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 	k_mutex_unlock(&lock);
 }
 
-static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
+static bool need_calc_checksum(struct net_if *iface,
+			       enum net_if_offload offload)
 {
-#if defined(CONFIG_NET_L2_ETHERNET)
-	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
-		return true;
-	}
-
-	return !(net_eth_get_hw_capabilities(iface) & caps);
-#else
-	ARG_UNUSED(iface);
-	ARG_UNUSED(caps);
-
-	return true;
-#endif
+	return !(net_if_get_offloads(iface) & offload);
 }
 
 bool net_if_need_calc_tx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
+	return need_calc_checksum(iface, NET_IF_OFFLOAD_TX_CHKSUM);
 }
 
 bool net_if_need_calc_rx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+	return need_calc_checksum(iface, NET_IF_OFFLOAD_RX_CHKSUM);
 }
 
 int net_if_get_by_iface(struct net_if *iface)
@@ -951,6 +951,11 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 	sa_family_t family = net_pkt_family(pkt);
 	size_t max_len;
 
+	/* A GSO packet is cut into segments fitting the MTU later on */
+	if (net_pkt_gso_size(pkt)) {
+		return size;
+	}
+
 	if (net_pkt_iface(pkt)) {
 		max_len = net_if_get_mtu(net_pkt_iface(pkt));
 	} else {
@@ -1729,7 +1734,7 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
-static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
+void net_pkt_clone_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
 	net_pkt_set_family(clone_pkt, net_pkt_family(pkt));
 	net_pkt_set_context(clone_pkt, net_pkt_context(pkt));
@@ -1739,6 +1744,8 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
+	net_pkt_set_chksum_ok(clone_pkt, net_pkt_is_chksum_ok(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1798,7 +1805,7 @@ struct net_pkt *net_pkt_clone(struct net_pkt *pkt, k_timeout_t timeout)
 		       sizeof(clone_pkt->lladdr_dst));
 	}
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_clone_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_init(clone_pkt);
 
@@ -1844,7 +1851,7 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 		       sizeof(clone_pkt->lladdr_dst));
 	}
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_clone_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_restore(clone_pkt, &pkt->cursor);
 
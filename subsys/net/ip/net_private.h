@@ -48,12 +48,38 @@ extern void net_if_carrier_down(struct net_if *iface);
 extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
+extern void net_process_rx_burst(struct net_pkt **pkts, size_t count);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+extern void net_process_tx_burst(struct net_pkt **pkts, size_t count);
+
+/* Whether the checksums of a received packet are still to be verified */
+static inline bool net_pkt_need_calc_rx_checksum(struct net_pkt *pkt)
+{
+	return !net_pkt_is_chksum_ok(pkt) &&
+		net_if_need_calc_rx_checksum(net_pkt_iface(pkt));
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+extern int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#endif
+
+#if defined(CONFIG_NET_TCP_GRO)
+extern size_t net_gro_receive(struct net_pkt **pkts, size_t count);
+#else
+static inline size_t net_gro_receive(struct net_pkt **pkts, size_t count)
+{
+	ARG_UNUSED(pkts);
+
+	return count;
+}
+#endif
 
 #if defined(CONFIG_NET_NATIVE) || defined(CONFIG_NET_OFFLOAD)
 extern void net_context_init(void);
 extern const char *net_context_state(struct net_context *context);
 extern void net_pkt_init(void);
+extern void net_pkt_clone_attributes(struct net_pkt *pkt,
+				     struct net_pkt *clone_pkt);
 extern void net_tc_tx_init(void);
 extern void net_tc_rx_init(void);
 #else
@@ -90,6 +116,27 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_burst_to_rx_queue(struct net_pkt **pkts,
+					    size_t count);
+
+#if defined(CONFIG_NET_STATISTICS) && NET_TC_RX_COUNT > 0
+/* Statistics of one RX queue */
+struct net_tc_rx_queue_stats {
+	/* Packets queued so far */
+	uint32_t pkts;
+	/* Packets waiting in the queue, now and at most */
+	uint32_t depth;
+	uint32_t max_depth;
+	/* Traffic class served */
+	uint8_t tc;
+	/* CPU the queue thread is pinned to, or -1 */
+	int cpu;
+};
+
+extern int net_tc_rx_queue_count(void);
+extern int net_tc_rx_queue_stats_get(int queue,
+				     struct net_tc_rx_queue_stats *stats);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -257,6 +257,8 @@ struct ethernet_capabilities {
 static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_TX_CHKSUM_OFFLOAD, "TX checksum offload"),
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
+	EC(ETHERNET_HW_LRO,               "TCP large receive offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
 	EC(ETHERNET_AUTO_NEGOTIATION_SET, "Auto negotiation"),
@@ -334,6 +336,39 @@ static const char *iface_flags2str(struct net_if *iface)
 
 	return str;
 }
+
+static const char *iface_offloads2str(struct net_if *iface)
+{
+	static char str[sizeof("TX_CHKSUM") + sizeof("RX_CHKSUM") +
+			sizeof("TSO") + sizeof("LRO")];
+	uint8_t offloads = net_if_get_offloads(iface);
+	int pos = 0;
+
+	if (offloads & NET_IF_OFFLOAD_TX_CHKSUM) {
+		pos += snprintk(str + pos, sizeof(str) - pos, "TX_CHKSUM,");
+	}
+
+	if (offloads & NET_IF_OFFLOAD_RX_CHKSUM) {
+		pos += snprintk(str + pos, sizeof(str) - pos, "RX_CHKSUM,");
+	}
+
+	if (offloads & NET_IF_OFFLOAD_TSO) {
+		pos += snprintk(str + pos, sizeof(str) - pos, "TSO,");
+	}
+
+	if (offloads & NET_IF_OFFLOAD_LRO) {
+		pos += snprintk(str + pos, sizeof(str) - pos, "LRO,");
+	}
+
+	if (pos == 0) {
+		return "none";
+	}
+
+	/* get rid of last ',' character */
+	str[pos - 1] = '\0';
+
+	return str;
+}
 #endif
 
 static void iface_cb(struct net_if *iface, void *user_data)
@@ -441,6 +476,7 @@ static void iface_cb(struct net_if *iface, void *user_data)
 
 	PR("MTU       : %d\n", net_if_get_mtu(iface));
 	PR("Flags     : %s\n", iface_flags2str(iface));
+	PR("Offloads  : %s\n", iface_offloads2str(iface));
 
 #if defined(CONFIG_NET_L2_ETHERNET_MGMT)
 	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
@@ -4437,6 +4473,41 @@ static int cmd_net_route(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_net_rxq(const struct shell *shell, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if !defined(CONFIG_NET_STATISTICS)
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_NET_STATISTICS",
+		"statistics");
+#elif defined(CONFIG_NET_NATIVE) && NET_TC_RX_COUNT > 0
+	struct net_tc_rx_queue_stats stats;
+	int i;
+
+	PR("Queue  TC  CPU   Packets  Depth  Max depth\n");
+
+	for (i = 0; i < net_tc_rx_queue_count(); i++) {
+		if (net_tc_rx_queue_stats_get(i, &stats) < 0) {
+			continue;
+		}
+
+		if (stats.cpu < 0) {
+			PR("[%2d]   %2d    - %9u  %5u  %9u\n", i, stats.tc,
+			   stats.pkts, stats.depth, stats.max_depth);
+		} else {
+			PR("[%2d]   %2d  %3d %9u  %5u  %9u\n", i, stats.tc,
+			   stats.cpu, stats.pkts, stats.depth,
+			   stats.max_depth);
+		}
+	}
+#else
+	PR_INFO("No RX queues, packets are processed by the drivers.\n");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_stacks(const struct shell *shell, size_t argc,
 			  char *argv[])
 {
@@ -6024,6 +6095,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_commands,
 	SHELL_CMD(ppp, &net_cmd_ppp, "PPP information.", cmd_net_ppp_status),
 	SHELL_CMD(resume, NULL, "Resume a network interface", cmd_net_resume),
 	SHELL_CMD(route, NULL, "Show network route.", cmd_net_route),
+	SHELL_CMD(rxq, NULL, "Show RX queue statistics.", cmd_net_rxq),
 	SHELL_CMD(stacks, NULL, "Show network stacks information.",
 		  cmd_net_stacks),
 	SHELL_CMD(stats, &net_cmd_stats, "Show network statistics.",
@@ -9,27 +9,52 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr.h>
 #include <string.h>
+#include <sys/byteorder.h>
 
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
- * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * where y indicates the queue id. The value of y can be from 0 to 63, as
+ * each RX traffic class may be spread over several queues.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[yy]")
+
+#if defined(CONFIG_NET_TC_RX_FLOW_QUEUES)
+#define NET_TC_RX_FLOW_QUEUES CONFIG_NET_TC_RX_FLOW_QUEUES
+#else
+#define NET_TC_RX_FLOW_QUEUES 1
+#endif
+
+/* RX queues, NET_TC_RX_FLOW_QUEUES consecutive ones per traffic class */
+#define NET_TC_RX_QUEUES (NET_TC_RX_COUNT * NET_TC_RX_FLOW_QUEUES)
+
+#if defined(CONFIG_NET_TC_TX_BURST)
+#define NET_TC_TX_BURST CONFIG_NET_TC_TX_BURST
+#else
+#define NET_TC_TX_BURST 1
+#endif
+
+#if defined(CONFIG_NET_TC_RX_BURST)
+#define NET_TC_RX_BURST CONFIG_NET_TC_RX_BURST
+#else
+#define NET_TC_RX_BURST 1
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +62,15 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUES];
+
+#if defined(CONFIG_NET_STATISTICS)
+static struct {
+	atomic_t pkts;
+	atomic_t depth;
+	atomic_t max_depth;
+} rx_queue_stats[NET_TC_RX_QUEUES];
+#endif
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -60,18 +93,260 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if NET_TC_RX_FLOW_QUEUES > 1
+static inline uint32_t rx_flow_hash_mix(uint32_t hash, uint32_t val)
+{
+	/* Multiplicative hashing, the top bits are the best mixed */
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+/* Offset of the IP header in a packet as received from the driver, or
+ * -1 if the packet is not IP or its link layer is unknown.
+ */
+static int rx_flow_l3_offset(struct net_pkt *pkt, const uint8_t *hdr,
+			     size_t len)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		int offset = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (len < offset + sizeof(uint16_t)) {
+			return -1;
+		}
+
+		type = sys_get_be16(&hdr[offset - sizeof(uint16_t)]);
+		if (type == NET_ETH_PTYPE_VLAN) {
+			offset += sizeof(uint32_t);
+			type = sys_get_be16(&hdr[offset - sizeof(uint16_t)]);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return -1;
+		}
+
+		return offset;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+	ARG_UNUSED(hdr);
+	ARG_UNUSED(len);
+
+	return -1;
+}
+
+/* Hash the IP addresses, protocol and ports of a received packet.
+ * Fragments, and packets whose ports are not found right after the IP
+ * header, are hashed without ports, so that all the packets of a flow
+ * hash the same.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	/* Room for VLAN tagged Ethernet, IPv6 or IPv4 with a few options,
+	 * and ports
+	 */
+	uint8_t hdr[sizeof(struct net_eth_vlan_hdr) +
+		    sizeof(struct net_ipv6_hdr) + 12];
+	struct net_pkt_cursor backup;
+	const uint8_t *addrs;
+	size_t len, addr_len, l4;
+	uint32_t hash;
+	uint8_t proto;
+	int l3;
+
+	len = MIN(net_pkt_get_len(pkt), sizeof(hdr));
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, hdr, len) < 0) {
+		len = 0;
+	}
+	net_pkt_cursor_restore(pkt, &backup);
+
+	l3 = rx_flow_l3_offset(pkt, hdr, len);
+	if (l3 < 0 || len < l3 + sizeof(struct net_ipv4_hdr)) {
+		return 0;
+	}
+
+	if ((hdr[l3] & 0xf0) == 0x40) {
+		const struct net_ipv4_hdr *ip = (void *)&hdr[l3];
+
+		proto = ip->proto;
+		addrs = (const uint8_t *)&ip->src;
+		addr_len = sizeof(struct in_addr);
+		l4 = l3 + (ip->vhl & NET_IPV4_IHL_MASK) * 4U;
+
+		/* More fragments flag or fragment offset set */
+		if (sys_get_be16(ip->offset) & 0x3fff) {
+			l4 = len;
+		}
+	} else if ((hdr[l3] & 0xf0) == 0x60 &&
+		   len >= l3 + sizeof(struct net_ipv6_hdr)) {
+		const struct net_ipv6_hdr *ip = (void *)&hdr[l3];
+
+		proto = ip->nexthdr;
+		addrs = (const uint8_t *)&ip->src;
+		addr_len = sizeof(struct in6_addr);
+		l4 = l3 + sizeof(struct net_ipv6_hdr);
+	} else {
+		return 0;
+	}
+
+	hash = rx_flow_hash_mix(0, proto);
+
+	/* Source and destination addresses follow each other */
+	for (size_t i = 0; i < 2 * addr_len; i += sizeof(uint32_t)) {
+		hash = rx_flow_hash_mix(hash, UNALIGNED_GET(
+					(const uint32_t *)&addrs[i]));
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= l4 + sizeof(uint32_t)) {
+		hash = rx_flow_hash_mix(hash, UNALIGNED_GET(
+					(const uint32_t *)&hdr[l4]));
+	}
+
+	return hash;
+}
+
+static int rx_flow_queue(uint8_t tc, struct net_pkt *pkt)
+{
+	uint32_t hash = rx_flow_hash(pkt);
+
+	/* Scale the hash to the queue count, from its best mixed top bits */
+	return tc * NET_TC_RX_FLOW_QUEUES +
+		(int)(((uint64_t)hash * NET_TC_RX_FLOW_QUEUES) >> 32);
+}
+#else
+static inline int rx_flow_queue(uint8_t tc, struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return tc;
+}
+#endif /* NET_TC_RX_FLOW_QUEUES > 1 */
+
+#if defined(CONFIG_NET_STATISTICS) && NET_TC_RX_COUNT > 0
+static void rx_queue_stats_queued(int queue)
+{
+	atomic_val_t depth, max_depth;
+
+	atomic_inc(&rx_queue_stats[queue].pkts);
+	depth = atomic_inc(&rx_queue_stats[queue].depth) + 1;
+
+	do {
+		max_depth = atomic_get(&rx_queue_stats[queue].max_depth);
+	} while (depth > max_depth &&
+		 !atomic_cas(&rx_queue_stats[queue].max_depth,
+			     max_depth, depth));
+}
+
+static inline void rx_queue_stats_dequeued(int queue)
+{
+	atomic_dec(&rx_queue_stats[queue].depth);
+}
+
+int net_tc_rx_queue_count(void)
+{
+	return NET_TC_RX_QUEUES;
+}
+
+int net_tc_rx_queue_stats_get(int queue, struct net_tc_rx_queue_stats *stats)
+{
+	if (queue < 0 || queue >= NET_TC_RX_QUEUES) {
+		return -EINVAL;
+	}
+
+	stats->pkts = atomic_get(&rx_queue_stats[queue].pkts);
+	stats->depth = atomic_get(&rx_queue_stats[queue].depth);
+	stats->max_depth = atomic_get(&rx_queue_stats[queue].max_depth);
+	stats->tc = queue / NET_TC_RX_FLOW_QUEUES;
+	stats->cpu = -1;
+
+#if defined(CONFIG_SCHED_CPU_MASK) && defined(CONFIG_SMP)
+	if (NET_TC_RX_FLOW_QUEUES > 1) {
+		stats->cpu = (queue % NET_TC_RX_FLOW_QUEUES) %
+			CONFIG_MP_NUM_CPUS;
+	}
+#endif
+
+	return 0;
+}
+#else
+#define rx_queue_stats_queued(...)
+#define rx_queue_stats_dequeued(...)
+#endif
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = rx_flow_queue(tc, pkt);
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	rx_queue_stats_queued(queue);
+
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+void net_tc_submit_burst_to_rx_queue(struct net_pkt **pkts, size_t count)
+{
+#if NET_TC_RX_COUNT > 0
+	struct net_pkt *head = NULL, *tail = NULL;
+	int run_queue = 0;
+	size_t i;
+
+	/* Link together the packets going in a row to the same queue, so
+	 * that each run is queued, and its handler woken up, in one go.
+	 */
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+		uint8_t tc = net_rx_priority2tc(net_pkt_priority(pkt));
+		int queue = rx_flow_queue(tc, pkt);
+
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+		rx_queue_stats_queued(queue);
+
+		if (head && queue != run_queue) {
+			k_fifo_put_list(&rx_classes[run_queue].fifo, head, tail);
+			head = NULL;
+		}
+
+		pkt->fifo = 0;
+
+		if (!head) {
+			head = pkt;
+			run_queue = queue;
+		} else {
+			tail->fifo = (intptr_t)pkt;
+		}
+
+		tail = pkt;
+	}
+
+	if (head) {
+		k_fifo_put_list(&rx_classes[run_queue].fifo, head, tail);
+	}
+#else
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -237,22 +512,85 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static void tc_rx_handler(struct k_fifo *fifo)
+#if NET_TC_RX_BURST > 1
+static void tc_rx_handler(struct k_fifo *fifo, void *p2, void *p3)
+{
+	int queue = POINTER_TO_INT(p2);
+	struct net_pkt *pkts[NET_TC_RX_BURST];
+	size_t count;
+
+	ARG_UNUSED(p3);
+	ARG_UNUSED(queue);
+
+	while (1) {
+		pkts[0] = k_fifo_get(fifo, K_FOREVER);
+		if (pkts[0] == NULL) {
+			continue;
+		}
+
+		rx_queue_stats_dequeued(queue);
+
+		/* Take along the packets already waiting behind */
+		for (count = 1; count < NET_TC_RX_BURST; count++) {
+			pkts[count] = k_fifo_get(fifo, K_NO_WAIT);
+			if (pkts[count] == NULL) {
+				break;
+			}
+
+			rx_queue_stats_dequeued(queue);
+		}
+
+		net_process_rx_burst(pkts, count);
+	}
+}
+#else
+static void tc_rx_handler(struct k_fifo *fifo, void *p2, void *p3)
 {
+	int queue = POINTER_TO_INT(p2);
 	struct net_pkt *pkt;
 
+	ARG_UNUSED(p3);
+	ARG_UNUSED(queue);
+
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
 		if (pkt == NULL) {
 			continue;
 		}
 
+		rx_queue_stats_dequeued(queue);
+
 		net_process_rx_packet(pkt);
 	}
 }
 #endif
+#endif
 
 #if NET_TC_TX_COUNT > 0
+#if NET_TC_TX_BURST > 1
+static void tc_tx_handler(struct k_fifo *fifo)
+{
+	struct net_pkt *pkts[NET_TC_TX_BURST];
+	size_t count;
+
+	while (1) {
+		pkts[0] = k_fifo_get(fifo, K_FOREVER);
+		if (pkts[0] == NULL) {
+			continue;
+		}
+
+		/* Take along the packets already waiting behind */
+		for (count = 1; count < NET_TC_TX_BURST; count++) {
+			pkts[count] = k_fifo_get(fifo, K_NO_WAIT);
+			if (pkts[count] == NULL) {
+				break;
+			}
+		}
+
+		net_process_tx_burst(pkts, count);
+	}
+}
+#else
 static void tc_tx_handler(struct k_fifo *fifo)
 {
 	struct net_pkt *pkt;
@@ -267,6 +605,7 @@ static void tc_tx_handler(struct k_fifo *fifo)
 	}
 }
 #endif
+#endif
 
 /* Create a fifo for each traffic class we are using. All the network
  * traffic goes through these classes.
@@ -343,12 +682,13 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUES; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* All the queues of a traffic class share its priority */
+		thread_priority = rx_tc2thread(i / NET_TC_RX_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -368,8 +708,8 @@ void net_tc_rx_init(void)
 		tid = k_thread_create(&rx_classes[i].handler, rx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 				      (k_thread_entry_t)tc_rx_handler,
-				      &rx_classes[i].fifo, NULL, NULL,
-				      priority, 0, K_FOREVER);
+				      &rx_classes[i].fifo, INT_TO_POINTER(i),
+				      NULL, priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
 			continue;
@@ -382,6 +722,16 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_SCHED_CPU_MASK) && defined(CONFIG_SMP)
+		/* Spread the queues of each traffic class over the CPUs */
+		if (NET_TC_RX_FLOW_QUEUES > 1) {
+			(void)k_thread_cpu_mask_clear(tid);
+			(void)k_thread_cpu_mask_enable(tid,
+				(i % NET_TC_RX_FLOW_QUEUES) %
+				CONFIG_MP_NUM_CPUS);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <limits.h>
 #include <zephyr/types.h>
 #include <sys/slist.h>
+#include <sys/seqlock.h>
 
 #include <net/net_pkt.h>
 #include <net/net_core.h>
@@ -38,6 +39,13 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
  */
 static sys_slist_t routes;
 
+/* Lookups run for every forwarded or sent packet while the table
+ * rarely changes, so they don't lock: they scan the static route
+ * entries and start over if an entry was taken, released or reordered
+ * meanwhile.  Writers serialize on the seqlock.
+ */
+static struct k_seqlock route_lock;
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -118,6 +126,14 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 	return (struct net_route_entry *)nbr->data;
 }
 
+/* Same as net_route_data(get_nbr(idx)), without reading the data pointer
+ * that net_nbr_get() sets up
+ */
+static inline struct net_route_entry *route_entry(int idx)
+{
+	return (struct net_route_entry *)get_nbr(idx)->__nbr;
+}
+
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	int i;
@@ -170,25 +186,43 @@ void net_routes_print(void)
 
 static inline void nbr_free(struct net_nbr *nbr)
 {
+	k_spinlock_key_t key;
+	bool released;
+
 	NET_DBG("nbr %p", nbr);
 
-	net_nbr_unref(nbr);
+	/* Lookups only look at the reference count, so that is all the
+	 * write section covers.  This does what net_nbr_unref() does, with
+	 * the remove callback run once interrupts are unmasked again.
+	 */
+	key = k_seqlock_write_lock(&route_lock);
+	released = --nbr->ref == 0U;
+	k_seqlock_write_unlock(&route_lock, key);
+
+	if (released && nbr->remove) {
+		nbr->remove(nbr);
+	}
 }
 
 static struct net_nbr *nbr_new(struct net_if *iface,
 			       struct in6_addr *addr,
 			       uint8_t prefix_len)
 {
+	k_spinlock_key_t key = k_seqlock_write_lock(&route_lock);
 	struct net_nbr *nbr = net_nbr_get(&net_nbr_routes.table);
 
-	if (!nbr) {
-		return NULL;
+	if (nbr) {
+		nbr->iface = iface;
+
+		net_ipaddr_copy(&net_route_data(nbr)->addr, addr);
+		net_route_data(nbr)->prefix_len = prefix_len;
 	}
 
-	nbr->iface = iface;
+	k_seqlock_write_unlock(&route_lock, key);
 
-	net_ipaddr_copy(&net_route_data(nbr)->addr, addr);
-	net_route_data(nbr)->prefix_len = prefix_len;
+	if (!nbr) {
+		return NULL;
+	}
 
 	NET_DBG("[%d] nbr %p iface %p IPv6 %s/%d",
 		nbr->idx, nbr, iface,
@@ -253,19 +287,36 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	k_spinlock_key_t key;
+
+	/* Most lookups hit the route used last, leave readers alone then */
+	if (sys_slist_peek_head(&routes) == &route->node) {
+		return;
+	}
+
+	key = k_seqlock_write_lock(&route_lock);
+
+	/* Unless it was deleted meanwhile */
+	if (sys_slist_find_and_remove(&routes, &route->node)) {
+		sys_slist_prepend(&routes, &route->node);
+	}
+
+	k_seqlock_write_unlock(&route_lock, key);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+/* Returns the index of the route entry with the longest prefix matching
+ * @dst, or -1.  Runs in a seqlock read section, so it copies out what it
+ * compares and does not follow pointers stored in the entries.
+ */
+static int route_lookup(struct net_if *iface, struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
-	int i;
+	int i, found = -1;
 
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
+		struct in6_addr addr;
+		uint8_t prefix_len;
 
 		if (!nbr->ref) {
 			continue;
@@ -275,17 +326,36 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			continue;
 		}
 
-		route = net_route_data(nbr);
+		net_ipaddr_copy(&addr, &route_entry(i)->addr);
+		prefix_len = route_entry(i)->prefix_len;
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+		if (prefix_len >= longest_match &&
+		    net_ipv6_is_prefix(dst->s6_addr, addr.s6_addr,
+				       prefix_len)) {
+			found = i;
+			longest_match = prefix_len;
 		}
 	}
 
+	return found;
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	atomic_val_t seq;
+	int idx;
+
+	do {
+		seq = k_seqlock_read_begin(&route_lock);
+		idx = route_lookup(iface, dst);
+	} while (k_seqlock_read_retry(&route_lock, seq));
+
+	if (idx >= 0) {
+		found = route_entry(idx);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -304,6 +374,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	struct net_nbr *nbr, *nbr_nexthop, *tmp;
 	struct net_route_nexthop *nexthop_route;
 	struct net_route_entry *route;
+	k_spinlock_key_t key;
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
        struct net_event_ipv6_route info;
 #endif
@@ -353,9 +424,12 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_snode_t *last;
 
+		key = k_seqlock_write_lock(&route_lock);
+		last = sys_slist_peek_tail(&routes);
 		sys_slist_find_and_remove(&routes, last);
+		k_seqlock_write_unlock(&route_lock, key);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -401,7 +475,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 
+	key = k_seqlock_write_lock(&route_lock);
 	sys_slist_prepend(&routes, &route->node);
+	k_seqlock_write_unlock(&route_lock, key);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -433,6 +509,7 @@ int net_route_del(struct net_route_entry *route)
 {
 	struct net_nbr *nbr;
 	struct net_route_nexthop *nexthop_route;
+	k_spinlock_key_t key;
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
        struct net_event_ipv6_route info;
 #endif
@@ -454,7 +531,9 @@ int net_route_del(struct net_route_entry *route)
 	net_mgmt_event_notify(NET_EVENT_IPV6_ROUTE_DEL, route->iface);
 #endif
 
+	key = k_seqlock_write_lock(&route_lock);
 	sys_slist_find_and_remove(&routes, &route->node);
+	k_seqlock_write_unlock(&route_lock, key);
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -24,16 +24,29 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
-#include "tcp2_priv.h"
+#include "tcp_internal.h"
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
+/* Duplicate acks needed to consider a segment lost, RFC 5681 ch. 3.2 */
+#define DUP_ACK_THRESHOLD 3
+/* Upper bound of the retransmission timeout, RFC 6298 ch. 2 */
+#define RTO_MAX_MS (60 * MSEC_PER_SEC)
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
+#if defined(CONFIG_NET_TCP_CC_NEWRENO)
+static const struct tcp_cc *tcp_cc = &tcp_cc_newreno;
+#else
+static const struct tcp_cc *tcp_cc;
+#endif
+#if CONFIG_NET_TCP_RECV_WINDOW_SIZE
+static int tcp_window = CONFIG_NET_TCP_RECV_WINDOW_SIZE;
+#else
 static int tcp_window = NET_IPV6_MTU;
+#endif
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -417,6 +430,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	tcp_pkt_unref(conn->send_data);
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
 		tcp_pkt_unref(conn->queue_recv_data);
 	}
 
@@ -613,9 +627,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -661,6 +672,36 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case TCPOPT_SACK:
+			if ((opt_len - 2) % sizeof(struct tcp_sack_block)) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < TCP_SACK_MAX_BLOCKS;
+			     i += sizeof(struct tcp_sack_block)) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[
+						recv_options->sack_count];
+
+				block->left = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i)));
+				block->right = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i + 4)));
+				recv_options->sack_count++;
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -694,6 +735,16 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 					 conn->queue_recv_data->buffer);
 			conn->queue_recv_data->buffer = NULL;
 
+			k_work_cancel_delayable(&conn->recv_queue_timer);
+		} else if (net_tcp_seq_cmp(pending_seq, expected_seq) < 0) {
+			/* The peer resent what we had queued, the queue
+			 * would never line up with the new data again.
+			 */
+			NET_DBG("Dropping stale pending data seq %u",
+				pending_seq);
+			net_buf_unref(conn->queue_recv_data->buffer);
+			conn->queue_recv_data->buffer = NULL;
+
 			k_work_cancel_delayable(&conn->recv_queue_timer);
 		}
 	}
@@ -755,11 +806,52 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Build the options of a segment we send: SACK permitted in the SYN
+ * segments, and in the others the out-of-order data we hold, which the
+ * receive queue keeps as one sequential block.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	size_t len = 0;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		return 0;
+	}
+
+	if (flags & SYN) {
+		if (!(flags & ACK) || conn->recv_options.sack_perm_found) {
+			opts[len++] = TCPOPT_NOP;
+			opts[len++] = TCPOPT_NOP;
+			opts[len++] = TCPOPT_SACK_PERM;
+			opts[len++] = 2;
+		}
+	} else if ((flags & ACK) && conn->sack_ok &&
+		   CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+		   !net_pkt_is_empty(conn->queue_recv_data)) {
+		struct net_buf *first = conn->queue_recv_data->buffer;
+		struct net_buf *last = net_buf_frag_last(first);
+		uint32_t left = htonl(tcp_get_seq(first));
+		uint32_t right = htonl(tcp_get_seq(last) + last->len);
+
+		opts[len++] = TCPOPT_NOP;
+		opts[len++] = TCPOPT_NOP;
+		opts[len++] = TCPOPT_SACK;
+		opts[len++] = 2 + sizeof(struct tcp_sack_block);
+		memcpy(&opts[len], &left, sizeof(left));
+		len += sizeof(left);
+		memcpy(&opts[len], &right, sizeof(right));
+		len += sizeof(right);
+	}
+
+	return len;
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, const uint8_t *opts, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -770,7 +862,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
@@ -779,7 +871,12 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0 || !opts_len) {
+		return ret;
+	}
+
+	return net_pkt_write(pkt, opts, opts_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -802,10 +899,12 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_build(conn, flags, opts);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -815,6 +914,8 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -823,7 +924,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -888,9 +989,47 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Largest amount of data to put in a segment: what the peer accepts,
+ * and what fits in the MTU of our interface.
+ */
+uint16_t tcp_send_mss(const struct tcp *conn)
+{
+	uint16_t mss = conn_mss(conn);
+
+	if (net_tcp_get_recv_mss(conn)) {
+		mss = MIN(mss, net_tcp_get_recv_mss(conn));
+	}
+
+	return mss;
+}
+
+/* How much data we may have in flight: what the peer can take, and
+ * what the congestion control thinks the network can.
+ */
+static uint32_t tcp_send_win(struct tcp *conn)
+{
+	uint32_t win = conn->send_win;
+
+	if (tcp_cc) {
+		uint32_t cwnd = conn->cwnd;
+
+		/* Limited transmit, RFC 3042: a new segment for each of the
+		 * first dup acks, so that a small window still gets enough
+		 * of them for a fast retransmit.
+		 */
+		if (!conn->in_recovery && conn->dup_acks < DUP_ACK_THRESHOLD) {
+			cwnd += conn->dup_acks * tcp_send_mss(conn);
+		}
+
+		win = MIN(win, cwnd);
+	}
+
+	return win;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < (int)tcp_send_win(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -915,32 +1054,109 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+#if defined(CONFIG_NET_TCP_GSO)
+/* Largest TCP payload of a GSO packet, as IP lengths are 16 bit values */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - NET_IPV6TCPH_LEN)
+
+/* Allocate the data of a GSO packet, which is not limited by the MTU.
+ * This does not wait for buffers: sending MSS sized segments instead is
+ * better than sending nothing.
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, size_t len,
+					 uint16_t mss)
 {
-	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_iface(pkt, conn->iface);
+	net_pkt_set_family(pkt, net_context_get_family(conn->context));
+	net_pkt_set_gso_size(pkt, mss);
+
+	if (net_pkt_alloc_buffer(pkt, len, IPPROTO_TCP, K_NO_WAIT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Data that fits in a segment carrying our options, as the MSS does not
+ * count them (RFC 6691). Each GSO segment repeats the options too.
+ */
+static uint16_t tcp_data_seg_size(struct tcp *conn)
+{
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+
+	return tcp_send_mss(conn) - tcp_options_build(conn, PSH | ACK, opts);
+}
+
+/* Send len bytes of the send_data from pos on, in one segment or in a
+ * GSO packet of several. If the GSO packet cannot be allocated, len is
+ * lowered to what is sent in one segment.
+ */
+static int tcp_send_segment(struct tcp *conn, int pos, int *len, uint16_t mss)
+{
+	struct net_pkt *pkt = NULL;
+	int ret;
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (*len > mss) {
+		pkt = tcp_gso_pkt_alloc(conn, *len, mss);
+		if (!pkt) {
+			*len = mss;
+		}
+	}
+#endif
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		pkt = tcp_pkt_alloc(conn, *len);
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn,
+			*len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, pos, *len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len, max_len;
+	uint16_t mss = tcp_data_seg_size(conn);
+
+	max_len = mss;
+
+#if defined(CONFIG_NET_TCP_GSO)
+	max_len = MIN(mss * CONFIG_NET_TCP_GSO_MAX_SEGS, TCP_GSO_MAX_LEN);
+#endif
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   (int)tcp_send_win(conn) - conn->unacked_len,
+		   max_len);
+
+	ret = tcp_send_segment(conn, conn->unacked_len, &len, mss);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
@@ -950,18 +1166,68 @@ static int tcp_send_data(struct tcp *conn)
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
+
+			/* Time one segment per round trip, never a
+			 * retransmitted one (Karn's algorithm).
+			 */
+			if (!conn->rtt_pending) {
+				conn->rtt_pending = true;
+				conn->rtt_seq = conn->seq + conn->unacked_len;
+				conn->rtt_start = k_uptime_get_32();
+			}
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
- out:
+	return ret;
+}
+
+/* Resend one segment of the data the peer misses, during fast recovery.
+ * With SACK, these are the holes between the blocks the peer reported.
+ * Without, only the data at the start of the window is known to be lost.
+ */
+static int tcp_send_lost(struct tcp *conn)
+{
+	uint16_t mss = tcp_data_seg_size(conn);
+	uint32_t start = conn->seq;
+	uint32_t end = conn->seq + conn->unacked_len;
+	bool hole = false;
+	int len, ret;
+
+	if (net_tcp_seq_cmp(conn->rexmit_next, start) > 0) {
+		start = conn->rexmit_next;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(start, conn->sacked[i].left) < 0) {
+			end = conn->sacked[i].left;
+			hole = true;
+			break;
+		}
+
+		if (net_tcp_seq_cmp(start, conn->sacked[i].right) < 0) {
+			start = conn->sacked[i].right;
+		}
+	}
+#endif
+
+	if ((!hole && start != conn->seq) ||
+	    net_tcp_seq_cmp(end, start) <= 0) {
+		return 0;
+	}
+
+	len = MIN(end - start, mss);
+
+	ret = tcp_send_segment(conn, start - conn->seq, &len, mss);
+	if (ret == 0) {
+		conn->rexmit_next = start + len;
+
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
 	return ret;
 }
 
@@ -1008,7 +1274,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 	if (subscribe) {
 		conn->send_data_retries = 0;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn->rto));
 	}
  out:
 	return ret;
@@ -1046,8 +1312,23 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	if (conn->data_mode == TCP_DATA_MODE_SEND && tcp_cc) {
+		tcp_cc->timeout(conn);
+	}
+
+	/* Start over from the first unacknowledged byte, forgetting about
+	 * what the peer may hold beyond it (RFC 2018 ch. 8), and wait twice
+	 * as long for the next timeout (RFC 6298 ch. 5).
+	 */
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	conn->in_recovery = false;
+	conn->dup_acks = 0;
+	conn->rtt_pending = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sacked_count = 0;
+#endif
+	conn->rto = MIN(conn->rto * 2, RTO_MAX_MS);
 
 	ret = tcp_send_data(conn);
 	if (ret == 0) {
@@ -1073,7 +1354,7 @@ static void tcp_resend_data(struct k_work *work)
 	}
 
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-				    K_MSEC(tcp_rto));
+				    K_MSEC(conn->rto));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1159,6 +1440,7 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
 	conn->recv_win = tcp_window;
+	conn->rto = tcp_rto;
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1248,6 +1530,22 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 	return found ? conn : NULL;
 }
 
+/* net_conn_input() matched the packet to the connection handler of
+ * @context, which belongs to the connection itself unless the context
+ * is listening.  Check that one before searching all connections.
+ */
+static struct tcp *tcp_conn_find(struct net_context *context,
+				 struct net_pkt *pkt)
+{
+	struct tcp *conn = context->tcp;
+
+	if (conn != NULL && tcp_conn_cmp(conn, pkt)) {
+		return conn;
+	}
+
+	return tcp_conn_search(pkt);
+}
+
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
@@ -1262,7 +1560,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
-	conn = tcp_conn_search(pkt);
+	conn = tcp_conn_find(user_data, pkt);
 	if (conn) {
 		goto in;
 	}
@@ -1618,6 +1916,235 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
 }
 
+/* Start the congestion control once the MSS is known */
+static void tcp_established(struct tcp *conn)
+{
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		conn->recv_options.sack_perm_found;
+
+	if (tcp_cc) {
+		tcp_cc->init(conn);
+	}
+}
+
+/* Smoothed round-trip time and retransmission timeout, RFC 6298 ch. 2 */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	if (!conn->rtt_measured) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+		conn->rtt_measured = true;
+	} else {
+		int32_t delta = rtt - (conn->srtt >> 3);
+
+		conn->srtt += delta;
+		conn->rttvar += abs(delta) - (conn->rttvar >> 2);
+	}
+
+	conn->rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
+	conn->rto = CLAMP(conn->rto, (uint32_t)tcp_rto, RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Merge the blocks of a received SACK option into the scoreboard, which
+ * is kept sorted and only holds data not acknowledged yet.
+ */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t end = conn->seq + conn->unacked_len;
+	struct tcp_sack_block *sacked = conn->sacked;
+	int i, j;
+
+	for (i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block block = conn->recv_options.sack[i];
+
+		if (net_tcp_seq_cmp(block.left, ack) < 0) {
+			block.left = ack;
+		}
+
+		if (net_tcp_seq_cmp(block.right, end) > 0) {
+			block.right = end;
+		}
+
+		if (net_tcp_seq_cmp(block.right, block.left) <= 0) {
+			continue;
+		}
+
+		/* Find where the block goes, and drop the largest one if
+		 * the scoreboard is full.
+		 */
+		for (j = 0; j < conn->sacked_count; j++) {
+			if (net_tcp_seq_cmp(block.left, sacked[j].left) < 0) {
+				break;
+			}
+		}
+
+		if (conn->sacked_count == TCP_SACK_MAX_BLOCKS) {
+			if (j == TCP_SACK_MAX_BLOCKS) {
+				continue;
+			}
+
+			conn->sacked_count--;
+		}
+
+		memmove(&sacked[j + 1], &sacked[j],
+			(conn->sacked_count - j) * sizeof(sacked[0]));
+		sacked[j] = block;
+		conn->sacked_count++;
+	}
+
+	/* Coalesce the overlapping and adjacent blocks */
+	for (i = 0, j = 1; j < conn->sacked_count; j++) {
+		if (net_tcp_seq_cmp(sacked[j].left, sacked[i].right) <= 0) {
+			if (net_tcp_seq_cmp(sacked[j].right,
+					    sacked[i].right) > 0) {
+				sacked[i].right = sacked[j].right;
+			}
+		} else {
+			sacked[++i] = sacked[j];
+		}
+	}
+
+	if (conn->sacked_count) {
+		conn->sacked_count = i + 1;
+	}
+
+	/* Forget what the cumulative ack covers */
+	for (i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(sacked[i].right, ack) > 0) {
+			break;
+		}
+	}
+
+	if (i) {
+		memmove(sacked, &sacked[i],
+			(conn->sacked_count - i) * sizeof(sacked[0]));
+		conn->sacked_count -= i;
+	}
+
+	if (conn->sacked_count &&
+	    net_tcp_seq_cmp(sacked[0].left, ack) < 0) {
+		sacked[0].left = ack;
+	}
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* New data acknowledged, conn->seq is the ack received */
+static void tcp_ack_received(struct tcp *conn, uint32_t acked)
+{
+	uint32_t ack = conn->seq;
+
+	if (conn->rtt_pending && net_tcp_seq_cmp(ack, conn->rtt_seq) >= 0) {
+		conn->rtt_pending = false;
+		tcp_rtt_update(conn, k_uptime_get_32() - conn->rtt_start);
+	}
+
+	conn->dup_acks = 0;
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_cmp(ack, conn->recover) >= 0) {
+			NET_DBG("conn: %p fast recovery done", conn);
+
+			conn->in_recovery = false;
+
+			if (tcp_cc) {
+				tcp_cc->recovered(conn);
+			}
+		} else if (tcp_cc) {
+			tcp_cc->partial_ack(conn, acked);
+		}
+	} else if (tcp_cc) {
+		tcp_cc->ack(conn, acked);
+	}
+}
+
+/* An ack that does not acknowledge new data nor update the window, while
+ * we have data in flight: the peer got a segment beyond a missing one.
+ */
+static bool tcp_dup_ack(struct tcp *conn, struct tcphdr *th, size_t len,
+			uint16_t prev_send_win)
+{
+	return conn->data_mode == TCP_DATA_MODE_SEND &&
+		conn->unacked_len > 0 && len == 0 &&
+		th_ack(th) == conn->seq && conn->send_win == prev_send_win &&
+		(th_flags(th) & (SYN | FIN | RST | ACK)) == ACK;
+}
+
+/* Early retransmit, RFC 5827: with little data in flight and nothing new
+ * to send, fewer dup acks will ever come. A dup ack itself means that at
+ * least two segments were in flight, so one is always enough then.
+ */
+static uint8_t tcp_dup_ack_threshold(struct tcp *conn)
+{
+	uint16_t mss = tcp_send_mss(conn);
+	int segs;
+
+	if (conn->unacked_len >= 4 * mss ||
+	    (tcp_unsent_len(conn) > 0 && !tcp_window_full(conn))) {
+		return DUP_ACK_THRESHOLD;
+	}
+
+	segs = ceiling_fraction(conn->unacked_len, mss);
+
+	return CLAMP(segs - 1, 1, DUP_ACK_THRESHOLD);
+}
+
+/* How many segments the peer got beyond the missing data: one per dup
+ * ack, or more if SACK tells so, as the peer may ack several coalesced
+ * segments at once (RFC 6675 ch. 4).
+ */
+static int tcp_dup_segs(struct tcp *conn)
+{
+	int segs = conn->dup_acks;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint32_t sacked = 0;
+	int i;
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		sacked += conn->sacked[i].right - conn->sacked[i].left;
+	}
+
+	segs = MAX(segs, (int)ceiling_fraction(sacked, tcp_send_mss(conn)));
+#endif
+	return segs;
+}
+
+/* Fast retransmit and fast recovery, RFC 5681 ch. 3.2 and RFC 6582 */
+static int tcp_dup_ack_received(struct tcp *conn)
+{
+	if (conn->dup_acks < UINT8_MAX) {
+		conn->dup_acks++;
+	}
+
+	if (conn->in_recovery) {
+		if (tcp_cc) {
+			tcp_cc->dup_ack(conn);
+		}
+	} else if (tcp_dup_segs(conn) >= tcp_dup_ack_threshold(conn)) {
+		NET_DBG("conn: %p fast retransmit seq %u", conn, conn->seq);
+
+		conn->in_recovery = true;
+		conn->recover = conn->seq + conn->unacked_len;
+		conn->rexmit_next = conn->seq;
+		conn->rtt_pending = false;
+
+		if (tcp_cc) {
+			tcp_cc->loss(conn);
+		}
+	} else if (conn->dup_acks < DUP_ACK_THRESHOLD) {
+		return tcp_send_queued_data(conn);
+	} else {
+		return 0;
+	}
+
+	(void)tcp_send_lost(conn);
+
+	return tcp_send_queued_data(conn);
+}
+
 /* TCP state machine, everything happens here */
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -1630,6 +2157,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint16_t prev_send_win = 0;
 	size_t len;
 	int ret;
 
@@ -1661,6 +2189,13 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	/* Only forget what a segment tells about itself: the MSS and window
+	 * scale come in the SYN segments and hold for the whole connection.
+	 */
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_count = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -1672,6 +2207,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	if (th) {
 		size_t max_win;
 
+		prev_send_win = conn->send_win;
 		conn->send_win = ntohs(th_win(th));
 
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
@@ -1724,6 +2260,7 @@ next_state:
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
 			next = TCP_ESTABLISHED;
+			tcp_established(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 
@@ -1764,6 +2301,7 @@ next_state:
 			}
 
 			next = TCP_ESTABLISHED;
+			tcp_established(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 			tcp_out(conn, ACK);
@@ -1809,6 +2347,12 @@ next_state:
 			break;
 		}
 
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th && conn->sack_ok) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+#endif
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -1829,6 +2373,7 @@ next_state:
 			conn->send_data_total -= len_acked;
 			conn->unacked_len -= len_acked;
 			conn_seq(conn, + len_acked);
+			tcp_ack_received(conn, len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
 			conn_send_data_dump(conn);
@@ -1856,12 +2401,26 @@ next_state:
 				break;
 			}
 
+			/* A partial ack during fast recovery tells about
+			 * the next segment to resend.
+			 */
+			if (conn->in_recovery) {
+				(void)tcp_send_lost(conn);
+			}
+
 			ret = tcp_send_queued_data(conn);
 			if (ret < 0 && ret != -ENOBUFS) {
 				tcp_out(conn, RST);
 				conn_state(conn, TCP_CLOSED);
 				break;
 			}
+		} else if (th && tcp_dup_ack(conn, th, len, prev_send_win)) {
+			ret = tcp_dup_ack_received(conn);
+			if (ret < 0 && ret != -ENOBUFS) {
+				tcp_out(conn, RST);
+				conn_state(conn, TCP_CLOSED);
+				break;
+			}
 		}
 
 		if (th && len) {
@@ -1873,9 +2432,16 @@ next_state:
 				tcp_out(conn, ACK); /* peer has resent */
 
 				net_stats_update_tcp_seg_ackerr(conn->iface);
-			} else if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-				tcp_out_of_order_data(conn, pkt, len,
-						      th_seq(th));
+			} else {
+				if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+					tcp_out_of_order_data(conn, pkt, len,
+							      th_seq(th));
+				}
+
+				/* Ack right away, so that the peer learns
+				 * about the missing data (RFC 5681 ch. 4.2).
+				 */
+				tcp_out(conn, ACK);
 			}
 		}
 		break;
@@ -2383,7 +2949,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* Segments of a GSO packet get their own checksums */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -2396,7 +2964,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	struct net_tcp_hdr *tcp_hdr;
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
-			net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+			net_pkt_need_calc_rx_checksum(pkt) &&
 			net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
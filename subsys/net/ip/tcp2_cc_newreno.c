@@ -0,0 +1,112 @@
+/** @file
+ * @brief TCP NewReno congestion control
+ *
+ * Slow start and congestion avoidance from RFC 5681, using appropriate
+ * byte counting (RFC 3465) in slow start, and the fast recovery
+ * algorithm from RFC 6582.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+/* Without window scaling the peer never lets us have more in flight */
+#define NEWRENO_CWND_MAX (2 * UINT16_MAX)
+
+static uint32_t newreno_half_flight(struct tcp *conn)
+{
+	uint32_t mss = tcp_send_mss(conn);
+
+	return MAX((uint32_t)conn->unacked_len / 2, 2 * mss);
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	uint32_t mss = tcp_send_mss(conn);
+
+	/* Initial window, RFC 5681 ch. 3.1 */
+	if (mss > 2190) {
+		conn->cwnd = 2 * mss;
+	} else if (mss > 1095) {
+		conn->cwnd = 3 * mss;
+	} else {
+		conn->cwnd = 4 * mss;
+	}
+
+	conn->ssthresh = NEWRENO_CWND_MAX;
+}
+
+static void newreno_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = tcp_send_mss(conn);
+
+	if (conn->cwnd >= NEWRENO_CWND_MAX) {
+		return;
+	}
+
+	if (conn->cwnd < conn->ssthresh) {
+		conn->cwnd += MIN(acked, mss);
+	} else {
+		conn->cwnd += MAX(mss * mss / conn->cwnd, 1U);
+	}
+}
+
+static void newreno_loss(struct tcp *conn)
+{
+	conn->ssthresh = newreno_half_flight(conn);
+	conn->cwnd = conn->ssthresh + 3 * tcp_send_mss(conn);
+}
+
+static void newreno_dup_ack(struct tcp *conn)
+{
+	conn->cwnd += tcp_send_mss(conn);
+}
+
+static void newreno_partial_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = tcp_send_mss(conn);
+
+	/* Deflate by the amount of new data acknowledged, and add back
+	 * one segment if that was at least a full one.
+	 */
+	conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+
+	if (acked >= mss) {
+		conn->cwnd += mss;
+	}
+
+	conn->cwnd = MAX(conn->cwnd, mss);
+}
+
+static void newreno_recovered(struct tcp *conn)
+{
+	uint32_t mss = tcp_send_mss(conn);
+	uint32_t flight = conn->unacked_len;
+
+	/* Avoid a burst if little is left in flight, RFC 6582 ch. 3.2 */
+	conn->cwnd = MIN(conn->ssthresh, MAX(flight, mss) + mss);
+}
+
+static void newreno_timeout(struct tcp *conn)
+{
+	conn->ssthresh = newreno_half_flight(conn);
+	conn->cwnd = tcp_send_mss(conn);
+}
+
+const struct tcp_cc tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.ack = newreno_ack,
+	.loss = newreno_loss,
+	.dup_ack = newreno_dup_ack,
+	.partial_ack = newreno_partial_ack,
+	.recovered = newreno_recovered,
+	.timeout = newreno_timeout,
+};
@@ -141,6 +141,11 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+/* As many SACK blocks as fit in the 40 bytes of TCP options */
+#define TCP_SACK_MAX_BLOCKS 4
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -202,11 +207,21 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_count;
+	struct tcp_sack_block sack[TCP_SACK_MAX_BLOCKS];
+#endif
 };
 
 struct tcp { /* TCP connection */
@@ -249,12 +264,61 @@ struct tcp { /* TCP connection */
 	uint32_t ack;
 	uint16_t recv_win;
 	uint16_t send_win;
+	uint32_t cwnd;     /* congestion window */
+	uint32_t ssthresh; /* slow start threshold */
+	uint32_t recover;  /* end of the data sent when fast recovery began */
+	uint32_t rexmit_next; /* where to look for data to resend in recovery */
+	uint32_t rtt_seq;   /* end of the segment being timed */
+	uint32_t rtt_start; /* when it was sent, in ms */
+	uint32_t srtt;      /* smoothed round-trip time, in ms << 3 */
+	uint32_t rttvar;    /* round-trip time variation, in ms << 2 */
+	uint32_t rto;       /* retransmission timeout, in ms */
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Data the peer told to hold beyond the acknowledged data */
+	struct tcp_sack_block sacked[TCP_SACK_MAX_BLOCKS];
+	uint8_t sacked_count;
+#endif
 	uint8_t send_data_retries;
+	uint8_t dup_acks;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool in_recovery : 1;
+	bool rtt_pending : 1;
+	bool rtt_measured : 1;
+	bool sack_ok : 1;
 };
 
+/* Congestion control algorithm. The callbacks are called with the
+ * connection locked, and update conn->cwnd and conn->ssthresh. The
+ * amount of data in flight is conn->unacked_len.
+ */
+struct tcp_cc {
+	const char *name;
+	/* Connection established */
+	void (*init)(struct tcp *conn);
+	/* New data acknowledged, outside of fast recovery */
+	void (*ack)(struct tcp *conn, uint32_t acked);
+	/* Third duplicate ack, fast recovery begins */
+	void (*loss)(struct tcp *conn);
+	/* Another duplicate ack during fast recovery */
+	void (*dup_ack)(struct tcp *conn);
+	/* Some but not all of the data outstanding when the recovery
+	 * began is acknowledged.
+	 */
+	void (*partial_ack)(struct tcp *conn, uint32_t acked);
+	/* All of it is acknowledged, fast recovery is over */
+	void (*recovered)(struct tcp *conn);
+	/* Retransmission timeout */
+	void (*timeout)(struct tcp *conn);
+};
+
+#if defined(CONFIG_NET_TCP_CC_NEWRENO)
+extern const struct tcp_cc tcp_cc_newreno;
+#endif
+
+uint16_t tcp_send_mss(const struct tcp *conn);
+
 #define _flags(_fl, _op, _mask, _cond)					\
 ({									\
 	bool result = false;						\
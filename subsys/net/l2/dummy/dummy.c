@@ -45,9 +45,40 @@ static inline int dummy_send(struct net_if *iface, struct net_pkt *pkt)
 	return ret;
 }
 
+static void dummy_send_burst(struct net_if *iface, struct net_pkt **pkts,
+			     int *status, size_t count)
+{
+	const struct dummy_api *api = net_if_get_device(iface)->api;
+	size_t i;
+	int sent;
+
+	if (!api || !api->send_burst) {
+		for (i = 0; i < count; i++) {
+			status[i] = dummy_send(iface, pkts[i]);
+		}
+
+		return;
+	}
+
+	sent = net_l2_send_burst(api->send_burst, net_if_get_device(iface),
+				 iface, pkts, count);
+
+	for (i = 0; i < count; i++) {
+		if (sent < 0) {
+			status[i] = sent;
+		} else if (i < sent) {
+			status[i] = net_pkt_get_len(pkts[i]);
+			net_pkt_unref(pkts[i]);
+		} else {
+			status[i] = -EIO;
+		}
+	}
+}
+
 static enum net_l2_flags dummy_flags(struct net_if *iface)
 {
 	return NET_L2_MULTICAST;
 }
 
-NET_L2_INIT(DUMMY_L2, dummy_recv, dummy_send, NULL, dummy_flags);
+NET_L2_INIT_BURST(DUMMY_L2, dummy_recv, dummy_send, dummy_send_burst, NULL,
+		  dummy_flags);
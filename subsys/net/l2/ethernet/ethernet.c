@@ -566,18 +566,18 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
-static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+/* Add the link layer header. On success, *pkt is the packet to hand to the
+ * driver, which is an ARP request if the original one got queued waiting
+ * for the ARP reply.
+ */
+static int ethernet_prepare_send(struct net_if *iface,
+				 struct ethernet_context *ctx,
+				 struct net_pkt **pkt_ptr)
 {
-	const struct ethernet_api *api = net_if_get_device(iface)->api;
-	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct net_pkt *pkt = *pkt_ptr;
 	uint16_t ptype;
 	int ret;
 
-	if (!api) {
-		ret = -ENOENT;
-		goto error;
-	}
-
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
 		struct net_pkt *tmp;
@@ -594,6 +594,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 				 * by an ARP request packet.
 				 */
 				pkt = tmp;
+				*pkt_ptr = pkt;
 				ptype = htons(NET_ETH_PTYPE_ARP);
 				net_pkt_set_family(pkt, AF_INET);
 			} else {
@@ -625,7 +626,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 						sizeof(struct net_eth_addr);
 			ptype = dst_addr->sll_protocol;
 		} else {
-			goto send;
+			return 0;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_GPTP) && net_pkt_is_gptp(pkt)) {
 		ptype = htons(NET_ETH_PTYPE_PTP);
@@ -669,12 +670,19 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_cursor_init(pkt);
 
-send:
-	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+	return 0;
+
+error:
+	return ret;
+}
+
+/* Account for the outcome of handing a prepared packet to the driver */
+static int ethernet_sent(struct net_if *iface, struct net_pkt *pkt, int ret)
+{
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
 		ethernet_remove_l2_header(pkt);
-		goto error;
+		return ret;
 	}
 
 	ethernet_update_tx_stats(iface, pkt);
@@ -683,10 +691,87 @@ send:
 	ethernet_remove_l2_header(pkt);
 
 	net_pkt_unref(pkt);
-error:
+
 	return ret;
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	int ret;
+
+	if (!api) {
+		return -ENOENT;
+	}
+
+	ret = ethernet_prepare_send(iface, ctx, &pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+
+	return ethernet_sent(iface, pkt, ret);
+}
+
+#if defined(CONFIG_NET_TC_TX_BURST) && CONFIG_NET_TC_TX_BURST > 1
+static void ethernet_send_burst(struct net_if *iface, struct net_pkt **pkts,
+				int *status, size_t count)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct net_pkt *tx[CONFIG_NET_TC_TX_BURST];
+	uint8_t idx[CONFIG_NET_TC_TX_BURST];
+	size_t i, n = 0;
+	int sent;
+
+	if (!api || !api->send_burst) {
+		for (i = 0; i < count; i++) {
+			status[i] = ethernet_send(iface, pkts[i]);
+		}
+
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+
+		status[i] = ethernet_prepare_send(iface, ctx, &pkt);
+		if (status[i] < 0) {
+			continue;
+		}
+
+		tx[n] = pkt;
+		idx[n] = i;
+		n++;
+	}
+
+	if (n == 0) {
+		return;
+	}
+
+	sent = net_l2_send_burst(api->send_burst, net_if_get_device(iface),
+				 iface, tx, n);
+
+	for (i = 0; i < n; i++) {
+		int ret;
+
+		if (sent < 0) {
+			ret = sent;
+		} else if (i < sent) {
+			ret = 0;
+		} else {
+			ret = -EIO;
+		}
+
+		status[idx[i]] = ethernet_sent(iface, tx[i], ret);
+	}
+}
+#else
+#define ethernet_send_burst NULL
+#endif
+
 static inline int ethernet_enable(struct net_if *iface, bool state)
 {
 	const struct ethernet_api *eth =
@@ -999,8 +1084,8 @@ int net_eth_vlan_disable(struct net_if *iface, uint16_t tag)
 }
 #endif /* CONFIG_NET_VLAN */
 
-NET_L2_INIT(ETHERNET_L2, ethernet_recv, ethernet_send, ethernet_enable,
-	    ethernet_flags);
+NET_L2_INIT_BURST(ETHERNET_L2, ethernet_recv, ethernet_send,
+		  ethernet_send_burst, ethernet_enable, ethernet_flags);
 
 static void carrier_on_off(struct k_work *work)
 {
@@ -1135,6 +1220,30 @@ int net_eth_promisc_mode(struct net_if *iface, bool enable)
 			&params, sizeof(struct ethernet_req_params));
 }
 
+static uint8_t ethernet_hw_offloads(struct net_if *iface)
+{
+	enum ethernet_hw_caps caps = net_eth_get_hw_capabilities(iface);
+	uint8_t offloads = 0U;
+
+	if (caps & ETHERNET_HW_TX_CHKSUM_OFFLOAD) {
+		offloads |= NET_IF_OFFLOAD_TX_CHKSUM;
+	}
+
+	if (caps & ETHERNET_HW_RX_CHKSUM_OFFLOAD) {
+		offloads |= NET_IF_OFFLOAD_RX_CHKSUM;
+	}
+
+	if (caps & ETHERNET_HW_TSO) {
+		offloads |= NET_IF_OFFLOAD_TSO;
+	}
+
+	if (caps & ETHERNET_HW_LRO) {
+		offloads |= NET_IF_OFFLOAD_LRO;
+	}
+
+	return offloads;
+}
+
 void ethernet_init(struct net_if *iface)
 {
 	struct ethernet_context *ctx = net_if_l2_data(iface);
@@ -1153,6 +1262,9 @@ void ethernet_init(struct net_if *iface)
 		ctx->ethernet_l2_flags |= NET_L2_PROMISC_MODE;
 	}
 
+	net_if_set_offloads(iface, net_if_get_offloads(iface) |
+			    ethernet_hw_offloads(iface));
+
 #if defined(CONFIG_NET_VLAN)
 	if (!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_VLAN)) {
 		return;
@@ -7,6 +7,7 @@
 #ifndef ZEPHYR_POWER_PM_POLICY_H_
 #define ZEPHYR_POWER_PM_POLICY_H_
 
+#include <kernel.h>
 #include <pm/pm.h>
 
 #ifdef __cplusplus
@@ -38,6 +39,27 @@ void pm_resume_devices(void);
  */
 struct pm_state_info pm_policy_next_state(int32_t ticks);
 
+#ifdef CONFIG_IDLE_STATS
+/**
+ * @brief Function to get the average idle period of a CPU, in ticks
+ *
+ * Tells a policy how long idle periods have actually lasted, which
+ * may be much shorter than the next timeout when other interrupts
+ * wake the CPU up.
+ */
+static inline uint32_t pm_policy_avg_idle_ticks(int cpu)
+{
+	struct k_idle_stats stats;
+
+	if ((k_idle_stats_get(cpu, &stats) != 0) || (stats.wakeups == 0U)) {
+		return 0;
+	}
+
+	return k_cyc_to_ticks_floor32(
+		(uint32_t)(stats.residency_cycles / stats.wakeups));
+}
+#endif
+
 
 #ifdef __cplusplus
 }
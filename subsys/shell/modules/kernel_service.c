@@ -66,6 +66,9 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	k_thread_runtime_stats_t rt_stats_thread;
 	k_thread_runtime_stats_t rt_stats_all;
 #endif
+#ifdef CONFIG_SCHED_THREAD_STATS
+	k_thread_sched_stats_t sched_stats;
+#endif
 
 	tname = k_thread_name_get(thread);
 
@@ -116,6 +119,20 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+	if (k_thread_sched_stats_get(thread, &sched_stats) == 0) {
+		uint32_t n = MAX(sched_stats.wakeups, 1U);
+
+		shell_print(shell, "\twakeups: %u, preemptions: %u, "
+			    "ready cycles: %u",
+			    sched_stats.wakeups, sched_stats.preemptions,
+			    (uint32_t)sched_stats.ready_cycles);
+		shell_print(shell, "\twakeup latency cycles avg: %u, max: %u",
+			    (uint32_t)(sched_stats.total_latency_cycles / n),
+			    sched_stats.max_latency_cycles);
+	}
+#endif
+
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
 		shell_print(shell,
@@ -214,6 +231,87 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_WORKQUEUE_STATS)
+static void shell_workq_dump(struct k_work_q *queue,
+			     const struct k_work_queue_stats *stats,
+			     void *user_data)
+{
+	const struct shell *shell = (const struct shell *)user_data;
+	const char *tname = k_thread_name_get(k_work_queue_thread_get(queue));
+	uint32_t n = MAX(stats->executed, 1U);
+
+	shell_print(shell, "%p %-10s depth %u (max %u) executed %u", queue,
+		    tname ? tname : "NA", stats->depth, stats->max_depth,
+		    stats->executed);
+	shell_print(shell,
+		    "\twait avg %u us max %u us\trun avg %u us max %u us",
+		    k_cyc_to_us_floor32((uint32_t)(stats->total_wait_cycles / n)),
+		    k_cyc_to_us_floor32(stats->max_wait_cycles),
+		    k_cyc_to_us_floor32((uint32_t)(stats->total_run_cycles / n)),
+		    k_cyc_to_us_floor32(stats->max_run_cycles));
+}
+
+static int cmd_kernel_workq(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Work queues:");
+	k_work_queue_foreach(shell_workq_dump, (void *)shell);
+	return 0;
+}
+
+static void workq_reset(struct k_work_q *queue,
+			const struct k_work_queue_stats *stats,
+			void *user_data)
+{
+	k_work_queue_stats_reset(queue);
+}
+
+static int cmd_kernel_workq_reset(const struct shell *shell,
+				  size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_work_queue_foreach(workq_reset, NULL);
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_workq,
+	SHELL_CMD(reset, NULL, "Reset work queue statistics.",
+		  cmd_kernel_workq_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
+#if defined(CONFIG_IDLE_STATS)
+static int cmd_kernel_idle(const struct shell *shell,
+			   size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct k_idle_stats stats;
+		uint32_t avg;
+
+		(void)k_idle_stats_get(cpu, &stats);
+		avg = (uint32_t)(stats.residency_cycles /
+				 MAX(stats.wakeups, 1U));
+
+		shell_print(shell, "CPU %d wakeups %u idle %llu us (avg %u us)",
+			    cpu, stats.wakeups,
+			    (unsigned long long)k_cyc_to_us_floor64(
+				    stats.residency_cycles),
+			    k_cyc_to_us_floor32(avg));
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -248,6 +346,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_IDLE_STATS)
+	SHELL_CMD(idle, NULL, "CPU idle statistics.", cmd_kernel_idle),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
@@ -258,6 +359,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 	SHELL_CMD(uptime, NULL, "Kernel uptime.", cmd_kernel_uptime),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
+#if defined(CONFIG_WORKQUEUE_STATS)
+	SHELL_CMD(workq, &sub_kernel_workq, "Work queue statistics.",
+		  cmd_kernel_workq),
+#endif
 	SHELL_SUBCMD_SET_END /* Array terminated. */
 );
 
@@ -72,6 +72,7 @@ extern "C" {
 #define sys_port_trace_k_thread_sched_resume(thread)
 
 #define sys_port_trace_k_thread_sched_suspend(thread)
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)
 
 #define sys_port_trace_k_work_init(work)
 #define sys_port_trace_k_work_submit_to_queue_enter(queue, work)
@@ -168,6 +169,16 @@ extern "C" {
 #define sys_port_trace_k_condvar_wait_enter(condvar)
 #define sys_port_trace_k_condvar_wait_exit(condvar, ret)
 
+#define sys_port_trace_k_event_init(event)
+#define sys_port_trace_k_event_post_enter(event, events)
+#define sys_port_trace_k_event_post_exit(event, events)
+#define sys_port_trace_k_event_set_enter(event, events)
+#define sys_port_trace_k_event_set_exit(event, events)
+#define sys_port_trace_k_event_clear(event, events)
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_blocking(event, timeout)
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+
 #define sys_port_trace_k_queue_init(queue)
 #define sys_port_trace_k_queue_cancel_wait(queue)
 #define sys_port_trace_k_queue_queue_insert_enter(queue, alloc)
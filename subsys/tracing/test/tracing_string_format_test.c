@@ -70,6 +70,11 @@ void sys_trace_k_thread_sched_pend(struct k_thread *thread)
 	TRACING_STRING("%s: %p\n", __func__, thread);
 }
 
+void sys_trace_k_thread_sched_latency(struct k_thread *thread, uint32_t cycles)
+{
+	TRACING_STRING("%s: %p %u\n", __func__, thread, cycles);
+}
+
 void sys_trace_k_thread_sched_abort(struct k_thread *thread)
 {
 	TRACING_STRING("%s: %p\n", __func__, thread);
@@ -63,6 +63,8 @@
 #define sys_port_trace_k_thread_sched_pend(thread) sys_trace_k_thread_sched_pend(thread)
 #define sys_port_trace_k_thread_sched_resume(thread) sys_trace_k_thread_sched_resume(thread)
 #define sys_port_trace_k_thread_sched_suspend(thread) sys_trace_k_thread_sched_suspend(thread)
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)                                     \
+	sys_trace_k_thread_sched_latency(thread, cycles)
 
 #define sys_port_trace_k_work_init(work)
 #define sys_port_trace_k_work_submit_to_queue_enter(queue, work)
@@ -153,6 +155,16 @@
 #define sys_port_trace_k_condvar_wait_exit(condvar, ret)                                           \
 	sys_trace_k_condvar_wait_exit(condvar, mutex, timeout, ret)
 
+#define sys_port_trace_k_event_init(event)
+#define sys_port_trace_k_event_post_enter(event, events)
+#define sys_port_trace_k_event_post_exit(event, events)
+#define sys_port_trace_k_event_set_enter(event, events)
+#define sys_port_trace_k_event_set_exit(event, events)
+#define sys_port_trace_k_event_clear(event, events)
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_blocking(event, timeout)
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+
 #define sys_port_trace_k_queue_init(queue) sys_trace_k_queue_init(queue)
 #define sys_port_trace_k_queue_cancel_wait(queue) sys_trace_k_queue_cancel_wait(queue)
 #define sys_port_trace_k_queue_queue_insert_enter(queue, alloc)                                    \
@@ -443,6 +455,7 @@ void sys_trace_k_thread_sched_ready(struct k_thread *thread);
 void sys_trace_k_thread_sched_pend(struct k_thread *thread);
 void sys_trace_k_thread_sched_resume(struct k_thread *thread);
 void sys_trace_k_thread_sched_suspend(struct k_thread *thread);
+void sys_trace_k_thread_sched_latency(struct k_thread *thread, uint32_t cycles);
 
 void sys_trace_k_thread_foreach_enter(k_thread_user_cb_t user_cb, void *user_data);
 void sys_trace_k_thread_foreach_exit(k_thread_user_cb_t user_cb, void *user_data);
@@ -16,6 +16,7 @@
 #include <x86_mmu.h>
 #include <linker/linker-defs.h>
 #include <mmu.h>
+#include <kernel_arch_interface.h>
 #include "main.h"
 
 #ifdef CONFIG_X86_64
@@ -240,11 +241,68 @@ void test_dump_ptables(void)
 #endif
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+/* Physical address range which is mapped but never accessed */
+#define LARGE_PAGE_PHYS		0xC0000000UL
+
+static void check_mapping(uint8_t *base, size_t offset, int expect_level)
+{
+	pentry_t entry;
+	uintptr_t phys;
+	int level;
+
+	z_x86_pentry_get(&level, &entry, z_x86_page_tables_get(),
+			 base + offset);
+	zassert_equal(level, expect_level, "unexpected level %d at %p",
+		      level, base + offset);
+	zassert_true((entry & MMU_P) != 0, "non-present entry");
+	zassert_equal(arch_page_phys_get(base + offset, &phys), 0, NULL);
+	zassert_equal(phys, LARGE_PAGE_PHYS + offset,
+		      "bad physical address 0x%lx", phys);
+}
+#endif
+
+/**
+ * Test that a large aligned mapping is made with a large page, which is
+ * split into 4K pages when part of it is unmapped
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_large_page(void)
+{
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+	uint8_t *virt;
+	pentry_t entry;
+	int level;
+
+	z_phys_map(&virt, LARGE_PAGE_PHYS, CONFIG_MMU_LARGE_PAGE_SIZE,
+		   K_MEM_CACHE_NONE);
+	zassert_equal(POINTER_TO_UINT(virt) % CONFIG_MMU_LARGE_PAGE_SIZE, 0,
+		      "virtual region %p not aligned", virt);
+	check_mapping(virt, CONFIG_MMU_PAGE_SIZE, PT_LEVEL - 1);
+
+	arch_mem_unmap(virt + CONFIG_MMU_PAGE_SIZE, CONFIG_MMU_PAGE_SIZE);
+
+	z_x86_pentry_get(&level, &entry, z_x86_page_tables_get(),
+			 virt + CONFIG_MMU_PAGE_SIZE);
+	zassert_equal(level, PT_LEVEL, "large page not split");
+	zassert_equal(entry, 0, "page still mapped");
+	check_mapping(virt, 0, PT_LEVEL);
+	check_mapping(virt, CONFIG_MMU_LARGE_PAGE_SIZE - CONFIG_MMU_PAGE_SIZE,
+		      PT_LEVEL);
+
+	z_phys_unmap(virt, CONFIG_MMU_LARGE_PAGE_SIZE);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(x86_pagetables,
 			 ztest_unit_test(test_ram_perms),
 			 ztest_unit_test(test_null_map),
+			 ztest_unit_test(test_large_page),
 			 ztest_unit_test(test_dump_ptables),
 			 ztest_user_unit_test(test_dump_ptables)
 			 );
@@ -43,6 +43,13 @@
 	     (1000.0 * putsize) / SAFE_DIVISOR(puttime[1]),           \
 	     (1000.0 * putsize) / SAFE_DIVISOR(puttime[2]))
 
+#define PRINT_CLAIM() \
+	PRINT_F(output_file,						\
+	     "|%5u|%5u|       n/a|%10.3f|%10.3f|       n/a|%10.3f|%10.3f|\n", \
+	     putsize, putsize, puttime[1] / 1000.0, puttime[2] / 1000.0, \
+	     (1000.0 * putsize) / SAFE_DIVISOR(puttime[1]),               \
+	     (1000.0 * putsize) / SAFE_DIVISOR(puttime[2]))
+
 #else
 #define PRINT_ALL_TO_N_HEADER_UNIT()                                       \
 	PRINT_STRING("|   size(B) |       time/packet (nsec)       |         "\
@@ -75,6 +82,13 @@
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[0])), \
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[1])), \
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[2])))
+
+#define PRINT_CLAIM() \
+	PRINT_F(output_file,                                                 \
+	     "|%5u|%5u|       n/a|%10u|%10u|       n/a|%10u|%10u|\n",       \
+	     putsize, putsize, puttime[1], puttime[2],                    \
+	     (1000000 * putsize) / SAFE_DIVISOR(puttime[1]),              \
+	     (1000000 * putsize) / SAFE_DIVISOR(puttime[2]))
 #endif /* FLOAT */
 
 /*
@@ -82,6 +96,7 @@
  */
 int pipeput(struct k_pipe *pipe, enum pipe_options
 		 option, int size, int count, uint32_t *time);
+int pipeput_claim(struct k_pipe *pipe, int size, int count, uint32_t *time);
 
 /*
  * Function declarations.
@@ -178,6 +193,31 @@ void pipe_test(void)
 		PRINT_STRING(dashline, output_file);
 		k_thread_priority_set(k_current_get(), TaskPrio);
 	}
+
+	/* buffered operation, in place (claim/commit) */
+	PRINT_STRING("|                    "
+				 "zero copy claim/commit (_ALL_N)"
+			 "                          |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+	PRINT_ALL_TO_N_HEADER_UNIT();
+	PRINT_STRING(dashline, output_file);
+	PRINT_STRING("| put | get |  no buf  | small buf| big buf  |"
+			 "  no buf  | small buf| big buf  |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+
+	for (putsize = 8U; putsize <= MESSAGE_SIZE_PIPE; putsize <<= 1) {
+		/* unbuffered pipes have nothing to claim */
+		for (pipe = 1; pipe < 3; pipe++) {
+			putcount = NR_OF_PIPE_RUNS;
+			pipeput_claim(test_pipes[pipe], putsize, putcount,
+				      &puttime[pipe]);
+
+			/* waiting for ack */
+			k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+		}
+		PRINT_CLAIM();
+	}
+	PRINT_STRING(dashline, output_file);
 }
 
 
@@ -252,4 +292,62 @@ int pipeput(struct k_pipe *pipe,
 	return 0;
 }
 
+/**
+ *
+ * @brief Write data to the pipe in place and measure time
+ *
+ * Each chunk is produced straight into the pipe's buffer through
+ * k_pipe_put_claim()/k_pipe_put_commit() instead of being copied in by
+ * k_pipe_put().
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     The pipe to be tested.
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total write time.
+ */
+int pipeput_claim(struct k_pipe *pipe, int size, int count, uint32_t *time)
+{
+	int i;
+	unsigned int t;
+	uint8_t *buf;
+
+	/* first sync with the receiver */
+	k_sem_give(&SEM0);
+	t = BENCH_START();
+	for (i = 0; i < count; i++) {
+		int sizexferd = 0;
+
+		/* a chunk may take two claims when the buffer wraps */
+		while (sizexferd < size) {
+			int ret = k_pipe_put_claim(pipe, &buf,
+						   size - sizexferd,
+						   K_FOREVER);
+
+			if (ret < 0) {
+				return 1;
+			}
+			(void)memcpy(buf, data_bench + sizexferd, ret);
+			(void)k_pipe_put_commit(pipe, ret);
+			sizexferd += ret;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow."
+					"Results are invalid            ",
+						 output_file);
+		} else {
+	PRINT_STRING("| Tick occurred. Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n", output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
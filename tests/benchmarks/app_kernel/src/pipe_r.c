@@ -17,6 +17,8 @@
  */
 int pipeget(struct k_pipe *pipe, enum pipe_options option,
 			int size, int count, unsigned int *time);
+int pipeget_claim(struct k_pipe *pipe, int size, int count,
+		  unsigned int *time);
 
 /*
  * Function declarations.
@@ -71,6 +73,19 @@ void piperecvtask(void)
 	}
 	}
 
+	/* in place (claim/commit), buffered pipes only */
+	for (getsize = 8; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 1) {
+		for (pipe = 1; pipe < 3; pipe++) {
+			getcount = NR_OF_PIPE_RUNS;
+			pipeget_claim(test_pipes[pipe], getsize, getcount,
+				      &gettime);
+			getinfo.time = gettime;
+			getinfo.size = getsize;
+			getinfo.count = getcount;
+			/* acknowledge to master */
+			k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+		}
+	}
 }
 
 
@@ -141,4 +156,62 @@ int pipeget(struct k_pipe *pipe, enum pipe_options option, int size, int count,
 	return 0;
 }
 
+/**
+ *
+ * @brief Read data from the pipe in place and measure time
+ *
+ * Each chunk is consumed straight from the pipe's buffer through
+ * k_pipe_get_claim()/k_pipe_get_finish(), without copying it out.
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     Pipe to read data from.
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total read time.
+ */
+int pipeget_claim(struct k_pipe *pipe, int size, int count,
+		  unsigned int *time)
+{
+	int i;
+	unsigned int t;
+	uint8_t *buf;
+
+	/* sync with the sender */
+	k_sem_take(&SEM0, K_FOREVER);
+	t = BENCH_START();
+	for (i = 0; i < count; i++) {
+		int sizexferd = 0;
+
+		while (sizexferd < size) {
+			int ret = k_pipe_get_claim(pipe, &buf,
+						   size - sizexferd,
+						   K_FOREVER);
+
+			if (ret < 0) {
+				return 1;
+			}
+			(void)k_pipe_get_finish(pipe, ret);
+			sizexferd += ret;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow. "
+			"Results are invalid            ",
+						 output_file);
+		} else {
+			PRINT_STRING("| Tick occurred. "
+			"Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n",
+					 output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
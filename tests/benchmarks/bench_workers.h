@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Worker pool shared by the kernel object contention benchmarks.
+ *
+ * bench_workers_run() starts a number of workers below the priority of
+ * the calling thread, so that the caller only runs again once they have
+ * all exited, and returns the cycles elapsed in between.
+ */
+
+#include <zephyr.h>
+
+#define BENCH_MAX_THREADS 4
+#define BENCH_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_MAX_THREADS,
+				   BENCH_STACK_SIZE);
+static struct k_thread bench_threads[BENCH_MAX_THREADS];
+
+/* Worker counts each benchmark reports a line for */
+static const int bench_thread_counts[] = { 1, 2, BENCH_MAX_THREADS };
+
+/* Call once from main before the first run */
+static inline void bench_workers_init(void)
+{
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+}
+
+/* Runs @n instances of @entry, passing each its index as first and @arg
+ * as second parameter, and returns the cycles until the last exited
+ */
+static inline uint32_t bench_workers_run(int n, k_thread_entry_t entry,
+					 void *arg)
+{
+	uint32_t start = k_cycle_get_32();
+
+	__ASSERT_NO_MSG(n <= BENCH_MAX_THREADS);
+
+	for (int i = 0; i < n; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i],
+				BENCH_STACK_SIZE, entry, INT_TO_POINTER(i),
+				arg, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+	}
+
+	return k_cycle_get_32() - start;
+}
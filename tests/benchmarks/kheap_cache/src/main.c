@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "../../bench_workers.h"
+
+/* This benchmark measures the cost of small k_heap_alloc() and
+ * k_heap_free() calls on a heap used by several threads at once, and
+ * how many of them the CONFIG_K_HEAP_CACHE magazines serve without
+ * taking the heap lock.  Block sizes are spread over MIN_SIZE..MAX_SIZE,
+ * which covers the four size classes cached by default, and workers
+ * yield after each batch of BATCH blocks so that they also interleave
+ * on one CPU.
+ */
+
+#define ROUNDS 2000
+#define BATCH 8
+#define MIN_SIZE 8
+#define MAX_SIZE 128
+
+#define HEAP_SIZE (BENCH_MAX_THREADS * BATCH * (MAX_SIZE + 16) * 2)
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+
+static atomic_t alloc_failures;
+
+static uint32_t rand32(uint32_t *state)
+{
+	/* xorshift32: cheap and deterministic across runs */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	uint32_t seed = 2463534242U + POINTER_TO_UINT(p1);
+	void *blocks[BATCH];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < BATCH; i++) {
+			size_t sz = MIN_SIZE +
+				rand32(&seed) % (MAX_SIZE - MIN_SIZE + 1);
+
+			blocks[i] = k_heap_alloc(&bench_heap, sz, K_NO_WAIT);
+			if (blocks[i] == NULL) {
+				atomic_inc(&alloc_failures);
+				continue;
+			}
+			*(volatile uint8_t *)blocks[i] = (uint8_t)i;
+		}
+		for (int i = 0; i < BATCH; i++) {
+			k_heap_free(&bench_heap, blocks[i]);
+		}
+		k_yield();
+	}
+}
+
+static unsigned int hit_rate(void)
+{
+#ifdef CONFIG_K_HEAP_CACHE
+	static struct k_heap_cache_stats last;
+	struct k_heap_cache_stats now;
+	uint32_t hits, total;
+
+	k_heap_cache_stats_get(&bench_heap, &now);
+	hits = now.hits - last.hits;
+	total = hits + (now.misses - last.misses);
+	last = now;
+
+	return total != 0U ? (uint32_t)(100ULL * hits / total) : 0U;
+#else
+	return 0U;
+#endif
+}
+
+static void run(int n)
+{
+	uint32_t cycles, ops = 2U * n * ROUNDS * BATCH;
+
+	cycles = bench_workers_run(n, worker, NULL);
+
+	printk("threads %d ops %u cycles/op %u hit rate %u%%\n",
+	       n, ops, cycles / ops, hit_rate());
+}
+
+void main(void)
+{
+	bench_workers_init();
+
+	for (int i = 0; i < ARRAY_SIZE(bench_thread_counts); i++) {
+		run(bench_thread_counts[i]);
+	}
+
+	if (atomic_get(&alloc_failures) != 0) {
+		printk("%d allocations failed, results invalid\n",
+		       (int)atomic_get(&alloc_failures));
+	}
+
+	printk("fin\n");
+}
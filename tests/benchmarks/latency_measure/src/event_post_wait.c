@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for event post and wait
+ *
+ * This file contains the tests that measure the time to post events to a
+ * k_event and to wait for any of them, both without contention and with a
+ * context switch to the waiting thread. The same measurements are taken for
+ * the emulation of an event object with k_poll() on one k_poll_signal per
+ * event bit, which is how "wait for any of N events" used to be written.
+ */
+
+#include <zephyr.h>
+#include <timing/timing.h>
+#include "utils.h"
+
+/* the number of post/wait cycles */
+#define N_TEST_EVENT 1000
+
+/* the number of event bits the waiter is interested in */
+#define N_EVENT_BITS 8
+#define EVENT_MASK   BIT_MASK(N_EVENT_BITS)
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+/* stack used by the threads */
+static K_THREAD_STACK_DEFINE(thread_event_stack, STACK_SIZE);
+
+static struct k_thread thread_event_data;
+
+K_EVENT_DEFINE(event_bench);
+
+static struct k_poll_signal poll_signals[N_EVENT_BITS];
+static struct k_poll_event poll_events[N_EVENT_BITS];
+
+static timing_t timestamp_start_wait;
+static timing_t timestamp_end_wait;
+static timing_t timestamp_start_post;
+static timing_t timestamp_end_post;
+
+static void thread_event_wait(void *p1, void *p2, void *p3)
+{
+	timestamp_start_wait = timing_counter_get();
+	k_event_wait(&event_bench, EVENT_MASK, true, K_FOREVER);
+	timestamp_end_post = timing_counter_get();
+}
+
+static void thread_poll_wait(void *p1, void *p2, void *p3)
+{
+	timestamp_start_wait = timing_counter_get();
+	k_poll(poll_events, N_EVENT_BITS, K_FOREVER);
+	timestamp_end_post = timing_counter_get();
+}
+
+static void poll_events_init(void)
+{
+	for (int i = 0; i < N_EVENT_BITS; i++) {
+		k_poll_signal_init(&poll_signals[i]);
+		k_poll_event_init(&poll_events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &poll_signals[i]);
+	}
+}
+
+/**
+ *
+ * @brief Measure the time to wake a thread waiting for any of 8 events
+ *
+ * The waiter runs at a higher priority, so it pends right after it is
+ * started and runs again as soon as the event is delivered.
+ *
+ * @param poll  Wait with k_poll() on signals instead of on a k_event.
+ */
+static void event_context_switch(bool poll)
+{
+	uint32_t diff;
+
+	bench_test_start();
+	timing_start();
+
+	k_thread_create(&thread_event_data, thread_event_stack,
+			STACK_SIZE, poll ? thread_poll_wait : thread_event_wait,
+			NULL, NULL, NULL,
+			K_PRIO_PREEMPT(3), 0, K_FOREVER);
+	k_thread_name_set(&thread_event_data, "event_wait");
+	k_thread_start(&thread_event_data);
+
+	timestamp_end_wait = timing_counter_get();
+	diff = timing_cycles_get(&timestamp_start_wait, &timestamp_end_wait);
+	if (poll) {
+		PRINT_STATS("Poll wait time on 8 signals (context switch)",
+			    diff);
+	} else {
+		PRINT_STATS("Event wait time on 8 events (context switch)",
+			    diff);
+	}
+
+	/* deliver the last of the 8 bits, the worst case for k_poll() */
+	timestamp_start_post = timing_counter_get();
+	if (poll) {
+		k_poll_signal_raise(&poll_signals[N_EVENT_BITS - 1], 0);
+	} else {
+		k_event_post(&event_bench, BIT(N_EVENT_BITS - 1));
+	}
+	diff = timing_cycles_get(&timestamp_start_post, &timestamp_end_post);
+	if (poll) {
+		PRINT_STATS("Poll signal raise time (context switch)", diff);
+	} else {
+		PRINT_STATS("Event post time (context switch)", diff);
+	}
+
+	timing_stop();
+	k_thread_join(&thread_event_data, K_FOREVER);
+}
+
+/**
+ *
+ * @brief The function tests event post and wait time
+ *
+ * The routine measures the average time to post an event and to wait for
+ * any of 8 events once one of them has been posted, first with a k_event
+ * and then with k_poll() on 8 signals, and then the same with a context
+ * switch to the waiting thread.
+ *
+ * @return 0 on success
+ */
+int event_post_wait(void)
+{
+	int i;
+	uint32_t diff;
+	timing_t timestamp_start;
+	timing_t timestamp_end;
+
+	bench_test_start();
+	timing_start();
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_EVENT; i++) {
+		k_event_post(&event_bench, BIT(i % N_EVENT_BITS));
+	}
+
+	timestamp_end = timing_counter_get();
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+		PRINT_STATS_AVG("Average event post time", diff, N_TEST_EVENT);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	bench_test_start();
+	timing_start();
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_EVENT; i++) {
+		k_event_wait(&event_bench, EVENT_MASK, false, K_FOREVER);
+	}
+
+	timestamp_end = timing_counter_get();
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+		PRINT_STATS_AVG("Average event wait time on 8 events", diff,
+				N_TEST_EVENT);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	poll_events_init();
+
+	bench_test_start();
+	timing_start();
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_EVENT; i++) {
+		k_poll_signal_raise(&poll_signals[i % N_EVENT_BITS], 0);
+	}
+
+	timestamp_end = timing_counter_get();
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+		PRINT_STATS_AVG("Average poll signal raise time", diff,
+				N_TEST_EVENT);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	bench_test_start();
+	timing_start();
+
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_EVENT; i++) {
+		k_poll(poll_events, N_EVENT_BITS, K_FOREVER);
+	}
+
+	timestamp_end = timing_counter_get();
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+		PRINT_STATS_AVG("Average poll wait time on 8 signals", diff,
+				N_TEST_EVENT);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	k_event_set(&event_bench, 0);
+	event_context_switch(false);
+
+	poll_events_init();
+	event_context_switch(true);
+
+	return 0;
+}
@@ -28,6 +28,8 @@ extern int sema_test(void);
 extern int sema_context_switch(void);
 extern int suspend_resume(void);
 extern void heap_malloc_free(void);
+extern int event_post_wait(void);
+extern int user_syscall(void);
 
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
@@ -58,6 +60,10 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	mutex_lock_unlock();
 
+	event_post_wait();
+
+	user_syscall();
+
 	heap_malloc_free();
 
 	TC_END_REPORT(error_count);
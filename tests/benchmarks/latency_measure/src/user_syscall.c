@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for system calls made from user mode
+ *
+ * This file contains the tests that measure the time a user mode thread
+ * needs to signal and test a semaphore and to put a message to and get it
+ * back from a message queue, to compare them with the same operations
+ * made from supervisor mode.  Reading the timer may be privileged, so the
+ * supervisor thread times the whole run of a higher priority user thread
+ * doing the operations in a loop, and subtracts the time of a run that
+ * does nothing.
+ */
+
+#include <zephyr.h>
+#include <timing/timing.h>
+#include "utils.h"
+
+#ifdef CONFIG_USERSPACE
+
+/* the number of system calls of each kind */
+#define N_TEST_SYSCALL 1000
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+/* stack used by the user thread */
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+
+static struct k_thread user_data;
+
+K_SEM_DEFINE(user_sem, 0, N_TEST_SYSCALL);
+K_MSGQ_DEFINE(user_msgq, sizeof(uint32_t), 1, 4);
+
+enum user_op {
+	USER_NOP,
+	USER_SEM_GIVE,
+	USER_SEM_TAKE,
+	USER_MSGQ_PUT_GET,
+};
+
+static void user_thread(void *p1, void *p2, void *p3)
+{
+	enum user_op op = POINTER_TO_INT(p1);
+	int n = POINTER_TO_INT(p2);
+	uint32_t msg = 0;
+
+	for (int i = 0; i < n; i++) {
+		switch (op) {
+		case USER_SEM_GIVE:
+			k_sem_give(&user_sem);
+			break;
+		case USER_SEM_TAKE:
+			k_sem_take(&user_sem, K_FOREVER);
+			break;
+		case USER_MSGQ_PUT_GET:
+			k_msgq_put(&user_msgq, &msg, K_NO_WAIT);
+			k_msgq_get(&user_msgq, &msg, K_NO_WAIT);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/* Time from starting a user thread running @p n operations @p op until
+ * it exits
+ */
+static uint32_t user_run(enum user_op op, int n)
+{
+	timing_t timestamp_start;
+	timing_t timestamp_end;
+
+	k_thread_create(&user_data, user_stack, STACK_SIZE, user_thread,
+			INT_TO_POINTER(op), INT_TO_POINTER(n), NULL,
+			K_PRIO_PREEMPT(3), K_USER, K_FOREVER);
+	k_object_access_grant(&user_sem, &user_data);
+	k_object_access_grant(&user_msgq, &user_data);
+
+	timestamp_start = timing_counter_get();
+	k_thread_start(&user_data);
+	timestamp_end = timing_counter_get();
+
+	k_thread_join(&user_data, K_FOREVER);
+
+	return timing_cycles_get(&timestamp_start, &timestamp_end);
+}
+
+static void user_measure(const char *name, enum user_op op)
+{
+	uint32_t base, diff;
+
+	bench_test_start();
+	timing_start();
+
+	base = user_run(USER_NOP, N_TEST_SYSCALL);
+	diff = user_run(op, N_TEST_SYSCALL);
+
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		diff = (diff > base) ? (diff - base) : 0;
+		PRINT_STATS_AVG(name, diff, N_TEST_SYSCALL);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+}
+
+#ifdef CONFIG_SYSCALL_STATS
+static void syscall_stats_print(uint32_t id)
+{
+	struct k_syscall_stats stats;
+	const char *name;
+
+	if ((k_syscall_stats_get(id, &stats, &name) == 0) &&
+	    (stats.count != 0U)) {
+		printk("Syscall %-20s: %6u calls, %8u handler cycles avg\n",
+		       name, stats.count, (uint32_t)(stats.cycles / stats.count));
+	}
+}
+#endif
+
+/**
+ *
+ * @brief Measure semaphore and message queue system calls from user mode
+ *
+ * @return 0 on success
+ */
+int user_syscall(void)
+{
+#ifdef CONFIG_SYSCALL_STATS
+	k_syscall_stats_reset();
+#endif
+
+	user_measure("Average user mode semaphore signal time",
+		     USER_SEM_GIVE);
+	user_measure("Average user mode semaphore test time",
+		     USER_SEM_TAKE);
+	user_measure("Average user mode message queue put and get time",
+		     USER_MSGQ_PUT_GET);
+
+#ifdef CONFIG_SYSCALL_STATS
+	syscall_stats_print(K_SYSCALL_K_SEM_GIVE);
+	syscall_stats_print(K_SYSCALL_K_SEM_TAKE);
+	syscall_stats_print(K_SYSCALL_K_MSGQ_PUT);
+	syscall_stats_print(K_SYSCALL_K_MSGQ_GET);
+#endif
+
+	return 0;
+}
+
+#else
+
+int user_syscall(void)
+{
+	return 0;
+}
+
+#endif /* CONFIG_USERSPACE */
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include "../../bench_workers.h"
+
+/* This benchmark measures k_mem_slab alloc/free throughput when, like
+ * network buffers, blocks are often freed on another CPU than the one
+ * that allocated them.  Every other burst is handed to the next worker
+ * to free, so the CONFIG_MEM_SLAB_CPU_CACHE caches keep overflowing to
+ * and refilling from the shared free list rather than only recycling
+ * their own blocks.  The slab statistics printed after each run show
+ * whether block accounting survived the migration.
+ */
+
+#define ROUNDS 2000
+#define BURST 8
+#define BLOCK_SIZE 64
+
+/* Each worker holds at most its own burst plus the one handed over */
+#define NUM_BLOCKS (BENCH_MAX_THREADS * BURST * 2)
+
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+
+/* One slot per worker, holding a burst handed over by the previous one */
+static struct {
+	struct k_spinlock lock;
+	void *blocks[BURST];
+	bool full;
+} mailbox[BENCH_MAX_THREADS];
+
+static atomic_t alloc_failures;
+
+static void free_burst(void **blocks)
+{
+	for (int i = 0; i < BURST; i++) {
+		if (blocks[i] != NULL) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+	}
+}
+
+/* Leaves our burst in the next worker's slot if it is empty, else
+ * frees it locally; then frees whatever was left in our own slot
+ */
+static void hand_over(int id, int n, void **blocks)
+{
+	int next = (id + 1) % n;
+	k_spinlock_key_t key = k_spin_lock(&mailbox[next].lock);
+	bool given = !mailbox[next].full;
+	void *mine[BURST];
+	bool got;
+
+	if (given) {
+		memcpy(mailbox[next].blocks, blocks, sizeof(mine));
+		mailbox[next].full = true;
+	}
+	k_spin_unlock(&mailbox[next].lock, key);
+	if (!given) {
+		free_burst(blocks);
+	}
+
+	key = k_spin_lock(&mailbox[id].lock);
+	got = mailbox[id].full;
+	if (got) {
+		memcpy(mine, mailbox[id].blocks, sizeof(mine));
+		mailbox[id].full = false;
+	}
+	k_spin_unlock(&mailbox[id].lock, key);
+	if (got) {
+		free_burst(mine);
+	}
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	int n = POINTER_TO_INT(p2);
+	void *blocks[BURST];
+
+	ARG_UNUSED(p3);
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < BURST; i++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[i],
+					     K_NO_WAIT) != 0) {
+				atomic_inc(&alloc_failures);
+				blocks[i] = NULL;
+				continue;
+			}
+			*(volatile uint8_t *)blocks[i] = (uint8_t)i;
+		}
+
+		if ((r & 1) != 0) {
+			hand_over(id, n, blocks);
+		} else {
+			free_burst(blocks);
+		}
+		k_yield();
+	}
+}
+
+static void run(int n)
+{
+	uint32_t cycles, ops = 2U * n * ROUNDS * BURST;
+
+	cycles = bench_workers_run(n, worker, INT_TO_POINTER(n));
+
+	/* Bursts nobody picked up before exiting */
+	for (int i = 0; i < n; i++) {
+		if (mailbox[i].full) {
+			free_burst(mailbox[i].blocks);
+			mailbox[i].full = false;
+		}
+	}
+
+	printk("threads %d ops %u cycles/op %u used %u max used %u\n",
+	       n, ops, cycles / ops, k_mem_slab_num_used_get(&bench_slab),
+	       k_mem_slab_max_used_get(&bench_slab));
+}
+
+void main(void)
+{
+	bench_workers_init();
+
+	for (int i = 0; i < ARRAY_SIZE(bench_thread_counts); i++) {
+		run(bench_thread_counts[i]);
+	}
+
+	if (atomic_get(&alloc_failures) != 0) {
+		printk("%d allocations failed, results invalid\n",
+		       (int)atomic_get(&alloc_failures));
+	}
+
+	printk("fin\n");
+}
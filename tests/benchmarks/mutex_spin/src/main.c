@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "../../bench_workers.h"
+
+/* This benchmark measures what a k_mutex costs per lock/unlock pair
+ * when threads on different CPUs contend for it, as a function of the
+ * critical section length.  Workers spend as long outside the mutex as
+ * inside, so a waiter usually arrives while the owner is running and
+ * about to release it: the case where CONFIG_MUTEX_ADAPTIVE_SPIN spins
+ * instead of paying two context switches.  A counter updated under the
+ * mutex catches lost updates.
+ */
+
+#define ROUNDS 2000
+
+K_MUTEX_DEFINE(bench_mutex);
+
+/* Loop iterations of the critical section (and of the work outside) */
+static const int cs_lengths[] = { 16, 256 };
+
+static volatile uint32_t shared[8];
+static uint32_t total;
+
+static void work(int len)
+{
+	for (int i = 0; i < len; i++) {
+		shared[i & 7]++;
+	}
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	int len = POINTER_TO_INT(p2);
+	volatile uint32_t local[8] = { 0 };
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p3);
+
+	for (int r = 0; r < ROUNDS; r++) {
+		k_mutex_lock(&bench_mutex, K_FOREVER);
+		work(len);
+		total++;
+		k_mutex_unlock(&bench_mutex);
+
+		for (int i = 0; i < len; i++) {
+			local[i & 7] += i;
+		}
+	}
+}
+
+static void run(int n, int len)
+{
+	uint32_t cycles, ops = n * ROUNDS;
+
+	total = 0;
+	cycles = bench_workers_run(n, worker, INT_TO_POINTER(len));
+
+	if (total != ops) {
+		printk("lost updates: %u of %u\n", total, ops);
+	}
+
+	printk("threads %d cs %d ops %u cycles/op %u\n",
+	       n, len, ops, cycles / ops);
+}
+
+void main(void)
+{
+	bench_workers_init();
+
+	for (int l = 0; l < ARRAY_SIZE(cs_lengths); l++) {
+		for (int i = 0; i < ARRAY_SIZE(bench_thread_counts); i++) {
+			run(bench_thread_counts[i], cs_lengths[l]);
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/net_context.h>
+#include <net/net_pkt.h>
+
+/* This is a packet throughput benchmark.  It measures how fast UDP
+ * packets go down the stack, through the loopback driver and up the
+ * stack again, when the TX thread hands them to the driver one by one
+ * or in bursts:
+ *
+ * 1. Bind a receiving UDP context to the loopback interface address,
+ *    and a sending one to another port of the same address.
+ * 2. Send N_PKTS packets to an address routed out of the loopback
+ *    interface, in rounds queued back to back with the scheduler
+ *    locked, and convert the time until all of them are received into
+ *    packets per second.  A packet lost or received with other data
+ *    fails the benchmark.
+ */
+
+#define N_PKTS 4096
+#define PAYLOAD_LEN 64
+
+#define RX_PORT 4242
+#define TX_PORT 4243
+
+#define RECV_TIMEOUT K_SECONDS(10)
+
+static const int rounds[] = { 1, 4, 16 };
+
+static struct net_context *rx_ctx;
+static struct net_context *tx_ctx;
+
+static uint8_t payload[PAYLOAD_LEN];
+
+static atomic_t received;
+static atomic_t corrupted;
+static K_SEM_DEFINE(all_received, 0, 1);
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static void recv_cb(struct net_context *context,
+		    struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status,
+		    void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(status);
+	ARG_UNUSED(user_data);
+
+	uint8_t data[PAYLOAD_LEN];
+
+	if (!pkt) {
+		return;
+	}
+
+	if (net_pkt_remaining_data(pkt) != sizeof(data) ||
+	    net_pkt_read(pkt, data, sizeof(data)) < 0 ||
+	    memcmp(data, payload, sizeof(data)) != 0) {
+		atomic_inc(&corrupted);
+	}
+
+	net_pkt_unref(pkt);
+
+	if (atomic_inc(&received) + 1 == N_PKTS) {
+		k_sem_give(&all_received);
+	}
+}
+
+static void setup(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+	};
+	int ret;
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add address\n");
+		k_panic();
+	}
+
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &rx_ctx);
+	if (ret < 0) {
+		printk("cannot get RX context: %d\n", ret);
+		k_panic();
+	}
+
+	addr.sin_port = htons(RX_PORT);
+	ret = net_context_bind(rx_ctx, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		printk("cannot bind RX context: %d\n", ret);
+		k_panic();
+	}
+
+	ret = net_context_recv(rx_ctx, recv_cb, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		printk("cannot set receive callback: %d\n", ret);
+		k_panic();
+	}
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &tx_ctx);
+	if (ret < 0) {
+		printk("cannot get TX context: %d\n", ret);
+		k_panic();
+	}
+
+	addr.sin_port = htons(TX_PORT);
+	ret = net_context_bind(tx_ctx, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		printk("cannot bind TX context: %d\n", ret);
+		k_panic();
+	}
+}
+
+/* Measure the packet rate when sending in rounds of @round packets.
+ * Return a negative value if they did not all come back intact.
+ */
+static int run(int round, uint32_t *rate)
+{
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_port = htons(RX_PORT),
+		.sin_addr = peer_addr,
+	};
+	uint32_t start, cycles;
+	int sent = 0;
+	int ret;
+
+	atomic_set(&received, 0);
+	atomic_set(&corrupted, 0);
+	k_sem_reset(&all_received);
+
+	start = k_cycle_get_32();
+
+	while (sent < N_PKTS) {
+		/* Keep the TX thread away until the whole round is queued */
+		k_sched_lock();
+
+		for (int i = 0; i < round && sent < N_PKTS; i++, sent++) {
+			ret = net_context_sendto(tx_ctx, payload,
+						 sizeof(payload),
+						 (struct sockaddr *)&dst,
+						 sizeof(dst), NULL,
+						 K_MSEC(100), NULL);
+			if (ret < 0) {
+				k_sched_unlock();
+				printk("cannot send packet %d: %d\n", sent,
+				       ret);
+				return -1;
+			}
+		}
+
+		k_sched_unlock();
+	}
+
+	if (k_sem_take(&all_received, RECV_TIMEOUT) < 0) {
+		printk("%u packets of %u received\n",
+		       (uint32_t)atomic_get(&received), N_PKTS);
+		return -1;
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (atomic_get(&corrupted) != 0) {
+		printk("%u packets received with wrong data\n",
+		       (uint32_t)atomic_get(&corrupted));
+		return -1;
+	}
+
+	*rate = (uint64_t)N_PKTS * sys_clock_hw_cycles_per_sec() /
+		MAX(cycles, 1U);
+
+	return 0;
+}
+
+void main(void)
+{
+	setup();
+
+	for (int i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(rounds); i++) {
+		uint32_t rate;
+
+		if (run(rounds[i], &rate) < 0) {
+			printk("round %2d burst %2d failed\n", rounds[i],
+			       CONFIG_NET_TC_TX_BURST);
+			return;
+		}
+
+		printk("round %2d burst %2d %8u pkts/s\n", rounds[i],
+		       CONFIG_NET_TC_TX_BURST, rate);
+	}
+
+	net_context_put(tx_ctx);
+	net_context_put(rx_ctx);
+
+	printk("fin\n");
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#include "connection.h"
+
+/* This is a connection demultiplexing benchmark.  It measures the cost
+ * of finding the handler of a received UDP packet, which every packet
+ * pays before reaching its socket, as a function of the number of
+ * handlers registered:
+ *
+ * 1. Register N handlers, either connected ones (remote address and
+ *    port set) or listening ones (local port only).
+ * 2. Feed N_PKTS packets to net_conn_input(), each addressed to a
+ *    pseudo-randomly picked handler, and convert the time taken into
+ *    packets per second.
+ */
+
+#define MAX_SOCKETS 256
+#define N_PKTS 10000
+
+#define LOCAL_PORT 4242
+#define REMOTE_PORT_BASE 10000
+#define LOCAL_PORT_BASE 20000
+
+static const int sizes[] = { 4, 32, MAX_SOCKETS };
+
+static struct net_conn_handle *handles[MAX_SOCKETS];
+
+static struct net_ipv6_hdr ip6;
+static struct net_udp_hdr udp;
+static struct net_pkt *pkt;
+
+static uint32_t delivered;
+
+static const struct in6_addr local_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0,
+						0, 0, 0, 0, 0, 0, 0, 0, 0,
+						0x1 } } };
+static const struct in6_addr remote_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0,
+						 0, 0, 0, 0, 0, 0, 0, 0, 0,
+						 0x2 } } };
+
+static uint32_t rand32(void)
+{
+	static uint32_t state = 2463534242U;
+
+	/* xorshift32: cheap and deterministic across runs */
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static enum net_verdict conn_cb(struct net_conn *conn,
+				struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Keep the packet, it is fed again */
+	delivered++;
+
+	return NET_OK;
+}
+
+static void register_handlers(int n, bool connected)
+{
+	struct sockaddr_in6 local = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = local_addr,
+	};
+	struct sockaddr_in6 remote = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = remote_addr,
+	};
+	int ret;
+
+	for (int i = 0; i < n; i++) {
+		if (connected) {
+			ret = net_conn_register(IPPROTO_UDP, AF_INET6,
+						(struct sockaddr *)&remote,
+						(struct sockaddr *)&local,
+						REMOTE_PORT_BASE + i,
+						LOCAL_PORT, NULL, conn_cb,
+						NULL, &handles[i]);
+		} else {
+			ret = net_conn_register(IPPROTO_UDP, AF_INET6,
+						NULL,
+						(struct sockaddr *)&local,
+						0, LOCAL_PORT_BASE + i,
+						NULL, conn_cb, NULL,
+						&handles[i]);
+		}
+
+		if (ret < 0) {
+			printk("cannot register handler %d: %d\n", i, ret);
+			k_panic();
+		}
+	}
+}
+
+static void unregister_handlers(int n)
+{
+	for (int i = 0; i < n; i++) {
+		net_conn_unregister(handles[i]);
+	}
+}
+
+/* Return the packet rate to @n handlers */
+static uint32_t run(int n, bool connected)
+{
+	union net_ip_header ip_hdr = { .ipv6 = &ip6 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	uint32_t start, cycles;
+
+	register_handlers(n, connected);
+
+	delivered = 0U;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_PKTS; i++) {
+		int target = rand32() % n;
+
+		if (connected) {
+			udp.src_port = htons(REMOTE_PORT_BASE + target);
+			udp.dst_port = htons(LOCAL_PORT);
+		} else {
+			udp.src_port = htons(REMOTE_PORT_BASE);
+			udp.dst_port = htons(LOCAL_PORT_BASE + target);
+		}
+
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	unregister_handlers(n);
+
+	if (delivered != N_PKTS) {
+		printk("%u packets of %u delivered, results invalid\n",
+		       delivered, N_PKTS);
+	}
+
+	if (cycles == 0U) {
+		return 0U;
+	}
+
+	return (uint64_t)N_PKTS * sys_clock_hw_cycles_per_sec() / cycles;
+}
+
+void main(void)
+{
+	uint32_t connected, listen;
+
+	pkt = net_pkt_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_iface(pkt, net_if_get_default());
+
+	net_ipaddr_copy(&ip6.src, &remote_addr);
+	net_ipaddr_copy(&ip6.dst, &local_addr);
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		connected = run(sizes[i], true);
+		listen = run(sizes[i], false);
+
+		printk("sockets %4d connected %8u listen %8u pkts/s\n",
+		       sizes[i], connected, listen);
+	}
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/socket.h>
+
+/* This is a TCP throughput benchmark.  It measures how fast a bulk
+ * transfer goes down the stack, through the loopback driver and up the
+ * stack again, when TCP sends one segment per packet, when it sends
+ * larger packets cut into segments in software (GSO) and coalesced
+ * again on reception (GRO), or when the loopback driver takes them
+ * whole (TSO):
+ *
+ * 1. Listen on the loopback interface address, and connect to it
+ *    through an address routed out of the loopback interface.
+ * 2. Send TOTAL_LEN bytes with writes of a given size, and convert the
+ *    time until the receiving thread got all of them into kB/s.  The
+ *    data is a repeated pattern the receiving thread checks, so that a
+ *    short or corrupted transfer fails the benchmark.
+ */
+
+#define TOTAL_LEN (512 * 1024)
+#define BUF_LEN 4096
+
+/* Byte n of the stream is n % PATTERN_LEN, a prime not to line up with
+ * the writes and segments
+ */
+#define PATTERN_LEN 251
+
+#define PORT 4242
+
+#define RECV_TIMEOUT K_SECONDS(30)
+
+#define RECV_STACK_SIZE 2048
+#define RECV_PRIORITY K_PRIO_PREEMPT(8)
+
+static const int writes[] = { 512, 1460, 4096 };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static uint8_t tx_buf[BUF_LEN + PATTERN_LEN];
+static uint8_t rx_buf[BUF_LEN];
+
+static int listen_sock;
+static int tx_sock;
+
+static atomic_t received;
+static atomic_t corrupted;
+static K_SEM_DEFINE(all_received, 0, 1);
+
+K_THREAD_STACK_DEFINE(recv_stack, RECV_STACK_SIZE);
+static struct k_thread recv_thread;
+
+static void recv_fn(void *p1, void *p2, void *p3)
+{
+	int sock;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = accept(listen_sock, NULL, NULL);
+	if (sock < 0) {
+		printk("cannot accept: %d\n", errno);
+		return;
+	}
+
+	while (true) {
+		size_t offset;
+
+		ret = recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		offset = (size_t)atomic_get(&received) % PATTERN_LEN;
+		if (memcmp(rx_buf, &tx_buf[offset], ret) != 0) {
+			atomic_inc(&corrupted);
+		}
+
+		if (atomic_add(&received, ret) + ret >= TOTAL_LEN) {
+			k_sem_give(&all_received);
+		}
+	}
+
+	close(sock);
+}
+
+static void setup(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+		.sin_addr = my_addr,
+	};
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+		.sin_addr = peer_addr,
+	};
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add address\n");
+		k_panic();
+	}
+
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listen_sock < 0) {
+		printk("cannot get listening socket: %d\n", errno);
+		k_panic();
+	}
+
+	if (bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(listen_sock, 1) < 0) {
+		printk("cannot listen: %d\n", errno);
+		k_panic();
+	}
+
+	k_thread_create(&recv_thread, recv_stack,
+			K_THREAD_STACK_SIZEOF(recv_stack), recv_fn,
+			NULL, NULL, NULL, RECV_PRIORITY, 0, K_NO_WAIT);
+
+	tx_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (tx_sock < 0) {
+		printk("cannot get sending socket: %d\n", errno);
+		k_panic();
+	}
+
+	/* The loopback driver swaps the addresses, so the packets sent to
+	 * the peer address are received by the listening socket, and its
+	 * answers come back from the peer address.
+	 */
+	if (connect(tx_sock, (struct sockaddr *)&dst, sizeof(dst)) < 0) {
+		printk("cannot connect: %d\n", errno);
+		k_panic();
+	}
+}
+
+/* Measure the throughput in kB/s when sending writes of @len bytes.
+ * Return a negative value if the data did not all come back intact.
+ */
+static int run(int len, uint32_t *rate)
+{
+	uint32_t start, cycles;
+	int sent = 0;
+	int ret;
+
+	atomic_set(&received, 0);
+	atomic_set(&corrupted, 0);
+	k_sem_reset(&all_received);
+
+	start = k_cycle_get_32();
+
+	while (sent < TOTAL_LEN) {
+		ret = send(tx_sock, &tx_buf[sent % PATTERN_LEN],
+			   MIN(len, TOTAL_LEN - sent), 0);
+		if (ret < 0) {
+			printk("cannot send at %d: %d\n", sent, errno);
+			return -1;
+		}
+
+		sent += ret;
+	}
+
+	if (k_sem_take(&all_received, RECV_TIMEOUT) < 0) {
+		printk("%u bytes of %u received\n",
+		       (uint32_t)atomic_get(&received), TOTAL_LEN);
+		return -1;
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (atomic_get(&corrupted) != 0) {
+		printk("%u reads returned wrong data\n",
+		       (uint32_t)atomic_get(&corrupted));
+		return -1;
+	}
+
+	*rate = (uint64_t)TOTAL_LEN * sys_clock_hw_cycles_per_sec() /
+		MAX(cycles, 1U) / 1024U;
+
+	return 0;
+}
+
+void main(void)
+{
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i % PATTERN_LEN;
+	}
+
+	setup();
+
+	for (int i = 0; i < ARRAY_SIZE(writes); i++) {
+		uint32_t rate;
+
+		if (run(writes[i], &rate) < 0) {
+			printk("write %4d failed\n", writes[i]);
+			return;
+		}
+
+		printk("write %4d gso %c gro %c tso %c %8u kB/s\n", writes[i],
+		       IS_ENABLED(CONFIG_NET_TCP_GSO) ? 'y' : 'n',
+		       IS_ENABLED(CONFIG_NET_TCP_GRO) ? 'y' : 'n',
+		       IS_ENABLED(CONFIG_NET_LOOPBACK_OFFLOADS) ? 'y' : 'n',
+		       rate);
+	}
+
+	close(tx_sock);
+	close(listen_sock);
+
+	printk("fin\n");
+}
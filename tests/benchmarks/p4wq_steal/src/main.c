@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/p4wq_ws.h>
+
+/* This is a fork/join scaling benchmark for the work-stealing executor.
+ * Two DSP style jobs run over a block of samples:
+ *
+ * 1. parallel-for: a FIR filter writes every output sample.
+ * 2. reduce: the energy (sum of squares) of the filtered block.
+ *
+ * Both split their range in halves recursively with k_p4wq_ws_spawn()
+ * and k_p4wq_ws_join() down to GRAIN samples.  They are timed on
+ * executors with 1, 2 and 4 workers, each worker pinned to one CPU,
+ * and the speedup is reported relative to the single worker.
+ */
+
+#define SAMPLES 16384
+#define TAPS 32
+#define GRAIN 256
+#define ROUNDS 4
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+#define STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_P4WQ_WS_DEFINE(ws1, 1, STACK_SIZE);
+K_P4WQ_WS_DEFINE(ws2, 2, STACK_SIZE);
+K_P4WQ_WS_DEFINE(ws4, 4, STACK_SIZE);
+
+static struct k_p4wq_ws *const executors[] = { &ws1, &ws2, &ws4 };
+
+static int16_t input[SAMPLES + TAPS];
+static int16_t coeffs[TAPS];
+static int32_t output[SAMPLES];
+
+struct range_task {
+	struct k_p4wq_ws_task task;
+	uint32_t lo;
+	uint32_t hi;
+	uint64_t sum;
+};
+
+static void fir(uint32_t lo, uint32_t hi)
+{
+	for (uint32_t i = lo; i < hi; i++) {
+		int32_t acc = 0;
+
+		for (int t = 0; t < TAPS; t++) {
+			acc += input[i + t] * coeffs[t];
+		}
+		output[i] = acc >> 15;
+	}
+}
+
+static uint64_t energy(uint32_t lo, uint32_t hi)
+{
+	uint64_t sum = 0;
+
+	for (uint32_t i = lo; i < hi; i++) {
+		sum += (int64_t)output[i] * output[i];
+	}
+
+	return sum;
+}
+
+/* Split the range of @a task in two children and wait for them */
+static void split(struct range_task *r, k_p4wq_ws_handler_t handler)
+{
+	uint32_t mid = r->lo + (r->hi - r->lo) / 2;
+	struct range_task a = {
+		.task.handler = handler, .lo = r->lo, .hi = mid,
+	};
+	struct range_task b = {
+		.task.handler = handler, .lo = mid, .hi = r->hi,
+	};
+
+	k_p4wq_ws_spawn(&r->task, &a.task);
+	k_p4wq_ws_spawn(&r->task, &b.task);
+	k_p4wq_ws_join(&r->task);
+
+	r->sum = a.sum + b.sum;
+}
+
+static void for_handler(struct k_p4wq_ws_task *task)
+{
+	struct range_task *r = CONTAINER_OF(task, struct range_task, task);
+
+	if (r->hi - r->lo <= GRAIN) {
+		fir(r->lo, r->hi);
+	} else {
+		split(r, for_handler);
+	}
+}
+
+static void reduce_handler(struct k_p4wq_ws_task *task)
+{
+	struct range_task *r = CONTAINER_OF(task, struct range_task, task);
+
+	if (r->hi - r->lo <= GRAIN) {
+		r->sum = energy(r->lo, r->hi);
+	} else {
+		split(r, reduce_handler);
+	}
+}
+
+static uint32_t run_job(struct k_p4wq_ws *ws, k_p4wq_ws_handler_t handler,
+			uint64_t *sum)
+{
+	struct range_task root = {
+		.task.handler = handler, .lo = 0, .hi = SAMPLES,
+	};
+	uint32_t start = k_cycle_get_32();
+
+	k_p4wq_ws_submit(ws, &root.task, 0);
+	k_p4wq_ws_wait(&root.task, K_FOREVER);
+
+	*sum = root.sum;
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t stolen(struct k_p4wq_ws *ws)
+{
+	uint32_t n = 0;
+
+	for (uint32_t i = 0; i < ws->num_workers; i++) {
+		n += ws->workers[i].stolen;
+	}
+
+	return n;
+}
+
+void main(void)
+{
+	uint32_t base = 0;
+	uint64_t expected;
+
+	for (int i = 0; i < ARRAY_SIZE(input); i++) {
+		input[i] = (int16_t)(i * 7919);
+	}
+	for (int t = 0; t < TAPS; t++) {
+		coeffs[t] = (int16_t)(1024 - 64 * t);
+	}
+	fir(0, SAMPLES);
+	expected = energy(0, SAMPLES);
+
+	for (int e = 0; e < ARRAY_SIZE(executors); e++) {
+		struct k_p4wq_ws *ws = executors[e];
+		uint32_t for_cycles = 0, reduce_cycles = 0;
+		uint64_t sum;
+
+		k_p4wq_ws_start(ws, WORKER_PRIO, NULL);
+
+		for (int r = 0; r < ROUNDS; r++) {
+			for_cycles += run_job(ws, for_handler, &sum);
+			reduce_cycles += run_job(ws, reduce_handler, &sum);
+			if (sum != expected) {
+				printk("reduce result mismatch\n");
+			}
+		}
+
+		k_p4wq_ws_stop(ws);
+
+		if (e == 0) {
+			base = for_cycles + reduce_cycles;
+		}
+
+		printk("workers %u for %u cycles reduce %u cycles "
+		       "speedup %u%% stolen %u\n", ws->num_workers,
+		       for_cycles / ROUNDS, reduce_cycles / ROUNDS,
+		       (uint32_t)(100ULL * base /
+				  MAX(for_cycles + reduce_cycles, 1U)),
+		       stolen(ws));
+	}
+
+	printk("fin\n");
+}
@@ -86,6 +86,97 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+#ifdef CONFIG_SMP
+/* SMP switch throughput: for n = 1..CONFIG_MP_NUM_CPUS, run n
+ * independent groups of two threads ping-ponging over a pair of
+ * semaphores (pinned to CPU i for group i when CPU masks are
+ * available) for SMP_RUN_MS, and report the total number of round
+ * trips per second.  Each round trip is two context switches when a
+ * group stays on one CPU.  With perfect scaling the rate grows
+ * linearly with n; contention on the shared scheduler state shows up
+ * as a flattening curve.
+ */
+#define SMP_RUN_MS 1000
+
+struct pingpong {
+	struct k_sem ping;
+	struct k_sem pong;
+	uint32_t rounds;
+};
+
+static struct pingpong groups[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(pp_stacks, 2 * CONFIG_MP_NUM_CPUS, 1024);
+static struct k_thread pp_threads[2 * CONFIG_MP_NUM_CPUS];
+
+static void ping_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pingpong *g = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_give(&g->ping);
+		k_sem_take(&g->pong, K_FOREVER);
+		g->rounds++;
+	}
+}
+
+static void pong_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pingpong *g = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&g->ping, K_FOREVER);
+		k_sem_give(&g->pong);
+	}
+}
+
+static void smp_throughput(int prio)
+{
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint64_t total = 0U;
+
+		for (int i = 0; i < n; i++) {
+			k_sem_init(&groups[i].ping, 0, 1);
+			k_sem_init(&groups[i].pong, 0, 1);
+			groups[i].rounds = 0U;
+
+			for (int j = 0; j < 2; j++) {
+				struct k_thread *th = &pp_threads[2 * i + j];
+
+				k_thread_create(th, pp_stacks[2 * i + j],
+						K_THREAD_STACK_SIZEOF(pp_stacks[0]),
+						j == 0 ? ping_fn : pong_fn,
+						&groups[i], NULL, NULL,
+						prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+				k_thread_cpu_mask_clear(th);
+				k_thread_cpu_mask_enable(th, i);
+#endif
+				k_thread_start(th);
+			}
+		}
+
+		k_sleep(K_MSEC(SMP_RUN_MS));
+
+		for (int i = 0; i < 2 * n; i++) {
+			k_thread_abort(&pp_threads[i]);
+		}
+
+		for (int i = 0; i < n; i++) {
+			total += groups[i].rounds;
+		}
+
+		printk("smp groups %d rounds %u per sec\n", n,
+		       (uint32_t)(total * MSEC_PER_SEC / SMP_RUN_MS));
+	}
+}
+#endif
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,5 +239,10 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+#ifdef CONFIG_SMP
+	/* Below main so that it wakes up on time to stop each run */
+	smp_throughput(main_prio + 1);
+#endif
+
 	printk("fin\n");
 }
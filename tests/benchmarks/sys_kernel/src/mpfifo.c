@@ -0,0 +1,137 @@
+/* mpfifo.c */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#define MAX_PRODUCERS 4
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, MAX_PRODUCERS,
+				   STACK_SIZE);
+static struct k_thread producer_threads[MAX_PRODUCERS];
+
+/* Each element only needs room for the fifo's reserved word */
+static void *elements[MAX_PRODUCERS][NUMBER_OF_LOOPS];
+
+static struct k_fifo mp_fifo;
+static struct k_sem ready_sem;
+static struct k_sem start_sem;
+static struct k_sem done_sem;
+
+
+/**
+ *
+ * @brief Producer thread
+ *
+ * Waits for the start signal, then appends its elements to the fifo
+ * back to back.  Nobody consumes while the producers run, so this only
+ * measures the cost of k_fifo_put() when no thread needs waking.
+ *
+ * @param par1   Element array of this producer.
+ * @param par2   Number of elements to put.
+ * @param par3   unused
+ *
+ * @return N/A
+ */
+static void producer_thread(void *par1, void *par2, void *par3)
+{
+	void **element = par1;
+	int num_loops = POINTER_TO_INT(par2);
+
+	ARG_UNUSED(par3);
+
+	k_sem_give(&ready_sem);
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (int i = 0; i < num_loops; i++) {
+		k_fifo_put(&mp_fifo, &element[i]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+
+/**
+ *
+ * @brief Run the producer benchmark with a given number of producers
+ *
+ * @param producers  Number of producer threads.
+ *
+ * @return 1 if success and 0 on failure
+ */
+static int mpfifo_run(int producers)
+{
+	char name[32];
+	uint32_t t;
+	int i, j;
+
+	snprintf(name, sizeof(name), "FIFO #4 (%d producers)", producers);
+	fprintf(output_file, sz_test_case_fmt, name);
+	fprintf(output_file, sz_description,
+			"\n\tk_fifo_init"
+			"\n\tk_fifo_put (from every producer)"
+			"\n\tk_fifo_get(K_NO_WAIT)");
+	printf(sz_test_start_fmt);
+
+	k_fifo_init(&mp_fifo);
+	k_sem_init(&ready_sem, 0, MAX_PRODUCERS);
+	k_sem_init(&start_sem, 0, MAX_PRODUCERS);
+	k_sem_init(&done_sem, 0, MAX_PRODUCERS);
+
+	for (i = 0; i < producers; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				STACK_SIZE, producer_thread,
+				elements[i], INT_TO_POINTER(number_of_loops),
+				NULL, K_PRIO_COOP(3), 0, K_NO_WAIT);
+	}
+	for (i = 0; i < producers; i++) {
+		k_sem_take(&ready_sem, K_FOREVER);
+	}
+
+	t = BENCH_START();
+
+	for (i = 0; i < producers; i++) {
+		k_sem_give(&start_sem);
+	}
+	for (i = 0; i < producers; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	/* Count what arrived; report the average cost of one put */
+	for (j = 0; k_fifo_get(&mp_fifo, K_NO_WAIT) != NULL; j++) {
+	}
+
+	for (i = 0; i < producers; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	return check_result(j / producers, t / producers);
+}
+
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * Runs the producer benchmark with one to four producer threads; on
+ * SMP targets they spread over the available CPUs and contend on the
+ * same fifo.
+ *
+ * @return number of successful test cases
+ */
+int mpfifo_test(void)
+{
+	int return_value = 0;
+
+	for (int producers = 1; producers <= MAX_PRODUCERS; producers++) {
+		return_value += mpfifo_run(producers);
+	}
+
+	return return_value;
+}
@@ -161,15 +161,23 @@ void main(void)
 
 		test_result = 0;
 
+#if CONFIG_MP_NUM_CPUS == 1
 		test_result += sema_test();
 		test_result += lifo_test();
 		test_result += fifo_test();
+		test_result += mpfifo_test();
 		test_result += stack_test();
 		test_result += mem_slab_test();
+#else
+		/* The other tests assume a single CPU */
+		test_result += mpfifo_test();
+#endif
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
-			if (test_result == 14) {
+			/* sema/lifo/fifo/mpfifo/stack/mem_slab account for
+			 * 18 tests in total, mpfifo for 4 of them
+			 */
+			if (test_result == (CONFIG_MP_NUM_CPUS == 1 ? 18 : 4)) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
@@ -55,6 +55,7 @@ int check_result(int i, uint32_t ticks);
 int sema_test(void);
 int lifo_test(void);
 int fifo_test(void);
+int mpfifo_test(void);
 int stack_test(void);
 int mem_slab_test(void);
 void begin_test(void);
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  It measures the cost of
+ * the raw kernel timeout primitives used underneath k_sleep(),
+ * k_timer, k_work_delayable and every blocking call with a timeout,
+ * as a function of the number of timeouts already pending:
+ *
+ * 1. Arm N "resident" timeouts with pseudo-random deadlines far
+ *    enough in the future that none of them fires during the run.
+ * 2. Time N_OPS further z_add_timeout() calls landing among them.
+ * 3. Time z_abort_timeout() of those N_OPS timeouts.
+ * 4. Arm N_OPS timeouts expiring on the same tick and time the
+ *    interval between the first and the last expiry callback.
+ */
+
+#define MAX_TIMEOUTS 10000
+#define N_OPS 100
+
+/* Resident deadlines, in ticks from now */
+#define RESIDENT_MIN 1000
+#define RESIDENT_SPREAD 1000000
+
+static const int sizes[] = { 10, 1000, MAX_TIMEOUTS };
+
+static struct _timeout resident[MAX_TIMEOUTS];
+static struct _timeout probes[N_OPS];
+
+static volatile int n_expired;
+static uint32_t first_stamp, last_stamp;
+
+static uint32_t rand32(void)
+{
+	static uint32_t state = 2463534242U;
+
+	/* xorshift32: cheap and deterministic across runs */
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static k_timeout_t resident_timeout(void)
+{
+	return K_TICKS(RESIDENT_MIN + (rand32() % RESIDENT_SPREAD));
+}
+
+static void resident_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("resident timeout fired, results invalid\n");
+}
+
+static void expire_fn(struct _timeout *t)
+{
+	uint32_t now = k_cycle_get_32();
+
+	ARG_UNUSED(t);
+
+	if (n_expired++ == 0) {
+		first_stamp = now;
+	}
+	last_stamp = now;
+}
+
+static void run(int n)
+{
+	uint32_t start, insert, cancel, expire;
+
+	for (int i = 0; i < n; i++) {
+		z_add_timeout(&resident[i], resident_fn, resident_timeout());
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_OPS; i++) {
+		z_add_timeout(&probes[i], resident_fn, resident_timeout());
+	}
+	insert = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_OPS; i++) {
+		z_abort_timeout(&probes[i]);
+	}
+	cancel = k_cycle_get_32() - start;
+
+	/* Start on a fresh tick so the whole batch lands on the same
+	 * expiry tick.
+	 */
+	n_expired = 0;
+	k_sleep(K_TICKS(1));
+	for (int i = 0; i < N_OPS; i++) {
+		z_add_timeout(&probes[i], expire_fn, K_TICKS(2));
+	}
+	while (n_expired < N_OPS) {
+		k_sleep(K_TICKS(1));
+	}
+	expire = last_stamp - first_stamp;
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&resident[i]);
+	}
+
+	printk("timeouts %5d insert %6u cancel %6u expire %6u cycles/op\n",
+	       n, insert / N_OPS, cancel / N_OPS, expire / (N_OPS - 1));
+}
+
+void main(void)
+{
+	for (int i = 0; i < MAX_TIMEOUTS; i++) {
+		z_init_timeout(&resident[i]);
+	}
+
+	for (int i = 0; i < N_OPS; i++) {
+		z_init_timeout(&probes[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run(sizes[i]);
+	}
+
+	printk("fin\n");
+}
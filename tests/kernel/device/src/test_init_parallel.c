@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <ztest.h>
+
+#define INIT_SLEEP_MS 20
+
+/* Initialized in parallel, the children come before their bus in link
+ * order: the dependency must win over the priority
+ */
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define CHILD_INIT_PRIORITY 49
+#else
+#define CHILD_INIT_PRIORITY 51
+#endif
+
+/* Devicetree devices initialized in POST_KERNEL: the bus and the solo
+ * device sleep, the children must see the bus done
+ */
+static atomic_t init_running;
+static atomic_t init_running_max;
+static bool child_saw_bus[2];
+
+static int init_sleeper(const struct device *dev)
+{
+	atomic_val_t running = atomic_inc(&init_running) + 1;
+
+	if (running > atomic_get(&init_running_max)) {
+		atomic_set(&init_running_max, running);
+	}
+
+	k_msleep(INIT_SLEEP_MS);
+	atomic_dec(&init_running);
+
+	return 0;
+}
+
+static int init_child_a(const struct device *dev)
+{
+	child_saw_bus[0] =
+		device_is_ready(DEVICE_DT_GET(DT_NODELABEL(test_init_bus)));
+
+	return 0;
+}
+
+static int init_child_b(const struct device *dev)
+{
+	child_saw_bus[1] =
+		device_is_ready(DEVICE_DT_GET(DT_NODELABEL(test_init_bus)));
+
+	return 0;
+}
+
+DEVICE_DT_DEFINE(DT_NODELABEL(test_init_bus), init_sleeper, NULL, NULL, NULL,
+		 POST_KERNEL, 50, NULL);
+DEVICE_DT_DEFINE(DT_NODELABEL(test_init_child_a), init_child_a, NULL, NULL,
+		 NULL, POST_KERNEL, CHILD_INIT_PRIORITY, NULL);
+DEVICE_DT_DEFINE(DT_NODELABEL(test_init_child_b), init_child_b, NULL, NULL,
+		 NULL, POST_KERNEL, CHILD_INIT_PRIORITY, NULL);
+DEVICE_DT_DEFINE(DT_NODELABEL(test_init_solo), init_sleeper, NULL, NULL, NULL,
+		 POST_KERNEL, 50, NULL);
+
+/**
+ * @brief Test initialization of devicetree devices in dependency order
+ *
+ * @details Children must always be initialized after their bus.  With
+ * CONFIG_DEVICE_INIT_PARALLEL, the bus and the unrelated device sleep
+ * in their init functions at the same time.
+ *
+ * @ingroup kernel_device_tests
+ */
+void test_device_init_parallel(void)
+{
+	const struct device *solo = DEVICE_DT_GET(DT_NODELABEL(test_init_solo));
+
+	zassert_true(device_is_ready(solo), NULL);
+	zassert_true(child_saw_bus[0], "child a initialized before its bus");
+	zassert_true(child_saw_bus[1], "child b initialized before its bus");
+
+	if (IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL)) {
+		zassert_equal(atomic_get(&init_running_max), 2,
+			      "inits did not overlap");
+	} else {
+		zassert_equal(atomic_get(&init_running_max), 1, NULL);
+	}
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT_MS     100
+#define NUM_WAITERS    3
+
+#define PRIO_WAIT (CONFIG_ZTEST_THREAD_PRIORITY + 1)
+
+K_EVENT_DEFINE(test_event);
+static struct k_event init_event;
+
+K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS, STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+
+static ZTEST_BMEM uint32_t waiter_events[NUM_WAITERS];
+
+static void waiter_any(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t events = POINTER_TO_UINT(p2);
+
+	waiter_events[id] = k_event_wait(&test_event, events, false,
+					 K_MSEC(TIMEOUT_MS * 4));
+}
+
+static void waiter_all(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t events = POINTER_TO_UINT(p2);
+
+	waiter_events[id] = k_event_wait_all(&test_event, events, false,
+					     K_MSEC(TIMEOUT_MS * 4));
+}
+
+static void start_waiter(int id, k_thread_entry_t entry, uint32_t events)
+{
+	waiter_events[id] = 0xdeadbeef;
+	k_thread_create(&waiter_threads[id], waiter_stacks[id], STACK_SIZE,
+			entry, INT_TO_POINTER(id), UINT_TO_POINTER(events), NULL,
+			PRIO_WAIT, K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+}
+
+/* Let the lower priority waiters run until they pend or return */
+static void settle(void)
+{
+	k_msleep(TIMEOUT_MS >> 2);
+}
+
+static void post_from_isr(const void *arg)
+{
+	k_event_post(&test_event, POINTER_TO_UINT(arg));
+}
+
+/**
+ * @defgroup kernel_event_tests Events
+ * @ingroup all_tests
+ * @{
+ */
+
+/**
+ * @brief Test initialization and the post, set and clear operations
+ *
+ * @see k_event_init(), k_event_post(), k_event_set(), k_event_clear()
+ */
+void test_event_init_post_set_clear(void)
+{
+	k_event_init(&init_event);
+	zassert_equal(k_event_wait(&init_event, ~0U, false, K_NO_WAIT), 0,
+		      NULL);
+
+	k_event_post(&init_event, 0x11);
+	k_event_post(&init_event, 0x102);
+	zassert_equal(k_event_wait(&init_event, ~0U, false, K_NO_WAIT), 0x113,
+		      NULL);
+
+	/**TESTPOINT: set replaces instead of accumulating */
+	k_event_set(&init_event, 0x8);
+	zassert_equal(k_event_wait(&init_event, ~0U, false, K_NO_WAIT), 0x8,
+		      NULL);
+
+	k_event_post(&init_event, 0x3);
+	k_event_clear(&init_event, 0x9);
+	zassert_equal(k_event_wait(&init_event, ~0U, false, K_NO_WAIT), 0x2,
+		      NULL);
+}
+
+/**
+ * @brief Test waiting without blocking
+ *
+ * @see k_event_wait(), k_event_wait_all()
+ */
+void test_event_wait_no_wait(void)
+{
+	k_event_set(&test_event, 0x5);
+
+	/**TESTPOINT: only the desired events are returned */
+	zassert_equal(k_event_wait(&test_event, 0x6, false, K_NO_WAIT), 0x4,
+		      NULL);
+	zassert_equal(k_event_wait(&test_event, 0x8, false, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(k_event_wait(&test_event, 0, false, K_NO_WAIT), 0, NULL);
+
+	zassert_equal(k_event_wait_all(&test_event, 0x5, false, K_NO_WAIT),
+		      0x5, NULL);
+	zassert_equal(k_event_wait_all(&test_event, 0x7, false, K_NO_WAIT), 0,
+		      NULL);
+
+	/**TESTPOINT: a reset discards the events posted before the wait */
+	zassert_equal(k_event_wait(&test_event, 0x1, true, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(k_event_wait(&test_event, ~0U, false, K_NO_WAIT), 0,
+		      NULL);
+}
+
+/**
+ * @brief Test waiting with a timeout that expires
+ *
+ * @see k_event_wait(), k_event_wait_all()
+ */
+void test_event_wait_timeout(void)
+{
+	k_event_set(&test_event, 0x1);
+
+	zassert_equal(k_event_wait(&test_event, 0x2, false,
+				   K_MSEC(TIMEOUT_MS)), 0, NULL);
+	zassert_equal(k_event_wait_all(&test_event, 0x3, false,
+				       K_MSEC(TIMEOUT_MS)), 0, NULL);
+	zassert_equal(k_event_wait(&test_event, 0x1, true,
+				   K_MSEC(TIMEOUT_MS)), 0, NULL);
+}
+
+/**
+ * @brief Test that one post wakes every satisfied waiter and only those
+ *
+ * @see k_event_post(), k_event_wait(), k_event_wait_all()
+ */
+void test_event_post_wake(void)
+{
+	k_event_set(&test_event, 0);
+
+	start_waiter(0, waiter_any, 0x3);
+	start_waiter(1, waiter_all, 0x3);
+	start_waiter(2, waiter_any, 0x4);
+	settle();
+
+	k_event_post(&test_event, 0x1);
+	settle();
+	zassert_equal(waiter_events[0], 0x1, NULL);
+	zassert_equal(waiter_events[1], 0xdeadbeef, NULL);
+	zassert_equal(waiter_events[2], 0xdeadbeef, NULL);
+
+	/**TESTPOINT: wait-all needs every event, even across posts */
+	k_event_post(&test_event, 0x2);
+	settle();
+	zassert_equal(waiter_events[1], 0x3, NULL);
+	zassert_equal(waiter_events[2], 0xdeadbeef, NULL);
+
+	k_event_set(&test_event, 0x4);
+	settle();
+	zassert_equal(waiter_events[2], 0x4, NULL);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test that one set wakes several waiters at once
+ *
+ * @see k_event_set(), k_event_wait()
+ */
+void test_event_set_wake_all(void)
+{
+	k_event_set(&test_event, 0);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		start_waiter(i, waiter_any, BIT(i) | BIT(8));
+	}
+	settle();
+
+	k_event_set(&test_event, BIT(8) | BIT(1));
+	settle();
+	zassert_equal(waiter_events[0], BIT(8), NULL);
+	zassert_equal(waiter_events[1], BIT(8) | BIT(1), NULL);
+	zassert_equal(waiter_events[2], BIT(8), NULL);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test posting events from an ISR
+ *
+ * @see k_event_post()
+ */
+void test_event_post_from_isr(void)
+{
+	k_event_set(&test_event, 0);
+
+	start_waiter(0, waiter_all, 0x30);
+	settle();
+
+	irq_offload(post_from_isr, UINT_TO_POINTER(0x10));
+	settle();
+	zassert_equal(waiter_events[0], 0xdeadbeef, NULL);
+	irq_offload(post_from_isr, UINT_TO_POINTER(0x20));
+	k_thread_join(&waiter_threads[0], K_FOREVER);
+	zassert_equal(waiter_events[0], 0x30, NULL);
+}
+
+/**
+ * @}
+ */
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &test_event, &init_event);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_access_grant(k_current_get(), &waiter_threads[i],
+				      &waiter_stacks[i]);
+	}
+
+	ztest_test_suite(event_api,
+			 ztest_user_unit_test(test_event_init_post_set_clear),
+			 ztest_user_unit_test(test_event_wait_no_wait),
+			 ztest_user_unit_test(test_event_wait_timeout),
+			 ztest_1cpu_user_unit_test(test_event_post_wake),
+			 ztest_1cpu_user_unit_test(test_event_set_wake_all),
+			 ztest_1cpu_unit_test(test_event_post_from_isr));
+	ztest_run_test_suite(event_api);
+}
@@ -108,6 +108,10 @@ void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *scope)
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+	printk("* Read ahead (%s):\n", scope);
+	printk("    - Total pages read ahead: %lu\n",
+	       stats->read_ahead.pages);
 }
 
 void test_touch_anon_pages(void)
@@ -207,9 +211,18 @@ void test_k_mem_page_out(void)
 	faults = z_num_pagefaults_get() - faults;
 	irq_unlock(key);
 
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	/* Sequential writes fault on the first page, pages read ahead of
+	 * it don't fault
+	 */
+	zassert_true(faults > 0 && faults <= HALF_PAGES,
+		     "unexpected num pagefaults expected at most %lu got %d",
+		     HALF_PAGES, faults);
+#else
 	zassert_equal(faults, HALF_PAGES,
 		      "unexpected num pagefaults expected %lu got %d",
 		      HALF_PAGES, faults);
+#endif
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
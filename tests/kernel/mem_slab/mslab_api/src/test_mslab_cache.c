@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include "test_mslab.h"
+
+#define CACHE_BLK_NUM 16
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_MEM_SLAB_DEFINE(cache_slab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+static void *blocks[CACHE_BLK_NUM];
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	void *block;
+
+	zassert_equal(k_mem_slab_alloc(&cache_slab, &block, K_FOREVER), 0,
+		      NULL);
+	k_mem_slab_free(&cache_slab, &block);
+}
+
+static void check_used(uint32_t used)
+{
+	zassert_equal(k_mem_slab_num_used_get(&cache_slab), used, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab),
+		      CACHE_BLK_NUM - used, NULL);
+}
+
+/**
+ * @brief Verify statistics and waiters with blocks moving between
+ * allocations and the free lists
+ *
+ * @details Freed blocks stay free while they sit in a per-CPU cache,
+ * cached blocks are used before failing an allocation, and a free goes
+ * to a thread waiting for a block, when there are threads.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cpu_cache(void)
+{
+	void *block;
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &blocks[i],
+					       K_NO_WAIT), 0, NULL);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(blocks[i], blocks[j], NULL);
+		}
+	}
+	check_used(CACHE_BLK_NUM);
+	zassert_equal(k_mem_slab_alloc(&cache_slab, &block, K_NO_WAIT),
+		      -ENOMEM, NULL);
+
+	for (int i = 0; i < 5; i++) {
+		k_mem_slab_free(&cache_slab, &blocks[i]);
+	}
+	check_used(CACHE_BLK_NUM - 5);
+	for (int i = 0; i < 5; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &blocks[i],
+					       K_NO_WAIT), 0, NULL);
+	}
+	check_used(CACHE_BLK_NUM);
+
+	/**TESTPOINT: all blocks come back, wherever they were cached */
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_slab, &blocks[i]);
+	}
+	check_used(0);
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &blocks[i],
+					       K_NO_WAIT), 0, NULL);
+	}
+	check_used(CACHE_BLK_NUM);
+	if (IS_ENABLED(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)) {
+		zassert_equal(k_mem_slab_max_used_get(&cache_slab),
+			      CACHE_BLK_NUM, NULL);
+	}
+
+	/**TESTPOINT: a free wakes up a waiting thread */
+	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+		k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE,
+				waiter, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+				K_NO_WAIT);
+		k_msleep(100);
+		k_mem_slab_free(&cache_slab, &blocks[0]);
+		zassert_equal(k_thread_join(&waiter_thread, K_MSEC(TIMEOUT)),
+			      0, NULL);
+	} else {
+		k_mem_slab_free(&cache_slab, &blocks[0]);
+	}
+	check_used(CACHE_BLK_NUM - 1);
+
+	for (int i = 1; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_slab, &blocks[i]);
+	}
+	check_used(0);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 5
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_BMEM uint32_t rx[BATCH_LEN * 2];
+static ZTEST_BMEM uint32_t waiter_rx;
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get((struct k_msgq *)p1, &waiter_rx, K_FOREVER);
+
+	zassert_equal(ret, 0, NULL);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = POINTER_TO_UINT(p2);
+	int ret = k_msgq_put_batch((struct k_msgq *)p1, &msg, 1, K_FOREVER);
+
+	zassert_equal(ret, 1, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched put and get, including ring buffer wrap-around
+ * @see k_msgq_put_batch(), k_msgq_get_batch()
+ */
+void test_msgq_batch(void)
+{
+	uint32_t tx[BATCH_LEN * 2];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	/**TESTPOINT: only as many as fit are sent */
+	ret = k_msgq_put_batch(&msgq, tx, ARRAY_SIZE(tx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	ret = k_msgq_put_batch(&msgq, tx, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_put_batch(&msgq, tx, 1, TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+
+	/* move the read and write pointers off the buffer start */
+	ret = k_msgq_get_batch(&msgq, rx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	zassert_equal(rx[0], MSG0, NULL);
+	zassert_equal(rx[2], MSG0 + 2, NULL);
+
+	/**TESTPOINT: puts and gets wrapping around the buffer end */
+	ret = k_msgq_put_batch(&msgq, &tx[BATCH_LEN], 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_LEN, NULL);
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	zassert_equal(rx[0], MSG0 + 3, NULL);
+	zassert_equal(rx[1], MSG0 + 4, NULL);
+	zassert_equal(rx[2], MSG0 + BATCH_LEN, NULL);
+	zassert_equal(rx[4], MSG0 + BATCH_LEN + 2, NULL);
+
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+	ret = k_msgq_get_batch(&msgq, rx, 0, K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+}
+
+/**
+ * @brief Test batched put handing a message straight to a waiting reader
+ * @see k_msgq_put_batch()
+ */
+void test_msgq_batch_pending_reader(void)
+{
+	uint32_t tx[3] = { MSG0, MSG1, MSG0 + 1 };
+	int ret;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, reader_entry,
+			&msgq, NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the reader gets the first message, the rest queue */
+	ret = k_msgq_put_batch(&msgq, tx, ARRAY_SIZE(tx), K_NO_WAIT);
+	zassert_equal(ret, ARRAY_SIZE(tx), NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(waiter_rx, MSG0, NULL);
+
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	zassert_equal(rx[0], MSG1, NULL);
+	zassert_equal(rx[1], MSG0 + 1, NULL);
+}
+
+/**
+ * @brief Test batched get refilling the queue from a waiting writer
+ * @see k_msgq_get_batch()
+ */
+void test_msgq_batch_pending_writer(void)
+{
+	uint32_t tx[BATCH_LEN];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+	ret = k_msgq_put_batch(&msgq, tx, ARRAY_SIZE(tx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, writer_entry,
+			&msgq, UINT_TO_POINTER(MSG1), NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the writer's message lands behind the queued ones
+	 * and is returned by the same call
+	 */
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN + 1, NULL);
+	zassert_equal(rx[BATCH_LEN - 1], MSG0 + BATCH_LEN - 1, NULL);
+	zassert_equal(rx[BATCH_LEN], MSG1, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe claim / commit API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define CLAIM_PIPE_SIZE 8
+#define TIMEOUT_MS 100
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_SIZE, 4);
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static unsigned char rx_buf[CLAIM_PIPE_SIZE];
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+	int ret;
+
+	ret = k_pipe_get(&claim_pipe, rx_buf, 4, &bytes_read, 4, K_FOREVER);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(bytes_read, 4, NULL);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	static const unsigned char tx[] = "WXYZ";
+	size_t bytes_written;
+	int ret;
+
+	ret = k_pipe_put(&claim_pipe, (void *)tx, 4, &bytes_written, 4,
+			 K_FOREVER);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(bytes_written, 4, NULL);
+}
+
+/**
+ * @brief Claim, commit, claim and finish, including buffer wrap-around
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ *      k_pipe_get_finish()
+ */
+void test_pipe_claim(void)
+{
+	uint8_t *data;
+	int ret;
+
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, -EIO, NULL);
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_MSEC(TIMEOUT_MS));
+	zassert_equal(ret, -EAGAIN, NULL);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, 6, K_NO_WAIT);
+	zassert_equal(ret, 6, NULL);
+	memcpy(data, "abcdef", 6);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 7), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 6), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 6, NULL);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, "abcd", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer */
+	ret = k_pipe_put_claim(&claim_pipe, &data, 6, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	memcpy(data, "gh", 2);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 2), 0, NULL);
+	ret = k_pipe_put_claim(&claim_pipe, &data, 6, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	memcpy(data, "ijkl", 4);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 4), 0, NULL);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, 1, K_NO_WAIT);
+	zassert_equal(ret, -EIO, NULL);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, "efgh", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 5), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	ret = k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, "ijkl", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+}
+
+/**
+ * @brief Committed data goes to a reader pended in k_pipe_get()
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit()
+ */
+void test_pipe_claim_pending_reader(void)
+{
+	uint8_t *data;
+	int ret;
+
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/* the reader needs 4 bytes: 2 leave it pended, 2 more complete it */
+	ret = k_pipe_put_claim(&claim_pipe, &data, 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	memcpy(data, "mn", 2);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 2), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	memcpy(data, "opq", 3);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 3), 0, NULL);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_mem_equal(rx_buf, "mnop", 4, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 1, NULL);
+}
+
+/**
+ * @brief Claims block until the other side transfers
+ *
+ * A full pipe's put claim waits for a reader, and finishing a get claim
+ * refills the pipe from a pended writer.
+ *
+ * @see k_pipe_put_claim(), k_pipe_get_claim(), k_pipe_get_finish()
+ */
+void test_pipe_claim_wait(void)
+{
+	uint8_t *data;
+	int ret;
+
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, CLAIM_PIPE_SIZE, NULL);
+	memcpy(data, "01234567", CLAIM_PIPE_SIZE);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, CLAIM_PIPE_SIZE), 0,
+		      NULL);
+
+	/**TESTPOINT: a pended writer refills space freed by a get claim */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, "0123", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), CLAIM_PIPE_SIZE, NULL);
+
+	/**TESTPOINT: a put claim on a full pipe waits for a reader */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			K_MSEC(TIMEOUT_MS >> 1));
+	ret = k_pipe_put_claim(&claim_pipe, &data, 4, K_MSEC(TIMEOUT_MS * 4));
+	zassert_equal(ret, 4, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 0), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_mem_equal(rx_buf, "4567", 4, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/seqlock.h>
+#include <sys/rcu.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+/* Written as a pair that readers must always see matching */
+static struct k_seqlock pair_lock;
+static volatile uint32_t pair_a, pair_b = ~0U;
+static uint32_t pair_writes;
+
+static void pair_write(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_seqlock_write_lock(&pair_lock);
+
+	pair_writes++;
+	pair_a = pair_writes;
+	pair_b = ~pair_writes;
+
+	k_seqlock_write_unlock(&pair_lock, key);
+}
+
+K_TIMER_DEFINE(pair_timer, pair_write, NULL);
+
+/**
+ * @brief Tests for sequence locks and RCU
+ *
+ * @defgroup kernel_rcu_tests Sequence lock and RCU Tests
+ *
+ * @ingroup all_tests
+ *
+ * @{
+ * @}
+ */
+
+/**
+ * @brief Test that a seqlock tracks writers
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_seqlock_read_begin(), k_seqlock_read_retry()
+ */
+void test_seqlock_basic(void)
+{
+	static struct k_seqlock sl;
+	k_spinlock_key_t key;
+	atomic_val_t seq;
+
+	seq = k_seqlock_read_begin(&sl);
+	zassert_false(k_seqlock_read_retry(&sl, seq),
+		      "retry without a writer");
+
+	key = k_seqlock_write_lock(&sl);
+	zassert_true((atomic_get(&sl.seq) & 1) != 0, "writer not flagged");
+	k_seqlock_write_unlock(&sl, key);
+
+	zassert_true(k_seqlock_read_retry(&sl, seq), "writer went unnoticed");
+
+	seq = k_seqlock_read_begin(&sl);
+	zassert_false(k_seqlock_read_retry(&sl, seq),
+		      "retry without a writer");
+}
+
+/**
+ * @brief Test seqlock readers against a writer in an ISR
+ *
+ * @details Readers are slowed down so that the timer writer regularly
+ * gets in the middle of a read, and check they never accept a torn pair.
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_seqlock_write_lock(), k_seqlock_write_unlock()
+ */
+void test_seqlock_isr_writer(void)
+{
+	uint32_t a, b, reads = 0U, retries = 0U;
+	int64_t end;
+	atomic_val_t seq;
+
+	k_timer_start(&pair_timer, K_TICKS(1), K_TICKS(1));
+
+	end = k_uptime_get() + 200;
+	while (k_uptime_get() < end) {
+		do {
+			seq = k_seqlock_read_begin(&pair_lock);
+			a = pair_a;
+			k_busy_wait(50);
+			b = pair_b;
+			retries++;
+		} while (k_seqlock_read_retry(&pair_lock, seq));
+
+		retries--;
+		reads++;
+		zassert_equal(a, ~b, "torn read %x %x", a, b);
+	}
+
+	k_timer_stop(&pair_timer);
+
+	zassert_true(pair_writes > 0U, "writer never ran");
+	zassert_true(retries > 0U, "writer never interrupted a reader");
+	TC_PRINT("%u reads, %u retries, %u writes\n",
+		 reads, retries, pair_writes);
+}
+
+struct cfg {
+	uint32_t gen;
+};
+
+static struct cfg cfgs[2] = { { .gen = 1U }, { .gen = 2U } };
+static atomic_ptr_t cur_cfg = ATOMIC_PTR_INIT(&cfgs[0]);
+static volatile bool high_ran;
+
+static void high_entry(void *p1, void *p2, void *p3)
+{
+	high_ran = true;
+}
+
+/**
+ * @brief Test that RCU read sections hold off preemption and nest
+ *
+ * Runs with the other CPUs stopped, which would otherwise pick up the
+ * higher priority thread at once.
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_read_lock(), k_rcu_read_unlock()
+ */
+void test_rcu_read_section(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	struct cfg *cfg;
+
+	/* The test thread is cooperative, it must be preemptible here */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+	high_ran = false;
+
+	k_rcu_read_lock();
+	k_rcu_read_lock();
+	cfg = k_rcu_dereference(cur_cfg);
+	zassert_equal(cfg->gen, 1U, "wrong pointer");
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, high_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_false(high_ran, "preempted in a read section");
+
+	k_rcu_read_unlock();
+	zassert_false(high_ran, "preempted in a nested read section");
+
+	k_rcu_read_unlock();
+	zassert_true(high_ran, "no reschedule leaving the read section");
+
+	k_thread_join(&tdata, K_FOREVER);
+	k_thread_priority_set(k_current_get(), prio);
+}
+
+static void rcu_isr_reader(const void *arg)
+{
+	struct cfg **out = (struct cfg **)arg;
+
+	k_rcu_read_lock();
+	*out = k_rcu_dereference(cur_cfg);
+	k_rcu_read_unlock();
+}
+
+/**
+ * @brief Test publishing a pointer and waiting for a grace period
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_assign_pointer(), k_rcu_synchronize()
+ */
+void test_rcu_update(void)
+{
+	struct cfg *old, *seen = NULL;
+
+	old = k_rcu_dereference(cur_cfg);
+	k_rcu_assign_pointer(cur_cfg, &cfgs[1]);
+	k_rcu_synchronize();
+
+	/* Nobody can hold on to the old copy anymore */
+	old->gen = 0U;
+
+	irq_offload(rcu_isr_reader, &seen);
+	zassert_equal(seen, &cfgs[1], "ISR reader missed the update");
+	zassert_equal(seen->gen, 2U, "wrong data");
+
+	k_rcu_assign_pointer(cur_cfg, old);
+	k_rcu_synchronize();
+	old->gen = 1U;
+}
+
+void test_main(void)
+{
+	ztest_test_suite(rcu,
+			 ztest_unit_test(test_seqlock_basic),
+			 ztest_unit_test(test_seqlock_isr_writer),
+			 ztest_1cpu_unit_test(test_rcu_read_section),
+			 ztest_unit_test(test_rcu_update));
+	ztest_run_test_suite(rcu);
+}
@@ -630,6 +630,100 @@ void test_smp_ipi(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_IPI_STATS
+static volatile int ipi_thread_ran;
+static volatile bool ipi_busy_spin;
+static volatile int ipi_busy_cpu;
+
+static void ipi_thread_entry(void *p1, void *p2, void *p3)
+{
+	ipi_thread_ran = 1;
+}
+
+static void ipi_busy_entry(void *p1, void *p2, void *p3)
+{
+	ipi_busy_cpu = curr_cpu();
+	while (ipi_busy_spin) {
+	}
+}
+#endif
+
+/**
+ * @brief Test scheduler IPI statistics
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @details Starts a thread while the scheduler is locked on this CPU,
+ * so that it has to run on another one.  The IPIs sent to the other
+ * CPUs, all idle, must be counted, and one of them must have caused a
+ * switch.  Then keeps another CPU busy with a higher priority thread
+ * and starts a thread again: with CONFIG_SCHED_IPI_TARGETED only the
+ * CPUs that are idle or run a lower priority preemptible thread are
+ * interrupted, so the busy CPU is left alone.
+ *
+ * @see k_sched_ipi_stats_get()
+ */
+void test_smp_ipi_stats(void)
+{
+#ifndef CONFIG_SCHED_IPI_STATS
+	ztest_test_skip();
+#else
+	struct k_sched_ipi_stats before, after;
+
+	zassert_equal(k_sched_ipi_stats_get(CONFIG_MP_NUM_CPUS, &after),
+		      -EINVAL, NULL);
+	zassert_equal(k_sched_ipi_stats_get(-1, &before), 0, NULL);
+
+	ipi_thread_ran = 0;
+	k_sched_lock();
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, ipi_thread_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	for (int i = 0; (i < TIMEOUT) && !ipi_thread_ran; i++) {
+		k_busy_wait(1000);
+	}
+	zassert_true(ipi_thread_ran, "thread did not run on another CPU");
+
+	zassert_equal(k_sched_ipi_stats_get(-1, &after), 0, NULL);
+	k_sched_unlock();
+	k_thread_join(&t2, K_FOREVER);
+
+	/**TESTPOINT: every idle CPU is interrupted, at least one switches */
+	zassert_equal(after.sent - before.sent, CONFIG_MP_NUM_CPUS - 1,
+		      "unexpected IPI count %u", after.sent - before.sent);
+	zassert_true(after.switched - before.switched >= 1,
+		     "IPI did not cause a switch");
+	zassert_true(after.received - before.received >=
+		     after.switched - before.switched, NULL);
+
+	ipi_busy_cpu = -1;
+	ipi_busy_spin = true;
+	k_sched_lock();
+	k_thread_create(&tthread[0], tstack[0], STACK_SIZE, ipi_busy_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	for (int i = 0; (i < TIMEOUT) && (ipi_busy_cpu < 0); i++) {
+		k_busy_wait(1000);
+	}
+	zassert_true(ipi_busy_cpu >= 0, "busy thread did not start");
+
+	zassert_equal(k_sched_ipi_stats_get(-1, &before), 0, NULL);
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, ipi_thread_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_equal(k_sched_ipi_stats_get(-1, &after), 0, NULL);
+
+	ipi_busy_spin = false;
+	k_sched_unlock();
+	k_thread_join(&tthread[0], K_FOREVER);
+	k_thread_join(&t2, K_FOREVER);
+
+	/**TESTPOINT: a CPU running a higher priority thread is skipped */
+	zassert_equal(after.sent - before.sent,
+		      IS_ENABLED(CONFIG_SCHED_IPI_TARGETED) ?
+		      CONFIG_MP_NUM_CPUS - 2 : CONFIG_MP_NUM_CPUS - 1,
+		      "unexpected IPI count %u with CPU %d busy",
+		      after.sent - before.sent, ipi_busy_cpu);
+#endif
+}
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
 {
 	static int trigger;
@@ -965,6 +1059,7 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
+			 ztest_unit_test(test_smp_ipi_stats),
 			 ztest_unit_test(test_get_cpu),
 			 ztest_unit_test(test_fatal_on_smp),
 			 ztest_unit_test(test_workq_on_smp),
@@ -605,6 +605,71 @@ void test_k_busy_wait_user(void)
 	k_thread_abort(tid);
 }
 
+#define SCHED_STATS_LOOPS 4
+
+static struct k_sem sched_stats_wake;
+static struct k_sem sched_stats_done;
+
+static void sched_stats_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < SCHED_STATS_LOOPS; i++) {
+		k_sem_take(&sched_stats_wake, K_FOREVER);
+		k_busy_wait(20 * USEC_PER_MSEC);
+		k_sem_give(&sched_stats_done);
+	}
+}
+
+/**
+ * @brief Test the thread scheduling statistics
+ *
+ * @details Wake up a preemptible thread which then gets preempted by
+ * the test thread returning from a sleep, and check that both are
+ * counted.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_sched_stats_get()
+ */
+void test_thread_sched_stats(void)
+{
+#ifndef CONFIG_SCHED_THREAD_STATS
+	ztest_test_skip();
+#else
+	k_thread_sched_stats_t stats;
+	k_tid_t tid;
+
+	zassert_equal(k_thread_sched_stats_get(NULL, &stats), -EINVAL, NULL);
+	zassert_equal(k_thread_sched_stats_get(k_current_get(), NULL),
+		      -EINVAL, NULL);
+
+	k_sem_init(&sched_stats_wake, 0, 1);
+	k_sem_init(&sched_stats_done, 0, 1);
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, sched_stats_entry,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			      K_NO_WAIT);
+
+	for (int i = 0; i < SCHED_STATS_LOOPS; i++) {
+		/* let the thread block before waking it up */
+		k_msleep(1);
+		k_sem_give(&sched_stats_wake);
+		k_msleep(5);
+		k_sem_take(&sched_stats_done, K_FOREVER);
+	}
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_thread_sched_stats_get(tid, &stats), 0, NULL);
+
+	/** TESTPOINT: each loop wakes the thread and preempts it once */
+	zassert_true(stats.wakeups >= SCHED_STATS_LOOPS, "%u wakeups",
+		     stats.wakeups);
+	zassert_true(stats.preemptions >= SCHED_STATS_LOOPS,
+		     "%u preemptions", stats.preemptions);
+	zassert_true(stats.total_latency_cycles <= stats.ready_cycles, NULL);
+	zassert_true(stats.max_latency_cycles <= stats.total_latency_cycles,
+		     NULL);
+#endif
+}
+
 #define INT_ARRAY_SIZE 128
 int large_stack(size_t *space)
 {
@@ -696,6 +761,7 @@ void test_main(void)
 			 ztest_unit_test(test_abort_from_isr_not_self),
 			 ztest_user_unit_test(test_thread_timeout_remaining_expires),
 			 ztest_unit_test(test_k_busy_wait),
+			 ztest_1cpu_unit_test(test_thread_sched_stats),
 			 ztest_1cpu_user_unit_test(test_k_busy_wait_user)
 			 );
 
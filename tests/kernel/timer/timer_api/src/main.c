@@ -65,6 +65,12 @@ static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
 
+#define SLACK_TICKS 16
+#define SLACK_TIMERS 4
+#define SLACK_PERIOD 100
+#define SLACK_PERIODS 3
+static struct k_timer slack_timer[SLACK_TIMERS];
+
 static ZTEST_BMEM struct timer_data tdata;
 
 extern void test_time_conversions(void);
@@ -811,6 +817,121 @@ void test_sleep_abs(void)
 		     start + sleep_ticks, end, late);
 }
 
+/**
+ * @brief Test timers with slack sharing an expiry
+ *
+ * @details Start timers a tick apart, each allowed to expire up to
+ * SLACK_TICKS late.  Their expiries must stay within their windows and
+ * land on multiples of SLACK_TICKS, so that they are served by at most
+ * two wakeups instead of one each.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack(void)
+{
+#ifndef CONFIG_TIMEOUT_SLACK
+	ztest_test_skip();
+#else
+	k_ticks_t expires[SLACK_TIMERS];
+	int64_t start, end;
+#ifdef CONFIG_IDLE_STATS
+	struct k_idle_stats before, after;
+
+	zassert_equal(k_idle_stats_get(CONFIG_MP_NUM_CPUS, &before), -EINVAL,
+		      NULL);
+	zassert_equal(k_idle_stats_get(-1, &before), 0, NULL);
+#endif
+
+	k_usleep(1); /* tick align */
+
+	start = k_uptime_ticks();
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		k_timer_slack_set(&slack_timer[i], K_TICKS(SLACK_TICKS));
+		k_timer_start(&slack_timer[i], K_TICKS(DURATION + i),
+			      K_NO_WAIT);
+		expires[i] = k_timer_expires_ticks(&slack_timer[i]);
+	}
+	end = k_uptime_ticks();
+
+	/** TESTPOINT: expiries are delayed within the slack, aligned */
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		zassert_true(expires[i] >= start + DURATION + i &&
+			     expires[i] <= end + DURATION + i + SLACK_TICKS,
+			     "timer %d expires at %lld, started at %lld",
+			     i, expires[i], start);
+		zassert_equal(expires[i] % SLACK_TICKS, 0,
+			      "timer %d expires at %lld", i, expires[i]);
+	}
+
+	zassert_equal(k_timer_status_sync(&slack_timer[SLACK_TIMERS - 1]), 1,
+		      NULL);
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		if (i < SLACK_TIMERS - 1) {
+			zassert_equal(k_timer_status_get(&slack_timer[i]), 1,
+				      NULL);
+		}
+		k_timer_slack_set(&slack_timer[i], K_NO_WAIT);
+	}
+
+#ifdef CONFIG_IDLE_STATS
+	/** TESTPOINT: the CPU idled while waiting for the timers */
+	zassert_equal(k_idle_stats_get(-1, &after), 0, NULL);
+	zassert_true(after.wakeups > before.wakeups, NULL);
+	zassert_true(after.residency_cycles > before.residency_cycles, NULL);
+	TC_PRINT("%u idle wakeups for %d timers\n",
+		 after.wakeups - before.wakeups, SLACK_TIMERS);
+#endif
+#endif
+}
+
+/**
+ * @brief Test that slack does not make a periodic timer drift
+ *
+ * @details Start a periodic timer whose period is not a multiple of
+ * SLACK_TICKS, so that each expiry gets delayed.  Every expiry must
+ * stay within the slack of its nominal time, counted in whole periods
+ * from the start.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack_periodic(void)
+{
+#ifndef CONFIG_TIMEOUT_SLACK
+	ztest_test_skip();
+#else
+	struct k_timer *timer = &slack_timer[0];
+	k_ticks_t expires;
+	int64_t start, end;
+
+	k_usleep(1); /* tick align */
+
+	start = k_uptime_ticks();
+	k_timer_slack_set(timer, K_TICKS(SLACK_TICKS));
+	k_timer_start(timer, K_TICKS(SLACK_PERIOD), K_TICKS(SLACK_PERIOD));
+	end = k_uptime_ticks();
+
+	/** TESTPOINT: expiries stay within the slack of the period */
+	for (int i = 1; i <= SLACK_PERIODS; i++) {
+		expires = k_timer_expires_ticks(timer);
+		if (expires < start + i * SLACK_PERIOD ||
+		    expires > end + i * SLACK_PERIOD + SLACK_TICKS) {
+			k_timer_stop(timer);
+			zassert_unreachable("expiry %d at %lld, started at %lld",
+					    i, expires, start);
+		}
+
+		zassert_equal(k_timer_status_sync(timer), 1, NULL);
+	}
+
+	k_timer_stop(timer);
+	k_timer_slack_set(timer, K_NO_WAIT);
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -832,6 +953,9 @@ void test_main(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		timer_init(&slack_timer[i], NULL, NULL);
+	}
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
@@ -853,6 +977,8 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
 			 ztest_user_unit_test(test_timeout_abs),
-			 ztest_user_unit_test(test_sleep_abs));
+			 ztest_user_unit_test(test_sleep_abs),
+			 ztest_unit_test(test_timer_slack),
+			 ztest_unit_test(test_timer_slack_periodic));
 	ztest_run_test_suite(timer_api);
 }
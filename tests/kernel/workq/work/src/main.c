@@ -1265,6 +1265,128 @@ static void test_1cpu_queue_no_yield(void)
 	zassert_equal(try_queue_no_yield(&cooplo_queue), false, NULL);
 }
 
+#define BATCH_LEN 3
+
+static K_THREAD_STACK_DEFINE(batch_stack, STACK_SIZE);
+static struct k_work_q batch_queue;
+static K_THREAD_STACK_DEFINE(rival_stack, STACK_SIZE);
+static struct k_thread rival_thread;
+static struct k_work batch_work[BATCH_LEN];
+
+/* Order in which batch items ('w') and the rival thread ('c') ran */
+static char batch_seq[BATCH_LEN + 2];
+static atomic_t batch_seq_len;
+
+static void batch_seq_add(char c)
+{
+	batch_seq[atomic_inc(&batch_seq_len)] = c;
+}
+
+static void batch_handler(struct k_work *work)
+{
+	batch_seq_add('w');
+}
+
+static void rival_entry(void *p1, void *p2, void *p3)
+{
+	batch_seq_add('c');
+}
+
+/* Submit a batch to a queue running at the same priority as a rival
+ * thread that is made ready right after, and return the order in
+ * which they ran.
+ */
+static const char *run_batch_with_rival(struct k_work_q *wq)
+{
+	struct k_work *works[BATCH_LEN];
+	int rc;
+
+	memset(batch_seq, 0, sizeof(batch_seq));
+	atomic_clear(&batch_seq_len);
+	for (int i = 0; i < BATCH_LEN; i++) {
+		k_work_init(&batch_work[i], batch_handler);
+		works[i] = &batch_work[i];
+	}
+
+	rc = k_work_submit_batch_to_queue(wq, works, BATCH_LEN);
+	zassert_equal(rc, BATCH_LEN, NULL);
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(k_work_busy_get(&batch_work[i]), K_WORK_QUEUED,
+			      NULL);
+	}
+
+	/* Submitting queued items again is accepted and does nothing */
+	rc = k_work_submit_batch_to_queue(wq, works, BATCH_LEN);
+	zassert_equal(rc, BATCH_LEN, NULL);
+
+	k_thread_create(&rival_thread, rival_stack, STACK_SIZE, rival_entry,
+			NULL, NULL, NULL,
+			k_thread_priority_get(k_work_queue_thread_get(wq)),
+			0, K_NO_WAIT);
+
+	/* Nothing has run since the test thread is cooperative */
+	zassert_equal(atomic_get(&batch_seq_len), 0, NULL);
+
+	k_thread_join(&rival_thread, K_FOREVER);
+	rc = k_work_queue_drain(wq, false);
+	zassert_true(rc >= 0, NULL);
+	zassert_equal(atomic_get(&batch_seq_len), BATCH_LEN + 1, NULL);
+
+	return batch_seq;
+}
+
+/* Verify batch submission, and that a batch queue only yields between
+ * batches.
+ */
+static void test_1cpu_queue_batch(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.batch",
+		.batch = true,
+	};
+	struct k_work *works[BATCH_LEN] = { &batch_work[0] };
+	struct k_work_q unstarted = {};
+	const char *seq;
+	int rc;
+
+	/* An empty batch does nothing, a rejected first item reports
+	 * its error
+	 */
+	rc = k_work_submit_batch_to_queue(&preempt_queue, works, 0);
+	zassert_equal(rc, 0, NULL);
+	k_work_init(&batch_work[0], batch_handler);
+	rc = k_work_submit_batch_to_queue(&unstarted, works, 1);
+	zassert_equal(rc, -ENODEV, NULL);
+
+	k_work_queue_start(&batch_queue, batch_stack, STACK_SIZE,
+			    PREEMPT_PRIORITY, &cfg);
+	zassert_equal(batch_queue.flags,
+		      K_WORK_QUEUE_STARTED | K_WORK_QUEUE_BATCH, NULL);
+
+	/* A regular queue yields after each item */
+	seq = run_batch_with_rival(&preempt_queue);
+	zassert_equal(strcmp(seq, "wcww"), 0, "sequence %s", seq);
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	k_work_queue_stats_reset(&batch_queue);
+#endif
+
+	/* A batch queue runs all of them first */
+	seq = run_batch_with_rival(&batch_queue);
+	zassert_equal(strcmp(seq, "wwwc"), 0, "sequence %s", seq);
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	struct k_work_queue_stats stats;
+
+	k_work_queue_stats_get(&batch_queue, &stats);
+	zassert_equal(stats.depth, 0, NULL);
+	zassert_equal(stats.max_depth, BATCH_LEN, NULL);
+	zassert_equal(stats.executed, BATCH_LEN, NULL);
+	zassert_true(stats.total_wait_cycles >= stats.max_wait_cycles, NULL);
+	zassert_true(stats.total_run_cycles >= stats.max_run_cycles, NULL);
+#endif
+}
+
 /* Basic functionality with the system work queue. */
 static void test_1cpu_system_queue(void)
 {
@@ -1554,6 +1676,7 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_1cpu_delayed_cancel_sync_wait),
 			 ztest_1cpu_unit_test(test_1cpu_delayed_cancel),
 			 ztest_1cpu_unit_test(test_1cpu_queue_no_yield),
+			 ztest_1cpu_unit_test(test_1cpu_queue_batch),
 			 ztest_1cpu_unit_test(test_1cpu_system_queue),
 			 ztest_1cpu_unit_test(test_1cpu_system_schedule),
 			 ztest_1cpu_unit_test(test_1cpu_system_reschedule),
@@ -52,6 +52,11 @@ void *scratchmem[SCRATCH_SZ / sizeof(void *)];
  */
 #define ITERATION_COUNT (2 * SMALL_HEAP_SZ)
 
+/* Operation count for the long running fragmentation test, which
+ * skips the per-operation validation and can afford many more.
+ */
+#define LONG_ITERATION_COUNT (16 * SMALL_HEAP_SZ)
+
 /* Simple dumb hash function of the size and address */
 static size_t fill_token(void *p, size_t sz)
 {
@@ -204,6 +209,127 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* Book-keeping for the timed workload of test_frag_latency() */
+struct frag_stats {
+	struct sys_heap *heap;
+	uint32_t alloc_max, free_max;
+	uint64_t alloc_total, free_total;
+	uint32_t allocs, frees;
+};
+
+static void *timed_alloc(void *arg, size_t bytes)
+{
+	struct frag_stats *st = arg;
+	uint32_t t0 = k_cycle_get_32();
+	void *ret = sys_heap_alloc(st->heap, bytes);
+	uint32_t dt = k_cycle_get_32() - t0;
+
+	st->alloc_max = MAX(st->alloc_max, dt);
+	st->alloc_total += dt;
+	st->allocs++;
+	return ret;
+}
+
+static void timed_free(void *arg, void *p)
+{
+	struct frag_stats *st = arg;
+	uint32_t t0 = k_cycle_get_32();
+
+	sys_heap_free(st->heap, p);
+
+	uint32_t dt = k_cycle_get_32() - t0;
+
+	st->free_max = MAX(st->free_max, dt);
+	st->free_total += dt;
+	st->frees++;
+}
+
+/* Largest block that can currently be allocated, by bisection */
+static size_t largest_alloc(struct sys_heap *heap, size_t limit)
+{
+	size_t lo = 0, hi = limit;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi + 1) / 2;
+		void *p = sys_heap_alloc(heap, mid);
+
+		if (p != NULL) {
+			sys_heap_free(heap, p);
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	return lo;
+}
+
+/* Total bytes that can still be allocated, by greedily taking the
+ * largest possible block until the heap is exhausted.
+ */
+static size_t free_bytes(struct sys_heap *heap, size_t limit)
+{
+	static void *blocks[SMALL_HEAP_SZ / 8];
+	size_t total = 0;
+	int n = 0;
+
+	while (n < ARRAY_SIZE(blocks)) {
+		size_t sz = largest_alloc(heap, limit);
+
+		if (sz == 0) {
+			break;
+		}
+		blocks[n++] = sys_heap_alloc(heap, sz);
+		total += sz;
+	}
+	while (n > 0) {
+		sys_heap_free(heap, blocks[--n]);
+	}
+	return total;
+}
+
+/* Long running fragmentation and latency test.  Runs a long random
+ * workload over the small heap, without the per-operation validation
+ * of the other tests so that the timings mean something, and reports
+ * the worst case and average cycles per alloc and free along with
+ * how much of the remaining free memory is still usable as a single
+ * block.  The workload is deterministic, so the numbers can be
+ * compared between heap configurations (e.g. with and without
+ * CONFIG_SYS_HEAP_TLSF).
+ */
+static void test_frag_latency(void)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	struct frag_stats st = { .heap = &heap };
+
+	TC_PRINT("Testing long running (%d byte) heap\n",
+		 (int) SMALL_HEAP_SZ);
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_stress(timed_alloc, timed_free, &st,
+			SMALL_HEAP_SZ, LONG_ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	zassert_equal(st.allocs, result.total_allocs, "");
+	zassert_equal(st.frees, result.total_frees, "");
+
+	log_result(SMALL_HEAP_SZ, &result);
+
+	size_t largest = largest_alloc(&heap, SMALL_HEAP_SZ);
+	size_t avail = free_bytes(&heap, SMALL_HEAP_SZ);
+
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	TC_PRINT("alloc max %u avg %u, free max %u avg %u cycles\n",
+		 st.alloc_max, (uint32_t)(st.alloc_total / st.allocs),
+		 st.free_max, (uint32_t)(st.free_total / MAX(st.frees, 1U)));
+	TC_PRINT("largest block %d of %d free bytes (%d%%)\n",
+		 (int) largest, (int) avail,
+		 avail ? (int) (100 * largest / avail) : 0);
+}
+
 /* Simple clobber detection */
 void realloc_fill_block(uint8_t *p, size_t sz)
 {
@@ -321,6 +447,23 @@ static void test_realloc(void)
 	zassert_true(sys_heap_validate(&heap), "invalid heap");
 	zassert_true(p2 != p3,
 		     "Realloc should have moved %p", p2);
+
+	/* Allocate three blocks, free the first, then expand the
+	 * second.  Validate that it moves down into the free space
+	 * instead of being allocated elsewhere.
+	 */
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	p1 = sys_heap_alloc(&heap, 64);
+	p2 = sys_heap_alloc(&heap, 64);
+	realloc_fill_block(p2, 64);
+	p3 = sys_heap_alloc(&heap, 64);
+	sys_heap_free(&heap, p1);
+	p1 = sys_heap_realloc(&heap, p2, 96);
+
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	zassert_true(p1 < p2,
+		     "Realloc should have expanded down %p -> %p", p2, p1);
+	zassert_true(realloc_check_block(p1, p2, 64), "data changed");
 }
 
 void test_main(void)
@@ -329,7 +472,8 @@ void test_main(void)
 			 ztest_unit_test(test_realloc),
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_frag_latency)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
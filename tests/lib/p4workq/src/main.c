@@ -270,13 +270,20 @@ static void test_p4wq_simple(void)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+extern void test_p4wq_ws_fork_join(void);
+extern void test_p4wq_ws_submit(void);
+extern void test_p4wq_ws_overflow(void);
+
 void test_main(void)
 {
 	ztest_test_suite(lib_p4wq_test,
 			 ztest_1cpu_unit_test(test_p4wq_simple),
 			 ztest_unit_test(test_resubmit),
 			 ztest_unit_test(test_fill_queue),
-			 ztest_unit_test(test_stress));
+			 ztest_unit_test(test_stress),
+			 ztest_unit_test(test_p4wq_ws_fork_join),
+			 ztest_unit_test(test_p4wq_ws_submit),
+			 ztest_unit_test(test_p4wq_ws_overflow));
 
 	ztest_run_test_suite(lib_p4wq_test);
 }
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+#include <sys/p4wq_ws.h>
+
+#define NUM_WORKERS (CONFIG_MP_NUM_CPUS + 1)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+#define FIB_N 14
+#define NUM_ROOTS 8
+
+K_P4WQ_WS_DEFINE(ws, NUM_WORKERS, 4096);
+
+struct fib_task {
+	struct k_p4wq_ws_task task;
+	int n;
+	int result;
+};
+
+static atomic_t tasks_run;
+
+static void fib_handler(struct k_p4wq_ws_task *task)
+{
+	struct fib_task *f = CONTAINER_OF(task, struct fib_task, task);
+
+	atomic_inc(&tasks_run);
+
+	if (f->n < 2) {
+		f->result = f->n;
+		return;
+	}
+
+	struct fib_task a = { .task.handler = fib_handler, .n = f->n - 1 };
+	struct fib_task b = { .task.handler = fib_handler, .n = f->n - 2 };
+
+	k_p4wq_ws_spawn(task, &a.task);
+	k_p4wq_ws_spawn(task, &b.task);
+	k_p4wq_ws_join(task);
+
+	f->result = a.result + b.result;
+}
+
+static int fib(int n)
+{
+	return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+/* Number of tasks the recursive fib_handler() runs for n */
+static int fib_calls(int n)
+{
+	return n < 2 ? 1 : 1 + fib_calls(n - 1) + fib_calls(n - 2);
+}
+
+static uint32_t total_executed(void)
+{
+	uint32_t n = 0;
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		n += ws.workers[i].executed;
+	}
+
+	return n;
+}
+
+/* Recursive fork/join: children are joined, results are correct and
+ * every task runs exactly once
+ */
+void test_p4wq_ws_fork_join(void)
+{
+	struct fib_task root = { .task.handler = fib_handler, .n = FIB_N };
+
+	zassert_equal(k_p4wq_ws_start(&ws, WORKER_PRIO, NULL), 0, NULL);
+	zassert_equal(k_p4wq_ws_start(&ws, WORKER_PRIO, NULL), -EBUSY, NULL);
+
+	atomic_clear(&tasks_run);
+	zassert_equal(k_p4wq_ws_submit(&ws, &root.task, 0), 0, NULL);
+	zassert_equal(k_p4wq_ws_wait(&root.task, K_FOREVER), 0, NULL);
+
+	zassert_equal(root.result, fib(FIB_N), "wrong result %d", root.result);
+	zassert_equal(atomic_get(&tasks_run), fib_calls(FIB_N), NULL);
+	zassert_equal(total_executed(), fib_calls(FIB_N), NULL);
+
+	k_p4wq_ws_stop(&ws);
+}
+
+/* Independent root tasks submitted to every worker all complete,
+ * also after the executor has been restarted
+ */
+void test_p4wq_ws_submit(void)
+{
+	static struct fib_task roots[NUM_ROOTS];
+
+	for (int run = 0; run < 2; run++) {
+		zassert_equal(k_p4wq_ws_start(&ws, WORKER_PRIO, NULL), 0,
+			      NULL);
+
+		for (int i = 0; i < NUM_ROOTS; i++) {
+			roots[i].task.handler = fib_handler;
+			roots[i].n = i;
+			zassert_equal(k_p4wq_ws_submit(&ws, &roots[i].task,
+						       run == 0 ? i % NUM_WORKERS :
+						       K_P4WQ_WS_ANY_WORKER),
+				      0, NULL);
+		}
+
+		for (int i = 0; i < NUM_ROOTS; i++) {
+			zassert_equal(k_p4wq_ws_wait(&roots[i].task, K_FOREVER),
+				      0, NULL);
+			zassert_equal(roots[i].result, fib(i), NULL);
+		}
+
+		k_p4wq_ws_stop(&ws);
+	}
+}
+
+static struct k_p4wq_ws_task leaves[CONFIG_P4WQ_WS_DEQUE_SIZE * 2];
+
+static void leaf_handler(struct k_p4wq_ws_task *task)
+{
+	ARG_UNUSED(task);
+	atomic_inc(&tasks_run);
+}
+
+static void wide_handler(struct k_p4wq_ws_task *task)
+{
+	for (int i = 0; i < ARRAY_SIZE(leaves); i++) {
+		leaves[i].handler = leaf_handler;
+		k_p4wq_ws_spawn(task, &leaves[i]);
+	}
+
+	/* No explicit join, returning waits for the children */
+}
+
+/* More children than a deque holds: the excess runs inline */
+void test_p4wq_ws_overflow(void)
+{
+	struct k_p4wq_ws_task root = { .handler = wide_handler };
+
+	zassert_equal(k_p4wq_ws_start(&ws, WORKER_PRIO, NULL), 0, NULL);
+
+	atomic_clear(&tasks_run);
+	zassert_equal(k_p4wq_ws_submit(&ws, &root, K_P4WQ_WS_ANY_WORKER), 0,
+		      NULL);
+	zassert_equal(k_p4wq_ws_wait(&root, K_FOREVER), 0, NULL);
+	zassert_equal(atomic_get(&tasks_run), ARRAY_SIZE(leaves), NULL);
+
+	k_p4wq_ws_stop(&ws);
+}
@@ -0,0 +1,445 @@
+/* main.c - Software TCP segmentation and coalescing tests */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/dummy.h>
+
+#include <ztest.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define MSS 100
+#define DATA_LEN (3 * MSS + MSS / 2)
+#define SEGS_MAX 8
+#define SEQ 1000U
+#define ACK_SEQ 5000U
+#define PEER_PORT 4242
+#define MY_PORT 80
+#define WINDOW 8192
+
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *test_iface;
+static uint8_t payload[DATA_LEN];
+
+/* Packets given to the driver, kept for the test to look at */
+static struct net_pkt *sent[SEGS_MAX];
+static int sent_count;
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+
+	test_iface = iface;
+}
+
+static int test_dev_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	if (sent_count >= SEGS_MAX) {
+		return -ENOBUFS;
+	}
+
+	sent[sent_count++] = net_pkt_ref(pkt);
+
+	return 0;
+}
+
+static int test_dev_send_burst(const struct device *dev,
+			       struct net_pkt **pkts, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (test_dev_send(dev, pkts[i]) < 0) {
+			return i ? i : -ENOBUFS;
+		}
+	}
+
+	return count;
+}
+
+static int test_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct dummy_api test_dev_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_dev_send,
+	.send_burst = test_dev_send_burst,
+};
+
+NET_DEVICE_INIT(gso_gro_test, "gso_gro_test",
+		test_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&test_dev_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+		NET_IPV6_MTU);
+
+static void sent_flush(void)
+{
+	for (int i = 0; i < sent_count; i++) {
+		net_pkt_unref(sent[i]);
+	}
+
+	sent_count = 0;
+}
+
+static size_t ip_hdr_len(sa_family_t family)
+{
+	return family == AF_INET ? sizeof(struct net_ipv4_hdr) :
+		sizeof(struct net_ipv6_hdr);
+}
+
+/* A TCP segment from the peer holding len bytes of the payload from
+ * offset on, or a GSO packet of several when gso_size is set
+ */
+static struct net_pkt *tcp_pkt_build(sa_family_t family, uint16_t sport,
+				     uint32_t seq, uint8_t flags,
+				     size_t offset, size_t len,
+				     uint16_t gso_size)
+{
+	struct tcphdr th = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, sizeof(th) + len, family,
+					IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "cannot allocate packet");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &peer_addr4, &my_addr4);
+	} else {
+		ret = net_ipv6_create(pkt, &peer_addr6, &my_addr6);
+	}
+	zassert_equal(ret, 0, "cannot create IP header");
+
+	th.th_sport = htons(sport);
+	th.th_dport = htons(MY_PORT);
+	th.th_seq = htonl(seq);
+	th.th_ack = htonl(ACK_SEQ);
+	th.th_off = 5;
+	th.th_flags = flags;
+	th.th_win = htons(WINDOW);
+
+	zassert_equal(net_pkt_write(pkt, &th, sizeof(th)), 0, NULL);
+	zassert_equal(net_pkt_write(pkt, &payload[offset], len), 0, NULL);
+
+	net_pkt_set_gso_size(pkt, gso_size);
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+	zassert_equal(ret, 0, "cannot finalize packet");
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Read the TCP header and data of a packet, and check its IP length */
+static size_t tcp_pkt_read(struct net_pkt *pkt, sa_family_t family,
+			   struct tcphdr *th, uint8_t *data, size_t max_len)
+{
+	size_t len = net_pkt_get_len(pkt) - ip_hdr_len(family) - sizeof(*th);
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} ip;
+
+	zassert_true(len <= max_len, "packet too long, %zu bytes", len);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_equal(net_pkt_read(pkt, &ip, ip_hdr_len(family)), 0, NULL);
+	if (family == AF_INET) {
+		zassert_equal(ntohs(ip.ipv4.len), net_pkt_get_len(pkt),
+			      "wrong IPv4 length");
+	} else {
+		zassert_equal(ntohs(ip.ipv6.len) + sizeof(ip.ipv6),
+			      net_pkt_get_len(pkt), "wrong IPv6 length");
+	}
+
+	zassert_equal(net_pkt_read(pkt, th, sizeof(*th)), 0, NULL);
+	zassert_equal(net_pkt_read(pkt, data, len), 0, NULL);
+
+	net_pkt_cursor_init(pkt);
+
+	return len;
+}
+
+static void gso_check(sa_family_t family, uint8_t flags)
+{
+	struct net_pkt *pkt;
+	size_t offset = 0;
+	uint8_t data[MSS];
+	struct tcphdr th;
+	int ret;
+
+	sent_flush();
+
+	pkt = tcp_pkt_build(family, PEER_PORT, SEQ, ACK | flags, 0, DATA_LEN,
+			    MSS);
+
+	ret = net_gso_send(test_iface, pkt);
+	zassert_true(ret > 0, "GSO send failed (%d)", ret);
+	zassert_equal(sent_count, ceiling_fraction(DATA_LEN, MSS),
+		      "wrong number of segments");
+
+	for (int i = 0; i < sent_count; i++) {
+		struct net_pkt *seg = sent[i];
+		bool last = (i == sent_count - 1);
+		size_t len;
+
+		/** TESTPOINT: each segment has valid checksums */
+		if (family == AF_INET) {
+			zassert_equal(net_calc_chksum_ipv4(seg), 0U,
+				      "bad IPv4 checksum in segment %d", i);
+		}
+		zassert_equal(net_calc_chksum_tcp(seg), 0U,
+			      "bad TCP checksum in segment %d", i);
+		zassert_equal(net_pkt_gso_size(seg), 0, NULL);
+
+		len = tcp_pkt_read(seg, family, &th, data, sizeof(data));
+
+		/** TESTPOINT: the data follows on, at the right sequence */
+		zassert_equal(len, MIN(MSS, DATA_LEN - offset),
+			      "wrong length of segment %d", i);
+		zassert_equal(ntohl(th.th_seq), SEQ + offset,
+			      "wrong sequence in segment %d", i);
+		zassert_equal(ntohl(th.th_ack), ACK_SEQ, NULL);
+		zassert_mem_equal(data, &payload[offset], len,
+				  "wrong data in segment %d", i);
+
+		/** TESTPOINT: only the last segment pushes or ends */
+		zassert_equal(th.th_flags, last ? (ACK | flags) : ACK,
+			      "wrong flags 0x%02x in segment %d",
+			      th.th_flags, i);
+
+		offset += len;
+	}
+
+	zassert_equal(offset, DATA_LEN, NULL);
+
+	sent_flush();
+}
+
+/**
+ * @brief Test cutting an IPv4 GSO packet into segments
+ */
+static void test_gso_ipv4(void)
+{
+	gso_check(AF_INET, PSH);
+	gso_check(AF_INET, PSH | FIN);
+}
+
+/**
+ * @brief Test cutting an IPv6 GSO packet into segments
+ */
+static void test_gso_ipv6(void)
+{
+	gso_check(AF_INET6, PSH);
+	gso_check(AF_INET6, PSH | FIN);
+}
+
+static void pkts_unref(struct net_pkt **pkts, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+/* Check that a packet holds the payload from offset on, as one segment
+ * starting at SEQ + offset
+ */
+static void gro_check_pkt(struct net_pkt *pkt, sa_family_t family,
+			  uint16_t sport, size_t offset, size_t len,
+			  uint8_t flags)
+{
+	static uint8_t data[DATA_LEN];
+	struct tcphdr th;
+
+	zassert_equal(tcp_pkt_read(pkt, family, &th, data, sizeof(data)), len,
+		      "wrong data length");
+	zassert_equal(ntohs(th.th_sport), sport, "wrong flow");
+	zassert_equal(ntohl(th.th_seq), SEQ + offset, "wrong sequence");
+	zassert_equal(th.th_flags, flags, "wrong flags 0x%02x", th.th_flags);
+	zassert_mem_equal(data, &payload[offset], len, "wrong data");
+}
+
+static void gro_merge_check(sa_family_t family)
+{
+	struct net_pkt *pkts[3];
+	size_t n;
+
+	pkts[0] = tcp_pkt_build(family, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(family, PEER_PORT, SEQ + MSS, ACK, MSS, MSS,
+				0);
+	pkts[2] = tcp_pkt_build(family, PEER_PORT, SEQ + 2 * MSS, ACK | PSH,
+				2 * MSS, MSS / 2, 0);
+
+	/** TESTPOINT: in order segments of a flow become one packet */
+	n = net_gro_receive(pkts, ARRAY_SIZE(pkts));
+	zassert_equal(n, 1, "%zu packets after coalescing", n);
+	zassert_true(net_pkt_is_chksum_ok(pkts[0]), NULL);
+	gro_check_pkt(pkts[0], family, PEER_PORT, 0, 2 * MSS + MSS / 2,
+		      ACK | PSH);
+
+	pkts_unref(pkts, n);
+}
+
+/**
+ * @brief Test coalescing contiguous segments of a flow
+ */
+static void test_gro_merge(void)
+{
+	gro_merge_check(AF_INET);
+	gro_merge_check(AF_INET6);
+}
+
+/**
+ * @brief Test that segments with a hole between them are kept apart
+ */
+static void test_gro_hole(void)
+{
+	struct net_pkt *pkts[2];
+	size_t n;
+
+	pkts[0] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + 2 * MSS, ACK,
+				2 * MSS, MSS, 0);
+
+	n = net_gro_receive(pkts, ARRAY_SIZE(pkts));
+	zassert_equal(n, 2, "%zu packets after coalescing", n);
+	gro_check_pkt(pkts[0], AF_INET, PEER_PORT, 0, MSS, ACK);
+	gro_check_pkt(pkts[1], AF_INET, PEER_PORT, 2 * MSS, MSS, ACK);
+
+	pkts_unref(pkts, n);
+}
+
+/**
+ * @brief Test that only segments of the same flow are coalesced
+ */
+static void test_gro_flows(void)
+{
+	struct net_pkt *pkts[4];
+	size_t n;
+
+	/** TESTPOINT: interleaved flows are not merged across */
+	pkts[0] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(AF_INET, PEER_PORT + 1, SEQ + MSS, ACK,
+				MSS, MSS, 0);
+	pkts[2] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + MSS, ACK,
+				MSS, MSS, 0);
+
+	n = net_gro_receive(pkts, 3);
+	zassert_equal(n, 3, "%zu packets after coalescing", n);
+	gro_check_pkt(pkts[0], AF_INET, PEER_PORT, 0, MSS, ACK);
+	gro_check_pkt(pkts[1], AF_INET, PEER_PORT + 1, MSS, MSS, ACK);
+	gro_check_pkt(pkts[2], AF_INET, PEER_PORT, MSS, MSS, ACK);
+	pkts_unref(pkts, n);
+
+	/** TESTPOINT: runs of each flow are merged on their own */
+	pkts[0] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + MSS, ACK,
+				MSS, MSS, 0);
+	pkts[2] = tcp_pkt_build(AF_INET, PEER_PORT + 1, SEQ, ACK, 0, MSS, 0);
+	pkts[3] = tcp_pkt_build(AF_INET, PEER_PORT + 1, SEQ + MSS, ACK,
+				MSS, MSS, 0);
+
+	n = net_gro_receive(pkts, 4);
+	zassert_equal(n, 2, "%zu packets after coalescing", n);
+	gro_check_pkt(pkts[0], AF_INET, PEER_PORT, 0, 2 * MSS, ACK);
+	gro_check_pkt(pkts[1], AF_INET, PEER_PORT + 1, 0, 2 * MSS, ACK);
+	pkts_unref(pkts, n);
+}
+
+/**
+ * @brief Test that control and corrupted segments are left alone
+ */
+static void test_gro_skip(void)
+{
+	struct net_pkt *pkts[3];
+	uint8_t byte;
+	size_t n;
+
+	/** TESTPOINT: a segment ending the stream is not merged */
+	pkts[0] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + MSS, ACK | FIN,
+				MSS, MSS, 0);
+
+	n = net_gro_receive(pkts, 2);
+	zassert_equal(n, 2, "%zu packets after coalescing", n);
+	gro_check_pkt(pkts[1], AF_INET, PEER_PORT, MSS, MSS, ACK | FIN);
+	pkts_unref(pkts, n);
+
+	/** TESTPOINT: a segment with a bad checksum is left to TCP */
+	pkts[0] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ, ACK, 0, MSS, 0);
+	pkts[1] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + MSS, ACK,
+				MSS, MSS, 0);
+	pkts[2] = tcp_pkt_build(AF_INET, PEER_PORT, SEQ + 2 * MSS, ACK,
+				2 * MSS, MSS, 0);
+
+	net_pkt_set_overwrite(pkts[1], true);
+	net_pkt_skip(pkts[1], net_pkt_get_len(pkts[1]) - 1);
+	net_pkt_read_u8(pkts[1], &byte);
+	net_pkt_cursor_init(pkts[1]);
+	net_pkt_skip(pkts[1], net_pkt_get_len(pkts[1]) - 1);
+	net_pkt_write_u8(pkts[1], byte ^ 0xff);
+	net_pkt_cursor_init(pkts[1]);
+
+	n = net_gro_receive(pkts, 3);
+	zassert_equal(n, 3, "%zu packets after coalescing", n);
+	zassert_true(net_pkt_is_chksum_ok(pkts[0]), NULL);
+	zassert_false(net_pkt_is_chksum_ok(pkts[1]), NULL);
+	zassert_not_equal(net_calc_chksum_tcp(pkts[1]), 0U, NULL);
+	pkts_unref(pkts, n);
+}
+
+void test_main(void)
+{
+	for (int i = 0; i < sizeof(payload); i++) {
+		payload[i] = i % 251;
+	}
+
+	zassert_not_null(test_iface, "no test interface");
+	net_if_ipv4_addr_add(test_iface, &my_addr4, NET_ADDR_MANUAL, 0);
+	net_if_ipv6_addr_add(test_iface, &my_addr6, NET_ADDR_MANUAL, 0);
+
+	ztest_test_suite(net_gso_gro,
+			 ztest_unit_test(test_gso_ipv4),
+			 ztest_unit_test(test_gso_ipv6),
+			 ztest_unit_test(test_gro_merge),
+			 ztest_unit_test(test_gro_hole),
+			 ztest_unit_test(test_gro_flows),
+			 ztest_unit_test(test_gro_skip));
+	ztest_run_test_suite(net_gso_gro);
+}
@@ -125,6 +125,7 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_lossy_loopback(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -420,6 +421,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_lossy_loopback(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1337,6 +1341,7 @@ static void test_client_invalid_rst(void)
 #define MAX_DATA 100
 static uint32_t expected_ack = MAX_DATA + 1 - 15;
 static struct net_context *ooo_ctx;
+static uint32_t ooo_last_ack;
 
 static void handle_server_recv_out_of_order(struct net_pkt *pkt)
 {
@@ -1348,6 +1353,15 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt)
 		goto fail;
 	}
 
+	/* Out-of-order data is acked right away with the ack of the data
+	 * received so far, skip these duplicate acks.
+	 */
+	if (ntohl(th.th_ack) == ooo_last_ack) {
+		return;
+	}
+
+	ooo_last_ack = ntohl(th.th_ack);
+
 	/* Verify that we received all the queued data */
 	zassert_equal(expected_ack, ntohl(th.th_ack),
 		      "Not all pending data received. "
@@ -1378,6 +1392,7 @@ static void test_server_recv_out_of_order_data(void)
 	 * testing purposes)
 	 */
 	ooo_ctx = create_server_socket(-15U, -15U);
+	ooo_last_ack = seq;
 
 	/* This will force the packet to be routed to our checker func
 	 * handle_server_recv_out_of_order()
@@ -1484,6 +1499,368 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+/* Lossy loopback: the packets of a connection between two of our own
+ * endpoints come back to us with their source and destination addresses
+ * swapped, and some of the new data segments of the client are dropped
+ * on the way. The client writes the data in bursts so that several
+ * segments are in flight when one is lost.
+ */
+#define LOSSY_CLIENT_PORT 4243
+#define LOSSY_SERVER_PORT 4244
+#define LOSSY_WRITE_LEN 100
+#define LOSSY_BURST_LEN 12
+#define LOSSY_BURSTS 20
+#define LOSSY_PERIOD 24 /* drop pattern length, in new data segments */
+#define LOSSY_TIMEOUT_MS 5000
+#define LOSSY_PENDING 8 /* max dropped segments not yet resent */
+
+static const uint8_t *lossy_drops; /* segments to drop in a period */
+static size_t lossy_drops_count;
+static uint32_t lossy_segs;
+static uint32_t lossy_dropped;
+static size_t lossy_dropped_len;
+static uint32_t lossy_resent;
+static size_t lossy_resent_len;
+static uint32_t lossy_sacks;
+static uint32_t lossy_max_delay; /* longest time from a drop to its resend */
+static struct {
+	uint32_t seq;
+	uint32_t time;
+	bool used;
+} lossy_pending[LOSSY_PENDING];
+static uint32_t lossy_first_seq;
+static uint32_t lossy_next_seq;
+static size_t lossy_received;
+static size_t lossy_expected;
+static K_SEM_DEFINE(lossy_sem, 0, 1);
+static bool lossy_corrupted;
+static struct net_context *lossy_server_ctx;
+
+static void lossy_pending_add(uint32_t seq)
+{
+	for (int i = 0; i < LOSSY_PENDING; i++) {
+		if (!lossy_pending[i].used) {
+			lossy_pending[i].seq = seq;
+			lossy_pending[i].time = k_uptime_get_32();
+			lossy_pending[i].used = true;
+			return;
+		}
+	}
+
+	zassert_true(false, "Too many dropped segments pending");
+}
+
+static void lossy_resend_check(uint32_t seq, size_t len)
+{
+	for (int i = 0; i < LOSSY_PENDING; i++) {
+		uint32_t delay;
+
+		if (!lossy_pending[i].used ||
+		    net_tcp_seq_cmp(lossy_pending[i].seq, seq) < 0 ||
+		    net_tcp_seq_cmp(lossy_pending[i].seq, seq + len) >= 0) {
+			continue;
+		}
+
+		delay = k_uptime_get_32() - lossy_pending[i].time;
+		lossy_max_delay = MAX(lossy_max_delay, delay);
+		lossy_pending[i].used = false;
+	}
+}
+
+static bool lossy_drop(struct tcphdr *th, size_t len)
+{
+	uint32_t seq = ntohl(th->th_seq);
+	bool drop = false;
+
+	if (!len || ntohs(th->th_sport) != LOSSY_CLIENT_PORT) {
+		return false;
+	}
+
+	/* Never drop a retransmission, even one carrying new data too */
+	if (lossy_segs && net_tcp_seq_cmp(seq, lossy_next_seq) < 0) {
+		lossy_resent++;
+		lossy_resent_len += MIN(len, lossy_next_seq - seq);
+		lossy_resend_check(seq, len);
+
+		if (net_tcp_seq_cmp(seq + len, lossy_next_seq) > 0) {
+			lossy_next_seq = seq + len;
+		}
+
+		return false;
+	}
+
+	if (!lossy_segs) {
+		lossy_first_seq = seq;
+	}
+
+	for (int i = 0; i < lossy_drops_count; i++) {
+		if (lossy_segs % LOSSY_PERIOD == lossy_drops[i]) {
+			drop = true;
+		}
+	}
+
+	/* Nothing would follow the last segment of a burst to tell about
+	 * its loss, only the retransmission timer would recover it.
+	 */
+	if (seq + len - lossy_first_seq >= lossy_expected) {
+		drop = false;
+	}
+
+	lossy_segs++;
+	lossy_next_seq = seq + len;
+
+	if (drop) {
+		lossy_dropped++;
+		lossy_dropped_len += len;
+		lossy_pending_add(seq);
+	}
+
+	return drop;
+}
+
+static void handle_lossy_loopback(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		th_off(th) * 4;
+	struct net_pkt *clone;
+	int ret;
+
+	/* Only SYN segments have other options than SACK */
+	if (th_off(th) > 5 && !(th_flags(th) & SYN)) {
+		lossy_sacks++;
+	}
+
+	if (lossy_drop(th, net_pkt_get_len(pkt) - hdr_len)) {
+		return;
+	}
+
+	clone = net_pkt_clone(pkt, K_NO_WAIT);
+	zassert_not_null(clone, "Cannot clone pkt");
+
+	if (net_pkt_family(clone) == AF_INET) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(clone);
+		struct in_addr addr;
+
+		net_ipaddr_copy(&addr, &hdr->src);
+		net_ipaddr_copy(&hdr->src, &hdr->dst);
+		net_ipaddr_copy(&hdr->dst, &addr);
+	} else {
+		struct net_ipv6_hdr *hdr = NET_IPV6_HDR(clone);
+		struct in6_addr addr;
+
+		net_ipaddr_copy(&addr, &hdr->src);
+		net_ipaddr_copy(&hdr->src, &hdr->dst);
+		net_ipaddr_copy(&hdr->dst, &addr);
+	}
+
+	ret = net_recv_data(iface, clone);
+	if (ret < 0) {
+		net_pkt_unref(clone);
+		zassert_true(false, "recv data failed (%d)", ret);
+	}
+}
+
+static void lossy_recv_cb(struct net_context *context,
+			  struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  union net_proto_header *proto_hdr,
+			  int status,
+			  void *user_data)
+{
+	uint8_t buf[LOSSY_WRITE_LEN];
+	size_t len;
+
+	if (!pkt) {
+		return;
+	}
+
+	while ((len = MIN(net_pkt_remaining_data(pkt), sizeof(buf))) > 0) {
+		net_pkt_read(pkt, buf, len);
+
+		for (int i = 0; i < len; i++, lossy_received++) {
+			if (buf[i] != lorem_ipsum[lossy_received %
+						  (sizeof(lorem_ipsum) - 1)]) {
+				lossy_corrupted = true;
+			}
+		}
+	}
+
+	if (lossy_received >= lossy_expected) {
+		k_sem_give(&lossy_sem);
+	}
+
+	net_pkt_unref(pkt);
+}
+
+static void lossy_accept_cb(struct net_context *ctx,
+			    struct sockaddr *addr,
+			    socklen_t addrlen,
+			    int status,
+			    void *user_data)
+{
+	zassert_equal(status, 0, "failed to accept the conn");
+
+	ctx->recv_cb = lossy_recv_cb;
+	lossy_server_ctx = ctx;
+
+	test_sem_give();
+}
+
+static void lossy_write(struct net_context *ctx, size_t pos)
+{
+	uint8_t buf[LOSSY_WRITE_LEN];
+	uint32_t start = k_uptime_get_32();
+	int ret;
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = lorem_ipsum[(pos + i) % (sizeof(lorem_ipsum) - 1)];
+	}
+
+	/* Wait for acks if the window is full */
+	while ((ret = net_context_send(ctx, buf, sizeof(buf), NULL, K_NO_WAIT,
+				       NULL)) == -EAGAIN || ret == -ENOBUFS) {
+		zassert_true(k_uptime_get_32() - start < LOSSY_TIMEOUT_MS,
+			     "Cannot send data");
+
+		k_sched_unlock();
+		k_msleep(1);
+		k_sched_lock();
+	}
+
+	zassert_equal(ret, sizeof(buf), "Send failed (%d)", ret);
+}
+
+static void lossy_transfer(sa_family_t af, const uint8_t *drops,
+			   size_t drops_count)
+{
+	struct net_context *listener, *ctx;
+	struct sockaddr_in6 client_addr, server_addr, peer;
+	socklen_t addrlen;
+	size_t sent = 0;
+	uint32_t start, elapsed;
+	int ret;
+
+	if (af == AF_INET) {
+		addrlen = sizeof(struct sockaddr_in);
+		memcpy(&client_addr, &my_addr_s, addrlen);
+		memcpy(&server_addr, &my_addr_s, addrlen);
+		memcpy(&peer, &peer_addr_s, addrlen);
+	} else {
+		addrlen = sizeof(struct sockaddr_in6);
+		memcpy(&client_addr, &my_addr_v6_s, addrlen);
+		memcpy(&server_addr, &my_addr_v6_s, addrlen);
+		memcpy(&peer, &peer_addr_v6_s, addrlen);
+	}
+
+	client_addr.sin6_port = htons(LOSSY_CLIENT_PORT);
+	server_addr.sin6_port = htons(LOSSY_SERVER_PORT);
+	peer.sin6_port = htons(LOSSY_SERVER_PORT);
+
+	test_case_no = 10;
+	lossy_drops = drops;
+	lossy_drops_count = drops_count;
+	lossy_segs = lossy_dropped = lossy_resent = lossy_sacks = 0;
+	lossy_dropped_len = lossy_resent_len = 0;
+	lossy_max_delay = 0;
+	memset(lossy_pending, 0, sizeof(lossy_pending));
+	lossy_received = 0;
+	lossy_expected = 0;
+	lossy_corrupted = false;
+	k_sem_reset(&lossy_sem);
+
+	ret = net_context_get(af, SOCK_STREAM, IPPROTO_TCP, &listener);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(listener, (struct sockaddr *)&server_addr,
+			       addrlen);
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(listener, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(listener, lossy_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	ret = net_context_get(af, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&client_addr, addrlen);
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer, addrlen,
+				  NULL, K_MSEC(1000), NULL);
+	zassert_equal(ret, 0, "Failed to connect (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	start = k_uptime_get_32();
+
+	for (int i = 0; i < LOSSY_BURSTS; i++) {
+		/* Write the whole burst before the acks get handled */
+		k_sched_lock();
+
+		lossy_expected = sent + LOSSY_BURST_LEN * LOSSY_WRITE_LEN;
+
+		for (int j = 0; j < LOSSY_BURST_LEN; j++) {
+			lossy_write(ctx, sent);
+			sent += LOSSY_WRITE_LEN;
+		}
+
+		k_sched_unlock();
+
+		ret = k_sem_take(&lossy_sem, K_MSEC(LOSSY_TIMEOUT_MS));
+		zassert_equal(ret, 0, "Data not received");
+	}
+
+	elapsed = k_uptime_get_32() - start;
+
+	TC_PRINT("%zu bytes in %u ms, %u of %u segments dropped, "
+		 "%u resent (max %u ms after the drop), %u SACKs\n", sent,
+		 elapsed, lossy_dropped, lossy_segs, lossy_resent,
+		 lossy_max_delay, lossy_sacks);
+
+	zassert_false(lossy_corrupted, "Received data does not match");
+	zassert_true(lossy_dropped > 0, "No segment dropped");
+	zassert_true(lossy_resent_len >= lossy_dropped_len,
+		     "Lost data not resent");
+
+	/* Fast retransmit recovered all the losses, none of them waited
+	 * for a retransmission timeout.
+	 */
+	zassert_true(lossy_max_delay <
+		     CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT,
+		     "Retransmission timeout while recovering (%u ms)",
+		     lossy_max_delay);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+		zassert_true(lossy_sacks > 0, "No SACK received");
+	}
+
+	net_context_put(ctx);
+	net_context_put(lossy_server_ctx);
+	net_context_put(listener);
+
+	/* Let the connections close */
+	k_msleep(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100);
+}
+
+/* One segment lost per burst */
+static void test_lossy_loopback_ipv4(void)
+{
+	static const uint8_t drops[] = { 2 };
+
+	lossy_transfer(AF_INET, drops, ARRAY_SIZE(drops));
+}
+
+/* Several segments lost in the same burst */
+static void test_lossy_loopback_ipv6(void)
+{
+	static const uint8_t drops[] = { 2, 5, 14 };
+
+	lossy_transfer(AF_INET6, drops, ARRAY_SIZE(drops));
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1499,7 +1876,9 @@ void test_main(void)
 			 ztest_unit_test(test_client_closing_ipv6),
 			 ztest_unit_test(test_client_invalid_rst),
 			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 ztest_unit_test(test_server_timeout_out_of_order_data),
+			 ztest_unit_test(test_lossy_loopback_ipv4),
+			 ztest_unit_test(test_lossy_loopback_ipv6)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
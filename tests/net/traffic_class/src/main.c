@@ -968,6 +968,186 @@ static void test_traffic_class_recv_data_mix_all_2(void)
 	zassert_false(test_failed, "Traffic class verification failed.");
 }
 
+static void test_traffic_class_recv_queue_stats(void)
+{
+#if defined(CONFIG_NET_STATISTICS)
+	struct net_tc_rx_queue_stats stats;
+	int queues[NET_TC_RX_COUNT] = { 0 };
+	uint32_t total = 0U;
+	int i, ret;
+
+	for (i = 0; i < net_tc_rx_queue_count(); i++) {
+		ret = net_tc_rx_queue_stats_get(i, &stats);
+		zassert_equal(ret, 0, "Cannot get RX queue %d stats", i);
+		zassert_true(stats.tc < NET_TC_RX_COUNT, "Invalid TC %d",
+			     stats.tc);
+		zassert_equal(stats.depth, 0U, "RX queue %d not empty", i);
+
+		if (stats.pkts > 0U) {
+			queues[stats.tc]++;
+			total += stats.pkts;
+		}
+	}
+
+	zassert_true(total > 0U, "No packet queued");
+
+	/* Each traffic class received a single flow, which must have been
+	 * kept on one queue.
+	 */
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		zassert_true(queues[i] <= 1, "TC %d flow spread over %d queues",
+			     i, queues[i]);
+	}
+#endif
+}
+
+#if defined(CONFIG_NET_STATISTICS) && CONFIG_NET_TC_RX_FLOW_QUEUES > 1
+#define FLOW_COUNT 6
+#define FLOW_PKTS 8
+#define FLOW_PORT 5000
+
+static struct net_context *flow_ctxs[FLOW_COUNT];
+static uint8_t flow_next_seq[FLOW_COUNT];
+static k_tid_t flow_thread[FLOW_COUNT];
+static bool flow_out_of_order;
+static bool flow_split;
+
+static void flow_recv_cb(struct net_context *context,
+			 struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 union net_proto_header *proto_hdr,
+			 int status,
+			 void *user_data)
+{
+	int flow = POINTER_TO_INT(user_data);
+	uint8_t seq;
+
+	if (net_pkt_read_u8(pkt, &seq) < 0 || seq != flow_next_seq[flow]) {
+		DBG("Flow %d got %d, expecting %d\n", flow, seq,
+		    flow_next_seq[flow]);
+		flow_out_of_order = true;
+	}
+
+	/* Each RX queue has its own thread */
+	if (flow_thread[flow] == NULL) {
+		flow_thread[flow] = k_current_get();
+	} else if (flow_thread[flow] != k_current_get()) {
+		flow_split = true;
+	}
+
+	flow_next_seq[flow]++;
+	k_sem_give(&wait_data);
+
+	net_pkt_unref(pkt);
+}
+#endif
+
+static void test_traffic_class_recv_flows(void)
+{
+#if defined(CONFIG_NET_STATISTICS) && CONFIG_NET_TC_RX_FLOW_QUEUES > 1
+	struct sockaddr_in6 src_addr6 = {
+		.sin6_family = AF_INET6,
+	};
+	struct net_tc_rx_queue_stats stats;
+	uint32_t pkts[NET_TC_RX_COUNT * CONFIG_NET_TC_RX_FLOW_QUEUES];
+	int used = 0;
+	int i, j, ret;
+
+	/* The test packets come back with their ports swapped, so each
+	 * flow is received on the context it was sent from, and all the
+	 * flows only differ in that context's port.
+	 */
+	memcpy(&src_addr6.sin6_addr, &my_addr1, sizeof(struct in6_addr));
+	memcpy(&dst_addr6.sin6_addr, &dst_addr, sizeof(struct in6_addr));
+
+	for (i = 0; i < FLOW_COUNT; i++) {
+		ret = net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP,
+				      &flow_ctxs[i]);
+		zassert_equal(ret, 0, "Cannot get flow %d context (%d)",
+			      i, ret);
+
+		src_addr6.sin6_port = htons(FLOW_PORT + i);
+		ret = net_context_bind(flow_ctxs[i],
+				       (struct sockaddr *)&src_addr6,
+				       sizeof(struct sockaddr_in6));
+		zassert_equal(ret, 0, "Cannot bind flow %d context (%d)",
+			      i, ret);
+
+		ret = net_context_recv(flow_ctxs[i], flow_recv_cb, K_NO_WAIT,
+				       INT_TO_POINTER(i));
+		zassert_equal(ret, 0, "Cannot receive on flow %d (%d)",
+			      i, ret);
+	}
+
+	zassert_equal(net_tc_rx_queue_count(), ARRAY_SIZE(pkts),
+		      "Unexpected RX queue count");
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		ret = net_tc_rx_queue_stats_get(i, &stats);
+		zassert_equal(ret, 0, "Cannot get RX queue %d stats", i);
+		pkts[i] = stats.pkts;
+	}
+
+	(void)memset(flow_next_seq, 0, sizeof(flow_next_seq));
+	(void)memset(flow_thread, 0, sizeof(flow_thread));
+	flow_out_of_order = false;
+	flow_split = false;
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	test_started = true;
+	start_receiving = true;
+
+	/* Interleave the flows, so that packets of one flow are queued
+	 * behind packets of the others.
+	 */
+	for (j = 0; j < FLOW_PKTS; j++) {
+		for (i = 0; i < FLOW_COUNT; i++) {
+			uint8_t seq = j;
+
+			ret = net_context_sendto(flow_ctxs[i], &seq,
+						 sizeof(seq),
+						 (struct sockaddr *)&dst_addr6,
+						 sizeof(struct sockaddr_in6),
+						 NULL, K_NO_WAIT, NULL);
+			zassert_true(ret > 0, "Send UDP pkt failed");
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+
+	for (i = 0; i < FLOW_COUNT * FLOW_PKTS; i++) {
+		zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			      "Timeout, %d packets of %d received", i,
+			      FLOW_COUNT * FLOW_PKTS);
+	}
+
+	zassert_false(flow_out_of_order, "Flow received out of order");
+	zassert_false(flow_split, "Flow received from several RX queues");
+
+	for (i = 0; i < FLOW_COUNT; i++) {
+		zassert_equal(flow_next_seq[i], FLOW_PKTS,
+			      "Flow %d received %d packets", i,
+			      flow_next_seq[i]);
+		net_context_unref(flow_ctxs[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		ret = net_tc_rx_queue_stats_get(i, &stats);
+		zassert_equal(ret, 0, "Cannot get RX queue %d stats", i);
+		zassert_equal(stats.depth, 0U, "RX queue %d not empty", i);
+
+		if (stats.pkts != pkts[i]) {
+			used++;
+		}
+	}
+
+	zassert_true(used > 1, "%d flows all queued on one RX queue",
+		     FLOW_COUNT);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_traffic_class_test,
@@ -1006,7 +1186,9 @@ void test_main(void)
 			 ztest_unit_test(test_traffic_class_recv_data_mix),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_1),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_2),
-			 ztest_unit_test(test_traffic_class_cleanup_rx)
+			 ztest_unit_test(test_traffic_class_recv_queue_stats),
+			 ztest_unit_test(test_traffic_class_cleanup_rx),
+			 ztest_unit_test(test_traffic_class_recv_flows)
 			 );
 
 	ztest_run_test_suite(net_traffic_class_test);